@@ -0,0 +1,119 @@
+/*
+    AtCore Command Line Client
+
+    Copyright (C) 2026 The AtCore contributors
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <algorithm>
+
+#include "linkstats.h"
+
+double LinkStats::Figures::linesPerSecond() const
+{
+    return msecs > 0 ? lines * 1000.0 / msecs : 0;
+}
+
+double LinkStats::Figures::bytesPerSecond() const
+{
+    return msecs > 0 ? bytes * 1000.0 / msecs : 0;
+}
+
+LinkStats::LinkStats()
+{
+    start();
+}
+
+void LinkStats::start()
+{
+    _clock.start();
+    _windowStart = 0;
+    _sent.clear();
+    _latencies.clear();
+    _windowLatencies.clear();
+    _bytes = 0;
+    _windowBytes = 0;
+}
+
+void LinkStats::commandSent(qint64 bytes)
+{
+    _sent.push_back(_clock.nsecsElapsed() / 1000);
+    bytesSent(bytes);
+}
+
+void LinkStats::bytesSent(qint64 bytes)
+{
+    _bytes += bytes;
+    _windowBytes += bytes;
+}
+
+void LinkStats::commandAcknowledged()
+{
+    if (_sent.empty()) {
+        //Acknowledge of a command written before start().
+        return;
+    }
+    const qint64 latency = _clock.nsecsElapsed() / 1000 - _sent.front();
+    _sent.pop_front();
+    _latencies.push_back(latency);
+    _windowLatencies.push_back(latency);
+}
+
+int LinkStats::inFlight() const
+{
+    return int(_sent.size());
+}
+
+LinkStats::Figures LinkStats::window()
+{
+    const qint64 now = _clock.elapsed();
+    Figures figures;
+    figures.lines = qint64(_windowLatencies.size());
+    figures.bytes = _windowBytes;
+    figures.msecs = now - _windowStart;
+    percentiles(_windowLatencies, figures);
+    _windowStart = now;
+    _windowLatencies.clear();
+    _windowBytes = 0;
+    return figures;
+}
+
+LinkStats::Figures LinkStats::total() const
+{
+    Figures figures;
+    figures.lines = qint64(_latencies.size());
+    figures.bytes = _bytes;
+    figures.msecs = _clock.elapsed();
+    percentiles(_latencies, figures);
+    return figures;
+}
+
+void LinkStats::percentiles(std::vector<qint64> samples, Figures &figures)
+{
+    if (samples.empty()) {
+        return;
+    }
+    //Nearest rank, each nth_element only orders what is left of the previous one.
+    auto rank = [&samples](double percent, std::vector<qint64>::iterator from) {
+        auto nth = samples.begin() + std::ptrdiff_t((samples.size() - 1) * percent / 100.0);
+        std::nth_element(from, nth, samples.end());
+        return nth;
+    };
+    auto p50 = rank(50, samples.begin());
+    figures.p50 = *p50 / 1000.0;
+    auto p95 = rank(95, p50);
+    figures.p95 = *p95 / 1000.0;
+    figures.p99 = *rank(99, p95) / 1000.0;
+    figures.max = *std::max_element(p95, samples.end()) / 1000.0;
+}
@@ -0,0 +1,113 @@
+/*
+    AtCore Command Line Client
+
+    Copyright (C) 2026 The AtCore contributors
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <QElapsedTimer>
+#include <QtGlobal>
+
+#include <deque>
+#include <vector>
+
+/**
+ * @brief The LinkStats class
+ * Throughput and acknowledge latency of a printer link
+ *
+ * Commands are acknowledged in the order they were sent, every acknowledge
+ * closes the oldest command in flight. Figures are kept for the whole run
+ * and for the window since the last call to window().
+ */
+class LinkStats
+{
+public:
+    /**
+     * @brief Figures of a period
+     */
+    struct Figures {
+        qint64 lines = 0;   //!< @param lines: commands acknowledged
+        qint64 bytes = 0;   //!< @param bytes: bytes written
+        qint64 msecs = 0;   //!< @param msecs: length of the period
+        double p50 = -1;    //!< @param p50: median acknowledge latency in ms, -1 without acknowledge
+        double p95 = -1;    //!< @param p95: 95th percentile of the latency in ms
+        double p99 = -1;    //!< @param p99: 99th percentile of the latency in ms
+        double max = -1;    //!< @param max: longest latency in ms
+
+        /**
+         * @brief Acknowledged commands per second
+         */
+        double linesPerSecond() const;
+
+        /**
+         * @brief Bytes written per second
+         */
+        double bytesPerSecond() const;
+    };
+
+    LinkStats();
+
+    /**
+     * @brief Start measuring, forget everything measured before
+     */
+    void start();
+
+    /**
+     * @brief A command waiting for an acknowledge was written
+     * @param bytes: size written, terminator included
+     */
+    void commandSent(qint64 bytes);
+
+    /**
+     * @brief Bytes written out of band, never acknowledged
+     */
+    void bytesSent(qint64 bytes);
+
+    /**
+     * @brief The firmware acknowledged the oldest command in flight
+     */
+    void commandAcknowledged();
+
+    /**
+     * @brief Commands written and not acknowledged yet
+     */
+    int inFlight() const;
+
+    /**
+     * @brief Figures since the last call, starts a new window
+     */
+    Figures window();
+
+    /**
+     * @brief Figures since start()
+     */
+    Figures total() const;
+
+    /**
+     * @brief Fill the latencies of \p figures from \p samples, in microseconds
+     * Nearest rank percentiles, \p figures is left untouched without samples.
+     */
+    static void percentiles(std::vector<qint64> samples, Figures &figures);
+
+private:
+    QElapsedTimer _clock;
+    qint64 _windowStart = 0;
+    std::deque<qint64> _sent;
+    std::vector<qint64> _latencies;
+    std::vector<qint64> _windowLatencies;
+    qint64 _bytes = 0;
+    qint64 _windowBytes = 0;
+};
@@ -0,0 +1,63 @@
+/*
+    AtCore Command Line Client
+
+    Copyright (C) 2026 The AtCore contributors
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <QCommandLineParser>
+#include <QCoreApplication>
+
+#include "streamclient.h"
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setOrganizationName(QStringLiteral("KDE"));
+    QCoreApplication::setOrganizationDomain(QStringLiteral("kde.org"));
+    QCoreApplication::setApplicationName(QStringLiteral("atcore-cli"));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Stream gcode to a printer and measure the link."));
+    parser.addHelpOption();
+    const QCommandLineOption portOption({QStringLiteral("p"), QStringLiteral("port")}, QStringLiteral("Serial port of the printer."), QStringLiteral("port"));
+    const QCommandLineOption baudOption({QStringLiteral("b"), QStringLiteral("baud")}, QStringLiteral("Baud rate, default 115200."), QStringLiteral("baud"), QStringLiteral("115200"));
+    const QCommandLineOption firmwareOption({QStringLiteral("f"), QStringLiteral("firmware")}, QStringLiteral("Firmware plugin to load, detected when not given."), QStringLiteral("plugin"));
+    const QCommandLineOption commandOption({QStringLiteral("c"), QStringLiteral("command")}, QStringLiteral("Command sent before the job and its reply printed, may be repeated."), QStringLiteral("gcode"));
+    const QCommandLineOption intervalOption({QStringLiteral("i"), QStringLiteral("interval")}, QStringLiteral("Msecs between live figures, 0 for none, default 1000."), QStringLiteral("msecs"), QStringLiteral("1000"));
+    const QCommandLineOption timeoutOption({QStringLiteral("t"), QStringLiteral("timeout")}, QStringLiteral("Msecs allowed to detect the firmware, default 10000."), QStringLiteral("msecs"), QStringLiteral("10000"));
+    const QCommandLineOption summaryOption({QStringLiteral("s"), QStringLiteral("summary")}, QStringLiteral("Write the JSON summary to file instead of stdout."), QStringLiteral("file"));
+    parser.addOptions({portOption, baudOption, firmwareOption, commandOption, intervalOption, timeoutOption, summaryOption});
+    parser.addPositionalArgument(QStringLiteral("file"), QStringLiteral("Gcode file to stream."), QStringLiteral("[file]"));
+    parser.process(app);
+
+    StreamOptions options;
+    options.port = parser.value(portOption);
+    options.baud = parser.value(baudOption).toInt();
+    options.firmware = parser.value(firmwareOption).toLower();
+    options.commands = parser.values(commandOption);
+    options.file = parser.positionalArguments().value(0);
+    options.statsInterval = qMax(0, parser.value(intervalOption).toInt());
+    options.timeout = qMax(0, parser.value(timeoutOption).toInt());
+    options.summaryFile = parser.value(summaryOption);
+    if (options.port.isEmpty() || options.baud <= 0) {
+        parser.showHelp(1);
+    }
+
+    StreamClient client(options);
+    if (!client.start()) {
+        return 1;
+    }
+    return app.exec();
+}
@@ -0,0 +1,242 @@
+/*
+    AtCore Command Line Client
+
+    Copyright (C) 2026 The AtCore contributors
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <QCoreApplication>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTextStream>
+
+#include <cstdio>
+
+#include "ifirmware.h"
+#include "seriallayer.h"
+#include "streamclient.h"
+
+namespace
+{
+//msecs to wait for the firmware to announce itself before asking for M115
+const int _requestDelay = 2000;
+}
+
+StreamClient::StreamClient(const StreamOptions &options, QObject *parent)
+    : QObject(parent)
+    , _options(options)
+    , _core(new AtCore(this))
+    , _statsTimer(new QTimer(this))
+    , _timeoutTimer(new QTimer(this))
+{
+    _statsTimer->setInterval(_options.statsInterval);
+    _timeoutTimer->setSingleShot(true);
+    _timeoutTimer->setInterval(_options.timeout);
+    connect(_statsTimer, &QTimer::timeout, this, &StreamClient::showStats);
+    connect(_timeoutTimer, &QTimer::timeout, this, &StreamClient::connectTimeout);
+    connect(_core, &AtCore::stateChanged, this, &StreamClient::checkState);
+    connect(_core, &AtCore::printProgressChanged, this, &StreamClient::updateProgress);
+}
+
+bool StreamClient::start()
+{
+    if (!_options.file.isEmpty() && !QFile::exists(_options.file)) {
+        qCritical("%s does not exist.", qPrintable(_options.file));
+        return false;
+    }
+    if (!_core->initSerial(_options.port, _options.baud)) {
+        qCritical("Unable to open %s.", qPrintable(_options.port));
+        return false;
+    }
+    connect(_core->serial(), &SerialLayer::pushedUrgentCommand, this, &StreamClient::markUrgent);
+    connect(_core->serial(), &SerialLayer::pushedCommand, this, &StreamClient::countWritten);
+    _timeoutTimer->start();
+    if (_options.firmware.isEmpty()) {
+        //Detected from what the firmware prints when the port opens, else from its M115 reply.
+        QTimer::singleShot(_requestDelay, this, &StreamClient::requestFirmware);
+        return true;
+    }
+    _core->loadFirmwarePlugin(_options.firmware);
+    if (!_core->firmwarePluginLoaded()) {
+        qCritical("No plugin for %s, available: %s.", qPrintable(_options.firmware),
+                  qPrintable(_core->availableFirmwarePlugins().join(QStringLiteral(", "))));
+        return false;
+    }
+    return true;
+}
+
+void StreamClient::requestFirmware()
+{
+    if (_core->state() == AtCore::CONNECTING) {
+        _core->serial()->pushCommand(QByteArrayLiteral("M115"));
+    }
+}
+
+void StreamClient::connectTimeout()
+{
+    qCritical("No firmware detected on %s.", qPrintable(_options.port));
+    finish(QStringLiteral("timeout"));
+}
+
+void StreamClient::checkState(AtCore::STATES state)
+{
+    switch (state) {
+    case AtCore::IDLE:
+        if (!_ready) {
+            _ready = true;
+            _timeoutTimer->stop();
+            connect(_core->firmwarePlugin(), &IFirmware::readyForCommand, this, [this] {
+                _stats.commandAcknowledged();
+            });
+            _stats.start();
+            if (_options.statsInterval > 0) {
+                _statsTimer->start();
+            }
+            sendNext();
+        }
+        break;
+    case AtCore::FINISHEDPRINT:
+        if (_printing) {
+            finish(QStringLiteral("finished"));
+        }
+        break;
+    case AtCore::ERRORSTATE:
+        finish(QStringLiteral("error"));
+        break;
+    case AtCore::DISCONNECTED:
+        if (_ready) {
+            finish(QStringLiteral("disconnected"));
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+void StreamClient::countWritten(const QByteArray &bytes)
+{
+    //Urgent writes (realtime commands, status query, feed hold) bypass the queue and get no acknowledge.
+    const bool acknowledged = !_urgent;
+    _urgent = false;
+    if (!_ready || !_core->firmwarePluginLoaded()) {
+        return;
+    }
+    if (acknowledged) {
+        _stats.commandSent(bytes.size());
+    } else {
+        _stats.bytesSent(bytes.size());
+    }
+}
+
+void StreamClient::markUrgent()
+{
+    _urgent = true;
+}
+
+void StreamClient::sendNext()
+{
+    if (_nextCommand < _options.commands.size()) {
+        const QString command = _options.commands.at(_nextCommand++);
+        _core->pushCommand(command, [this, command](const QStringList & reply, bool aborted) {
+            if (aborted) {
+                finish(QStringLiteral("aborted"));
+                return;
+            }
+            QTextStream out(stdout);
+            out << "> " << command << '\n';
+            for (const QString &line : reply) {
+                out << line << '\n';
+            }
+            out.flush();
+            sendNext();
+        });
+        return;
+    }
+    if (_options.file.isEmpty()) {
+        finish(QStringLiteral("finished"));
+        return;
+    }
+    _printing = true;
+    _core->print(_options.file);
+}
+
+void StreamClient::updateProgress(float progress)
+{
+    _progress = progress;
+}
+
+void StreamClient::showStats()
+{
+    const LinkStats::Figures figures = _stats.window();
+    QString line = QStringLiteral("\r%1 lines/s %2 B/s | ack p50 %3 p95 %4 p99 %5 ms | queue %6 in flight %7")
+                   .arg(figures.linesPerSecond(), 0, 'f', 1)
+                   .arg(figures.bytesPerSecond(), 0, 'f', 0)
+                   .arg(figures.p50, 0, 'f', 1)
+                   .arg(figures.p95, 0, 'f', 1)
+                   .arg(figures.p99, 0, 'f', 1)
+                   .arg(_core->commandQueueSize())
+                   .arg(_stats.inFlight());
+    if (_printing && _progress >= 0) {
+        line.append(QStringLiteral(" | %1%").arg(double(_progress), 0, 'f', 1));
+    }
+    //Pad over the end of a longer previous line.
+    std::fprintf(stderr, "%-100s", qPrintable(line));
+    std::fflush(stderr);
+}
+
+void StreamClient::finish(const QString &result)
+{
+    if (_done) {
+        return;
+    }
+    _done = true;
+    _statsTimer->stop();
+    _timeoutTimer->stop();
+    if (_options.statsInterval > 0 && _ready) {
+        std::fprintf(stderr, "\n");
+    }
+
+    const LinkStats::Figures figures = _stats.total();
+    QJsonObject latency;
+    latency.insert(QStringLiteral("p50"), figures.p50);
+    latency.insert(QStringLiteral("p95"), figures.p95);
+    latency.insert(QStringLiteral("p99"), figures.p99);
+    latency.insert(QStringLiteral("max"), figures.max);
+    QJsonObject summary;
+    summary.insert(QStringLiteral("result"), result);
+    summary.insert(QStringLiteral("port"), _options.port);
+    summary.insert(QStringLiteral("baud"), _options.baud);
+    summary.insert(QStringLiteral("firmware"), _core->firmwarePluginLoaded() ? _core->firmwarePlugin()->name() : QString());
+    summary.insert(QStringLiteral("file"), _options.file);
+    summary.insert(QStringLiteral("commands"), figures.lines);
+    summary.insert(QStringLiteral("bytes"), figures.bytes);
+    summary.insert(QStringLiteral("seconds"), figures.msecs / 1000.0);
+    summary.insert(QStringLiteral("linesPerSecond"), figures.linesPerSecond());
+    summary.insert(QStringLiteral("bytesPerSecond"), figures.bytesPerSecond());
+    summary.insert(QStringLiteral("ackLatencyMs"), latency);
+    const QByteArray json = QJsonDocument(summary).toJson();
+
+    if (_options.summaryFile.isEmpty()) {
+        std::fwrite(json.constData(), 1, std::size_t(json.size()), stdout);
+        std::fflush(stdout);
+    } else {
+        QFile file(_options.summaryFile);
+        if (!file.open(QFile::WriteOnly | QFile::Truncate) || file.write(json) != json.size()) {
+            qCritical("Unable to write %s.", qPrintable(_options.summaryFile));
+        }
+    }
+    _core->closeConnection();
+    QCoreApplication::exit(result == QStringLiteral("finished") ? 0 : 1);
+}
@@ -0,0 +1,121 @@
+/*
+    AtCore Command Line Client
+
+    Copyright (C) 2026 The AtCore contributors
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <QObject>
+#include <QStringList>
+#include <QTimer>
+
+#include "atcore.h"
+#include "linkstats.h"
+
+/**
+ * @brief What StreamClient is asked to do
+ */
+struct StreamOptions {
+    QString port;               //!< @param port: serial port
+    int baud = 115200;          //!< @param baud: baud rate
+    QString firmware;           //!< @param firmware: plugin to load, empty to detect it
+    QStringList commands;       //!< @param commands: commands sent before the job, in order
+    QString file;               //!< @param file: job to stream, may be empty
+    int statsInterval = 1000;   //!< @param statsInterval: msecs between two live lines, 0 for none
+    int timeout = 10000;        //!< @param timeout: msecs allowed to connect and detect the firmware
+    QString summaryFile;        //!< @param summaryFile: where to write the JSON summary, empty for stdout
+};
+
+/**
+ * @brief The StreamClient class
+ * Headless client: connects, sends commands, streams a job and measures the link
+ *
+ * Live figures are written to stderr, replies to stdout and the JSON summary
+ * to stdout or StreamOptions::summaryFile. The application exits once done.
+ */
+class StreamClient : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit StreamClient(const StreamOptions &options, QObject *parent = nullptr);
+
+    /**
+     * @brief Connect to the printer, the rest follows from the event loop
+     * @return False if the port could not be opened or the plugin not loaded
+     */
+    bool start();
+
+private slots:
+    /**
+     * @brief Follow the printer through connection, commands and job
+     */
+    void checkState(AtCore::STATES state);
+
+    /**
+     * @brief Account for bytes written to the printer
+     */
+    void countWritten(const QByteArray &bytes);
+
+    /**
+     * @brief Mark the next write as out of band, it gets no acknowledge
+     */
+    void markUrgent();
+
+    /**
+     * @brief Ask the firmware its name when it did not announce itself
+     */
+    void requestFirmware();
+
+    /**
+     * @brief Give up connecting
+     */
+    void connectTimeout();
+
+    /**
+     * @brief Write the live line
+     */
+    void showStats();
+
+    /**
+     * @brief Keep the progress of the job for the live line
+     */
+    void updateProgress(float progress);
+
+private:
+    /**
+     * @brief Send the next command, stream the job after the last one
+     */
+    void sendNext();
+
+    /**
+     * @brief Write the summary and exit with \p result
+     * @param result: "finished" on success
+     */
+    void finish(const QString &result);
+
+    StreamOptions _options;
+    AtCore *_core;
+    LinkStats _stats;
+    QTimer *_statsTimer;
+    QTimer *_timeoutTimer;
+    int _nextCommand = 0;
+    bool _ready = false;
+    bool _urgent = false;
+    bool _printing = false;
+    bool _done = false;
+    float _progress = -1;
+};
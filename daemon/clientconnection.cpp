@@ -0,0 +1,143 @@
+/*
+    AtCore Daemon
+
+    Copyright (C) 2026 The AtCore contributors
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <QLocalSocket>
+#include <QTimer>
+
+#include "clientconnection.h"
+#include "printersession.h"
+
+using namespace DaemonProtocol;
+
+ClientConnection::ClientConnection(QLocalSocket *socket, QObject *parent)
+    : QObject(parent)
+    , _socket(socket)
+{
+    _socket->setParent(this);
+    connect(_socket, &QLocalSocket::readyRead, this, &ClientConnection::readRequests);
+    connect(_socket, &QLocalSocket::disconnected, this, [this] {
+        emit disconnected(this);
+    });
+}
+
+ClientConnection::~ClientConnection()
+{
+    qDeleteAll(_subscriptions);
+}
+
+void ClientConnection::send(const Message &message)
+{
+    if (_socket->state() == QLocalSocket::ConnectedState) {
+        _socket->write(encode(message));
+    }
+}
+
+void ClientConnection::reply(quint32 request, const QString &error, const QVariantMap &fields)
+{
+    Message message;
+    message.type = Reply;
+    message.request = request;
+    message.fields = fields;
+    message.fields.insert(QStringLiteral("ok"), error.isEmpty());
+    if (!error.isEmpty()) {
+        message.fields.insert(QStringLiteral("error"), error);
+    }
+    send(message);
+}
+
+void ClientConnection::readRequests()
+{
+    _buffer.append(_socket->readAll());
+    Message message;
+    int result;
+    while ((result = decode(_buffer, message)) > 0) {
+        emit requested(this, message);
+    }
+    if (result < 0) {
+        qWarning("Dropping client sending a corrupt frame.");
+        _buffer.clear();
+        _socket->disconnectFromServer();
+    }
+}
+
+void ClientConnection::subscribe(PrinterSession *printer, int topics, int interval)
+{
+    const QString name = printer->name();
+    unsubscribe(name);
+    Subscription *subscription = new Subscription;
+    subscription->topics = topics;
+    subscription->timer = new QTimer(this);
+    subscription->timer->setSingleShot(true);
+    subscription->timer->setInterval(interval);
+    connect(subscription->timer, &QTimer::timeout, this, [this, name] {
+        flush(name);
+    });
+    subscription->connection = connect(printer, &PrinterSession::updated, this, [this, name](int topic, const QString & key, const QVariant & value) {
+        update(name, topic, key, value);
+    });
+    _subscriptions.insert(name, subscription);
+
+    //Start from the current values, changes follow.
+    subscription->pending = printer->snapshot(topics);
+    flush(name);
+}
+
+void ClientConnection::unsubscribe(const QString &printer)
+{
+    Subscription *subscription = _subscriptions.take(printer);
+    if (!subscription) {
+        return;
+    }
+    disconnect(subscription->connection);
+    delete subscription->timer;
+    delete subscription;
+}
+
+void ClientConnection::update(const QString &printer, int topic, const QString &key, const QVariant &value)
+{
+    Subscription *subscription = _subscriptions.value(printer);
+    if (!subscription || !(subscription->topics & topic)) {
+        return;
+    }
+    if (topic == MessageTopic) {
+        subscription->messages.append(value);
+    } else {
+        subscription->pending.insert(key, value);
+    }
+    if (!subscription->timer->isActive()) {
+        subscription->timer->start();
+    }
+}
+
+void ClientConnection::flush(const QString &printer)
+{
+    Subscription *subscription = _subscriptions.value(printer);
+    if (!subscription || (subscription->pending.isEmpty() && subscription->messages.isEmpty())) {
+        return;
+    }
+    Message message;
+    message.type = Telemetry;
+    message.printer = printer;
+    message.fields = subscription->pending;
+    if (!subscription->messages.isEmpty()) {
+        message.fields.insert(QStringLiteral("messages"), subscription->messages);
+    }
+    subscription->pending.clear();
+    subscription->messages.clear();
+    send(message);
+}
@@ -0,0 +1,115 @@
+/*
+    AtCore Daemon
+
+    Copyright (C) 2026 The AtCore contributors
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <QHash>
+#include <QObject>
+
+#include "daemonprotocol.h"
+
+class QLocalSocket;
+class QTimer;
+class PrinterSession;
+
+/**
+ * @brief The ClientConnection class
+ * One client of the daemon, reads its requests and batches its telemetry
+ *
+ * Telemetry is not sent per change: the first change after a frame starts the
+ * interval of the subscription, later changes only update the pending values,
+ * so a client gets at most one frame per interval whatever the printer says.
+ */
+class ClientConnection : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Serve the client on \p socket, taken over
+     */
+    explicit ClientConnection(QLocalSocket *socket, QObject *parent = nullptr);
+    ~ClientConnection() override;
+
+    /**
+     * @brief Write \p message to the client
+     */
+    void send(const DaemonProtocol::Message &message);
+
+    /**
+     * @brief Answer request \p request
+     * @param error: reason of the failure, empty on success
+     * @param fields: more fields of the Reply
+     */
+    void reply(quint32 request, const QString &error, const QVariantMap &fields = QVariantMap());
+
+    /**
+     * @brief Send the telemetry of \p printer
+     * @param topics: DaemonProtocol::Topic wanted
+     * @param interval: least msecs between two frames
+     */
+    void subscribe(PrinterSession *printer, int topics, int interval);
+
+    /**
+     * @brief Stop the telemetry of \p printer
+     */
+    void unsubscribe(const QString &printer);
+
+signals:
+    /**
+     * @brief The client sent \p message
+     */
+    void requested(ClientConnection *client, const DaemonProtocol::Message &message);
+
+    /**
+     * @brief The client went away
+     */
+    void disconnected(ClientConnection *client);
+
+private slots:
+    /**
+     * @brief Read the frames received
+     */
+    void readRequests();
+
+private:
+    /**
+     * @brief Telemetry of one printer
+     */
+    struct Subscription {
+        int topics = 0;             //!< @param topics: DaemonProtocol::Topic wanted
+        QVariantMap pending;        //!< @param pending: latest values not sent yet
+        QVariantList messages;      //!< @param messages: lines received since the last frame
+        QTimer *timer = nullptr;    //!< @param timer: sends the pending values when it fires
+        QMetaObject::Connection connection; //!< @param connection: to PrinterSession::updated()
+    };
+
+    /**
+     * @brief Merge a change of \p printer into its pending frame
+     */
+    void update(const QString &printer, int topic, const QString &key, const QVariant &value);
+
+    /**
+     * @brief Send the pending frame of \p printer
+     */
+    void flush(const QString &printer);
+
+    QLocalSocket *_socket;
+    QByteArray _buffer;
+    QHash<QString, Subscription *> _subscriptions;
+};
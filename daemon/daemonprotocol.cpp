@@ -0,0 +1,58 @@
+/*
+    AtCore Daemon
+
+    Copyright (C) 2026 The AtCore contributors
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <QDataStream>
+#include <QtEndian>
+
+#include "daemonprotocol.h"
+
+namespace DaemonProtocol
+{
+
+QByteArray encode(const Message &message)
+{
+    QByteArray frame(sizeof(quint32), Qt::Uninitialized);
+    QDataStream stream(&frame, QIODevice::WriteOnly | QIODevice::Append);
+    stream.setVersion(QDataStream::Qt_5_4);
+    stream << message.type << message.request << message.printer << message.fields;
+    qToBigEndian<quint32>(quint32(frame.size() - int(sizeof(quint32))), reinterpret_cast<uchar *>(frame.data()));
+    return frame;
+}
+
+int decode(QByteArray &buffer, Message &message)
+{
+    if (buffer.size() < int(sizeof(quint32))) {
+        return 0;
+    }
+    const quint32 size = qFromBigEndian<quint32>(reinterpret_cast<const uchar *>(buffer.constData()));
+    if (size > MaxFrameSize) {
+        return -1;
+    }
+    if (quint32(buffer.size()) - sizeof(quint32) < size) {
+        return 0;
+    }
+    const QByteArray frame = QByteArray::fromRawData(buffer.constData() + sizeof(quint32), int(size));
+    QDataStream stream(frame);
+    stream.setVersion(QDataStream::Qt_5_4);
+    stream >> message.type >> message.request >> message.printer >> message.fields;
+    const bool valid = stream.status() == QDataStream::Ok && stream.atEnd();
+    buffer.remove(0, int(sizeof(quint32) + size));
+    return valid ? 1 : -1;
+}
+
+}
@@ -0,0 +1,108 @@
+/*
+    AtCore Daemon
+
+    Copyright (C) 2026 The AtCore contributors
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+#include <QVariantMap>
+
+/**
+ * Binary protocol spoken by atcored over its local socket
+ *
+ * Every message is a frame: a big endian quint32 giving the size of the rest,
+ * then, written with QDataStream (Qt 5.4 format), the quint8 type, the quint32
+ * request id chosen by the client, the printer name and a QVariantMap of fields.
+ *
+ * Requests, fields in parentheses:
+ *  - Open (port, baud, firmware): connect a printer under the given name, firmware detected when empty
+ *  - Close: disconnect the printer
+ *  - Command (gcode): queue a command, the Reply carries its reply lines
+ *  - Print (file): stream a job, Pause, Resume, Stop and EmergencyStop control it
+ *  - Subscribe (topics, interval): get Telemetry for the printer, at most every interval msecs
+ *  - Unsubscribe: stop the Telemetry of the printer
+ *  - List: Reply with the printers open
+ *
+ * Every request is answered by a Reply (ok, error, lines, printers) with its request id.
+ * Telemetry frames carry, for the topics subscribed, the latest value of what changed
+ * since the previous frame (state, bedTemperature, ..., progress, status) and every
+ * message received meanwhile (messages).
+ */
+namespace DaemonProtocol
+{
+
+/**
+ * @brief Type of a message
+ */
+enum MessageType : quint8 {
+    Open = 1,
+    Close,
+    Command,
+    Print,
+    Pause,
+    Resume,
+    Stop,
+    EmergencyStop,
+    Subscribe,
+    Unsubscribe,
+    List,
+    Reply = 64,
+    Telemetry
+};
+
+/**
+ * @brief Telemetry streams a client subscribes to, or-ed together
+ */
+enum Topic {
+    StateTopic = 1 << 0,        //!< state
+    TemperatureTopic = 1 << 1,  //!< bedTemperature, bedTargetTemperature, extruderTemperature, extruderTargetTemperature
+    ProgressTopic = 1 << 2,     //!< progress
+    StatusTopic = 1 << 3,       //!< status, as AtCore::machineStatus()
+    MessageTopic = 1 << 4,      //!< messages, every line received from the printer
+    AllTopics = (1 << 5) - 1
+};
+
+/**
+ * @brief Largest frame accepted, bigger ones mean the stream is corrupt
+ */
+const quint32 MaxFrameSize = 1 << 20;
+
+/**
+ * @brief One message of the protocol
+ */
+struct Message {
+    quint8 type = 0;        //!< @param type: MessageType
+    quint32 request = 0;    //!< @param request: id of the request, echoed by its Reply
+    QString printer;        //!< @param printer: name of the printer
+    QVariantMap fields;     //!< @param fields: content, depends on the type
+};
+
+/**
+ * @brief Frame \p message for writing
+ */
+QByteArray encode(const Message &message);
+
+/**
+ * @brief Take the first complete frame out of \p buffer
+ * @param buffer: bytes received, the frame is removed from it
+ * @param message: filled with the message read
+ * @return 1 if a message was read, 0 if the frame is not complete yet, -1 if the stream is corrupt
+ */
+int decode(QByteArray &buffer, Message &message);
+
+}
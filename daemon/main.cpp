@@ -0,0 +1,44 @@
+/*
+    AtCore Daemon
+
+    Copyright (C) 2026 The AtCore contributors
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <QCommandLineParser>
+#include <QCoreApplication>
+
+#include "printerdaemon.h"
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setOrganizationName(QStringLiteral("KDE"));
+    QCoreApplication::setOrganizationDomain(QStringLiteral("kde.org"));
+    QCoreApplication::setApplicationName(QStringLiteral("atcored"));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Share printer connections between local clients."));
+    parser.addHelpOption();
+    const QCommandLineOption socketOption({QStringLiteral("s"), QStringLiteral("socket")}, QStringLiteral("Name or path of the local socket, default atcored."), QStringLiteral("name"), QStringLiteral("atcored"));
+    parser.addOption(socketOption);
+    parser.process(app);
+
+    PrinterDaemon daemon;
+    if (!daemon.listen(parser.value(socketOption))) {
+        return 1;
+    }
+    qInfo("Listening on %s", qPrintable(daemon.serverPath()));
+    return app.exec();
+}
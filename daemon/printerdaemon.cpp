@@ -0,0 +1,203 @@
+/*
+    AtCore Daemon
+
+    Copyright (C) 2026 The AtCore contributors
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <QFile>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QPointer>
+
+#include "atcore.h"
+#include "clientconnection.h"
+#include "ifirmware.h"
+#include "printerdaemon.h"
+#include "printersession.h"
+
+using namespace DaemonProtocol;
+
+namespace
+{
+//Telemetry interval of a subscription in msecs, default and bounds.
+const int _defaultInterval = 250;
+const int _minInterval = 20;
+const int _maxInterval = 10000;
+//msecs to wait for a daemon already listening on the name to answer
+const int _probeTimeout = 1000;
+}
+
+PrinterDaemon::PrinterDaemon(QObject *parent)
+    : QObject(parent)
+    , _server(new QLocalServer(this))
+{
+    _server->setSocketOptions(QLocalServer::UserAccessOption);
+    connect(_server, &QLocalServer::newConnection, this, &PrinterDaemon::acceptClients);
+}
+
+PrinterDaemon::~PrinterDaemon()
+{
+    //Clients first, they hold subscriptions to the printers.
+    qDeleteAll(_clients);
+    qDeleteAll(_printers);
+}
+
+bool PrinterDaemon::listen(const QString &name)
+{
+    if (!_server->listen(name)) {
+        //A daemon that died leaves its socket behind, only a socket nobody answers on is removed.
+        QLocalSocket probe;
+        probe.connectToServer(name);
+        if (probe.waitForConnected(_probeTimeout)) {
+            qCritical("Another daemon already listens on %s.", qPrintable(name));
+            return false;
+        }
+        QLocalServer::removeServer(name);
+    }
+    if (!_server->isListening() && !_server->listen(name)) {
+        qCritical("Unable to listen on %s: %s", qPrintable(name), qPrintable(_server->errorString()));
+        return false;
+    }
+    return true;
+}
+
+QString PrinterDaemon::serverPath() const
+{
+    return _server->fullServerName();
+}
+
+void PrinterDaemon::acceptClients()
+{
+    while (QLocalSocket *socket = _server->nextPendingConnection()) {
+        ClientConnection *client = new ClientConnection(socket);
+        connect(client, &ClientConnection::requested, this, &PrinterDaemon::handle);
+        connect(client, &ClientConnection::disconnected, this, &PrinterDaemon::dropClient);
+        _clients.append(client);
+    }
+}
+
+void PrinterDaemon::dropClient(ClientConnection *client)
+{
+    _clients.removeOne(client);
+    client->deleteLater();
+}
+
+void PrinterDaemon::handle(ClientConnection *client, const Message &message)
+{
+    if (message.type == Open) {
+        openPrinter(client, message);
+        return;
+    }
+    if (message.type == List) {
+        client->reply(message.request, QString(), {{QStringLiteral("printers"), printerList()}});
+        return;
+    }
+
+    PrinterSession *printer = _printers.value(message.printer);
+    if (!printer) {
+        client->reply(message.request, QStringLiteral("No printer %1").arg(message.printer));
+        return;
+    }
+    AtCore *core = printer->core();
+    switch (message.type) {
+    case Close:
+        _printers.remove(message.printer);
+        //Subscriptions drop with the printer.
+        for (ClientConnection *other : _clients) {
+            other->unsubscribe(message.printer);
+        }
+        delete printer;
+        break;
+    case Command: {
+        //Answered with the reply of the printer, once it acknowledged the command.
+        QPointer<ClientConnection> guard(client);
+        const quint32 request = message.request;
+        core->pushCommand(message.fields.value(QStringLiteral("gcode")).toString(), [guard, request](const QStringList & lines, bool aborted) {
+            if (guard) {
+                guard->reply(request, aborted ? QStringLiteral("Command dropped") : QString(), {{QStringLiteral("lines"), lines}});
+            }
+        });
+        return;
+    }
+    case Print: {
+        const QString file = message.fields.value(QStringLiteral("file")).toString();
+        if (!QFile::exists(file)) {
+            client->reply(message.request, QStringLiteral("No file %1").arg(file));
+            return;
+        }
+        core->print(file);
+        break;
+    }
+    case Pause:
+        core->pause(message.fields.value(QStringLiteral("actions")).toString());
+        break;
+    case Resume:
+        core->resume();
+        break;
+    case Stop:
+        core->stop();
+        break;
+    case EmergencyStop:
+        core->emergencyStop();
+        break;
+    case Subscribe: {
+        const int topics = message.fields.value(QStringLiteral("topics"), int(AllTopics)).toInt() & AllTopics;
+        const int interval = qBound(_minInterval, message.fields.value(QStringLiteral("interval"), _defaultInterval).toInt(), _maxInterval);
+        client->subscribe(printer, topics, interval);
+        break;
+    }
+    case Unsubscribe:
+        client->unsubscribe(message.printer);
+        break;
+    default:
+        client->reply(message.request, QStringLiteral("Unknown request %1").arg(int(message.type)));
+        return;
+    }
+    client->reply(message.request, QString());
+}
+
+void PrinterDaemon::openPrinter(ClientConnection *client, const Message &message)
+{
+    if (message.printer.isEmpty() || _printers.contains(message.printer)) {
+        client->reply(message.request, QStringLiteral("Printer name %1 is empty or taken").arg(message.printer));
+        return;
+    }
+    PrinterSession *printer = new PrinterSession(message.printer);
+    QString error;
+    if (!printer->open(message.fields.value(QStringLiteral("port")).toString(),
+                       message.fields.value(QStringLiteral("baud"), 115200).toInt(),
+                       message.fields.value(QStringLiteral("firmware")).toString(), error)) {
+        delete printer;
+        client->reply(message.request, error);
+        return;
+    }
+    _printers.insert(message.printer, printer);
+    client->reply(message.request, QString());
+}
+
+QVariantList PrinterDaemon::printerList() const
+{
+    QVariantList printers;
+    for (PrinterSession *printer : _printers) {
+        AtCore *core = printer->core();
+        printers.append(QVariantMap({
+            {QStringLiteral("name"), printer->name()},
+            {QStringLiteral("port"), printer->port()},
+            {QStringLiteral("state"), int(core->state())},
+            {QStringLiteral("firmware"), core->firmwarePluginLoaded() ? core->firmwarePlugin()->name() : QString()}
+        }));
+    }
+    return printers;
+}
@@ -0,0 +1,87 @@
+/*
+    AtCore Daemon
+
+    Copyright (C) 2026 The AtCore contributors
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <QList>
+#include <QMap>
+#include <QObject>
+
+#include "daemonprotocol.h"
+
+class QLocalServer;
+class ClientConnection;
+class PrinterSession;
+
+/**
+ * @brief The PrinterDaemon class
+ * Owns the printer connections and serves them to local clients
+ *
+ * Printers stay connected when the client that opened them leaves, any client
+ * may use them until one closes them.
+ */
+class PrinterDaemon : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit PrinterDaemon(QObject *parent = nullptr);
+    ~PrinterDaemon() override;
+
+    /**
+     * @brief Listen for clients on the local socket \p name
+     * @return False if the socket could not be created
+     */
+    bool listen(const QString &name);
+
+    /**
+     * @brief Full path of the socket clients connect to
+     */
+    QString serverPath() const;
+
+private slots:
+    /**
+     * @brief Take the clients waiting on the socket
+     */
+    void acceptClients();
+
+    /**
+     * @brief Forget \p client
+     */
+    void dropClient(ClientConnection *client);
+
+    /**
+     * @brief Carry out the request \p message of \p client
+     */
+    void handle(ClientConnection *client, const DaemonProtocol::Message &message);
+
+private:
+    /**
+     * @brief Connect the printer requested by \p message
+     */
+    void openPrinter(ClientConnection *client, const DaemonProtocol::Message &message);
+
+    /**
+     * @brief Name, port, state and firmware of every printer
+     */
+    QVariantList printerList() const;
+
+    QLocalServer *_server;
+    QList<ClientConnection *> _clients;
+    QMap<QString, PrinterSession *> _printers;
+};
@@ -0,0 +1,116 @@
+/*
+    AtCore Daemon
+
+    Copyright (C) 2026 The AtCore contributors
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "atcore.h"
+#include "daemonprotocol.h"
+#include "printersession.h"
+#include "temperature.h"
+
+using namespace DaemonProtocol;
+
+PrinterSession::PrinterSession(const QString &name, QObject *parent)
+    : QObject(parent)
+    , _name(name)
+    , _core(new AtCore(this))
+{
+    connect(_core, &AtCore::stateChanged, this, [this](AtCore::STATES state) {
+        emit updated(StateTopic, QStringLiteral("state"), int(state));
+    });
+    connect(_core, &AtCore::printProgressChanged, this, [this](float progress) {
+        emit updated(ProgressTopic, QStringLiteral("progress"), progress);
+    });
+    connect(_core, &AtCore::machineStatusChanged, this, [this](const QVariantMap & status) {
+        emit updated(StatusTopic, QStringLiteral("status"), status);
+    });
+    connect(_core, &AtCore::receivedMessage, this, [this](const QByteArray & message) {
+        emit updated(MessageTopic, QStringLiteral("messages"), QString::fromLocal8Bit(message));
+    });
+    Temperature *temperature = &_core->temperature();
+    connect(temperature, &Temperature::bedTemperatureChanged, this, [this](float temp) {
+        emit updated(TemperatureTopic, QStringLiteral("bedTemperature"), temp);
+    });
+    connect(temperature, &Temperature::bedTargetTemperatureChanged, this, [this](float temp) {
+        emit updated(TemperatureTopic, QStringLiteral("bedTargetTemperature"), temp);
+    });
+    connect(temperature, &Temperature::extruderTemperatureChanged, this, [this](float temp) {
+        emit updated(TemperatureTopic, QStringLiteral("extruderTemperature"), temp);
+    });
+    connect(temperature, &Temperature::extruderTargetTemperatureChanged, this, [this](float temp) {
+        emit updated(TemperatureTopic, QStringLiteral("extruderTargetTemperature"), temp);
+    });
+}
+
+PrinterSession::~PrinterSession()
+{
+    _core->closeConnection();
+}
+
+QString PrinterSession::name() const
+{
+    return _name;
+}
+
+QString PrinterSession::port() const
+{
+    return _port;
+}
+
+AtCore *PrinterSession::core() const
+{
+    return _core;
+}
+
+bool PrinterSession::open(const QString &port, int baud, const QString &firmware, QString &error)
+{
+    if (!_core->initSerial(port, baud)) {
+        error = QStringLiteral("Unable to open %1").arg(port);
+        return false;
+    }
+    _port = port;
+    if (!firmware.isEmpty()) {
+        _core->loadFirmwarePlugin(firmware.toLower());
+        if (!_core->firmwarePluginLoaded()) {
+            error = QStringLiteral("No plugin for %1").arg(firmware);
+            _core->closeConnection();
+            return false;
+        }
+    }
+    return true;
+}
+
+QVariantMap PrinterSession::snapshot(int topics) const
+{
+    QVariantMap values;
+    if (topics & StateTopic) {
+        values.insert(QStringLiteral("state"), int(_core->state()));
+    }
+    if (topics & TemperatureTopic) {
+        const Temperature &temperature = _core->temperature();
+        values.insert(QStringLiteral("bedTemperature"), temperature.bedTemperature());
+        values.insert(QStringLiteral("bedTargetTemperature"), temperature.bedTargetTemperature());
+        values.insert(QStringLiteral("extruderTemperature"), temperature.extruderTemperature());
+        values.insert(QStringLiteral("extruderTargetTemperature"), temperature.extruderTargetTemperature());
+    }
+    if (topics & ProgressTopic) {
+        values.insert(QStringLiteral("progress"), _core->percentagePrinted());
+    }
+    if (topics & StatusTopic) {
+        values.insert(QStringLiteral("status"), _core->machineStatus());
+    }
+    return values;
+}
@@ -0,0 +1,84 @@
+/*
+    AtCore Daemon
+
+    Copyright (C) 2026 The AtCore contributors
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QVariantMap>
+
+class AtCore;
+
+/**
+ * @brief The PrinterSession class
+ * One printer connection held by the daemon for all its clients
+ *
+ * Turns the signals of AtCore into updated() calls keyed by telemetry topic.
+ */
+class PrinterSession : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit PrinterSession(const QString &name, QObject *parent = nullptr);
+    ~PrinterSession() override;
+
+    /**
+     * @brief Name clients use for the printer
+     */
+    QString name() const;
+
+    /**
+     * @brief Port the printer is connected to
+     */
+    QString port() const;
+
+    /**
+     * @brief The connection
+     */
+    AtCore *core() const;
+
+    /**
+     * @brief Connect to the printer
+     * @param port: serial port
+     * @param baud: baud rate
+     * @param firmware: plugin to load, empty to detect it
+     * @param error: set to the reason of a failure
+     * @return False if the port or the plugin could not be opened
+     */
+    bool open(const QString &port, int baud, const QString &firmware, QString &error);
+
+    /**
+     * @brief Current values of \p topics, what a new subscriber starts from
+     */
+    QVariantMap snapshot(int topics) const;
+
+signals:
+    /**
+     * @brief Something the clients may subscribe to changed
+     * @param topic: DaemonProtocol::Topic of the value
+     * @param key: field of the value in Telemetry
+     * @param value: new value, one line for the messages
+     */
+    void updated(int topic, const QString &key, const QVariant &value);
+
+private:
+    QString _name;
+    QString _port;
+    AtCore *_core;
+};
@@ -10,7 +10,7 @@ fwlist = {
 			REPETIER_PROTOCOL:3\n\r""",
 	'marlin' : """FIRMWARE_NAME:Marlin XXX SOURCE_CODE_URL:XXX
 			PROTOCOL_VERSION:XXX MACHINE_TYPE:XXX EXTRUDER_COUNT:XXX
-			UUID:XXX\n\r""",
+			UUID:XXX\nCap:MEATPACK:1\n\r""",
 	'sprinter' : """FIRMWARE_NAME: Sprinter Experimental PROTOCOL_VERSION:1.0
 			MACHINE_TYPE:Mendel EXTRUDER_COUNT:1\n\r""",
 	'teacup' : """FIRMWARE_NAME:Teacup FIRMWARE_URL:http://github.com/traumflug/Teacup_Firmware/
@@ -32,17 +32,97 @@ if(len(sys.argv) == 2):
 
 ser = serial.Serial('/dev/ttyVirtual2')
 
+class MeatPack:
+	"""Unpack MeatPack streams as Marlin does, count the bytes saved"""
+	codes = '0123456789. \nGX'
+
+	def __init__(self):
+		self.packing = False
+		self.noSpaces = False
+		self.signals = 0
+		self.pending = []
+		self.literals = 0
+		self.received = 0
+		self.unpacked = 0
+
+	def feed(self, byte):
+		"""Return the characters unpacked from byte"""
+		self.received += 1
+		if byte == 0xFF and self.literals == 0:
+			self.signals += 1
+			return ''
+		if self.signals >= 2:
+			self.signals = 0
+			self.command(byte)
+			return ''
+		text = ''
+		if self.signals == 1:
+			# A packed byte of two literals, not a command
+			self.signals = 0
+			text = self.unpack(0xFF)
+		return text + self.unpack(byte)
+
+	def unpack(self, byte):
+		if not self.packing:
+			self.unpacked += 1
+			return chr(byte)
+		if self.literals > 0:
+			self.literals -= 1
+			self.pending[self.pending.index(None)] = chr(byte)
+		else:
+			for code in (byte & 0xF, byte >> 4):
+				if code == 0xF:
+					self.literals += 1
+					self.pending.append(None)
+					continue
+				self.pending.append(self.char(code))
+				if code == 12:
+					# The high bits of a byte ending a line are skipped
+					break
+		if self.literals > 0:
+			return ''
+		text = ''.join(self.pending)
+		self.pending = []
+		self.unpacked += len(text)
+		return text
+
+	def char(self, code):
+		if code == 11 and self.noSpaces:
+			return 'E'
+		return self.codes[code]
+
+	def command(self, byte):
+		if byte == 0xFB:
+			self.packing = True
+		elif byte in (0xFA, 0xF9):
+			self.packing = False
+		elif byte == 0xF7:
+			self.noSpaces = True
+		elif byte == 0xF6:
+			self.noSpaces = False
+		ser.write(('[MP] PV01 %s %s\n' % ('ON' if self.packing else 'OFF', 'NSP' if self.noSpaces else 'ESP')).encode())
+
 def check(msg):
 	if(msg == 'M115'):
 		return fwlist[fwname]
 	return 'ok\n\r'
 
-while(True):
-	line = ser.readline().strip()
-	print(line)
-	ans = check(line.decode()).encode()
-	print(ans)
-	ser.write(ans)
-	while(ser.inWaiting()<1):
-		time.sleep(0.01)
-
+meatpack = MeatPack()
+line = ''
+try:
+	while(True):
+		for char in meatpack.feed(ord(ser.read(1))):
+			if char not in '\r\n':
+				line += char
+				continue
+			line = line.strip()
+			if not line:
+				continue
+			print(line)
+			ans = check(line).encode()
+			print(ans)
+			ser.write(ans)
+			line = ''
+except KeyboardInterrupt:
+	if meatpack.unpacked:
+		print('Received %d bytes for %d characters (%.0f%%)' % (meatpack.received, meatpack.unpacked, 100.0 * meatpack.received / meatpack.unpacked))
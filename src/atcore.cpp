@@ -24,28 +24,108 @@
     License along with this library.  If not, see <http://www.gnu.org/licenses/>.
 */
 #include <QDir>
+#include <QEvent>
 #include <QSerialPortInfo>
 #include <QPluginLoader>
+#include <QPointer>
 #include <QCoreApplication>
 #include <QLoggingCategory>
 #include <QTime>
 #include <QTimer>
 #include <QThread>
+#include <QRegularExpression>
+
+#include <functional>
 
 #include "atcore.h"
 #include "atcore_version.h"
 #include "seriallayer.h"
 #include "gcodecommands.h"
 #include "printthread.h"
+#include "commandreply.h"
+#include "protocol/protocolengine.h"
+#include "protocol/seqlock.h"
+#include "sharedsnapshot.h"
+#include "timerservice.h"
 #include "atcore_default_folders.h"
 
 Q_LOGGING_CATEGORY(ATCORE_PLUGIN, "org.kde.atelier.core.plugin")
 Q_LOGGING_CATEGORY(ATCORE_CORE, "org.kde.atelier.core")
+
+namespace
+{
+/**
+ * @brief Convert the reply lines of the protocol engine
+ * @param reply: lines of a reply
+ */
+QStringList toStringList(const std::vector<std::string> &reply)
+{
+    QStringList lines;
+    lines.reserve(int(reply.size()));
+    for (const std::string &line : reply) {
+        lines.append(QString::fromStdString(line));
+    }
+    return lines;
+}
+
+/**
+ * @brief Copy up to \p size numbers of the list \p value to \p values
+ * @return Count of numbers copied
+ */
+std::size_t toArray(const QVariant &value, float *values, std::size_t size)
+{
+    const QVariantList list = value.toList();
+    std::size_t count = 0;
+    for (; count < size && count < std::size_t(list.size()); count++) {
+        values[count] = list.at(int(count)).toFloat();
+    }
+    return count;
+}
+
+/**
+ * @brief Read X, Y and Z of the last M114 reply, as kept in AtCorePrivate::posString
+ * @return False unless all three were found
+ */
+bool parsePosition(const QByteArray &posString, double *values)
+{
+    int found = 0;
+    for (const QByteArray &field : posString.split(' ')) {
+        const int axis = field.isEmpty() ? -1 : QByteArrayLiteral("XYZ").indexOf(field.at(0));
+        bool ok = false;
+        const double value = axis < 0 ? 0 : field.mid(1).toDouble(&ok);
+        if (ok && !(found & (1 << axis))) {
+            values[axis] = value;
+            found |= 1 << axis;
+        }
+    }
+    return found == 7;
+}
+}
+/**
+ * @brief A periodic timer of AtCore and the service running it
+ *
+ * Services are per thread: the one that started the timer has to stop it.
+ * A thread change stops the timer and starts it again on the new thread.
+ */
+struct AtCoreTimer {
+    QPointer<TimerService> service;     //!< @param service: service running the timer, gone with its thread
+    TimerService::TimerId id = 0;       //!< @param id: timer in service, 0 when stopped
+    bool restart = false;               //!< @param restart: stopped by a thread change, to start on the new thread
+
+    /**
+     * @brief True if the timer is running
+     */
+    bool isActive() const
+    {
+        return service && service->isActive(id);
+    }
+};
+
 /**
  * @brief The AtCorePrivate struct
  */
 struct AtCorePrivate {
-    IFirmware *firmwarePlugin = nullptr;//!< @param firmwarePlugin: pointer to firmware plugin
+    IFirmware *firmwarePlugin = nullptr;//!< @param firmwarePlugin: firmware handler of this connection, owned
     SerialLayer *serial = nullptr;      //!< @param serial: pointer to the serial layer
     QPluginLoader pluginLoader;         //!< @param pluginLoader: QPluginLoader
     QDir pluginsDir;                    //!< @param pluginsDir: Directory where plugins were found
@@ -53,14 +133,31 @@ struct AtCorePrivate {
     QByteArray lastMessage;             //!< @param lastMessage: lastMessage from the printer
     int extruderCount = 1;              //!< @param extruderCount: extruder count
     Temperature temperature;            //!< @param temperature: Temperature object
-    QStringList commandQueue;           //!< @param commandQueue: the list of commands to send to the printer
-    bool ready = false;                 //!< @param ready: True if printer is ready for a command
-    QTimer *tempTimer = nullptr;        //!< @param tempTimer: timer connected to the checkTemperature function
-    float percentage;                   //!< @param percentage: print job percent
+    AtCoreProtocol::ProtocolEngine protocol;//!< @param protocol: queue and flow control of the commands sent to the printer
+    AtCoreTimer tempTimer;              //!< @param tempTimer: timer running the checkTemperature function
+    int tempInterval = 5000;            //!< @param tempInterval: milliseconds between temperature queries
+    AtCoreTimer statusTimer;            //!< @param statusTimer: timer running the checkStatus function
+    int statusInterval = 200;           //!< @param statusInterval: milliseconds between status queries, 0 disabled
+    QVariantMap machineStatus;          //!< @param machineStatus: last status reported by the firmware
+    float percentage = 0;               //!< @param percentage: print job percent
+    int printLayer = 0;                 //!< @param printLayer: layer being printed
+    int printLayerCount = 0;            //!< @param printLayerCount: layers of the print job
+    qint64 printTimeLeft = 0;           //!< @param printTimeLeft: estimated milliseconds left of the print job
     QByteArray posString;               //!< @param posString: stored string from last M114 return
     AtCore::STATES printerState;        //!< @param printerState: State of the Printer
     QStringList serialPorts;            //!< @param seralPorts: Detected serial Ports
-    QTimer *serialTimer = nullptr;      //!< @param serialTimer: Timer connected to locateSerialPorts
+    AtCoreTimer serialTimer;            //!< @param serialTimer: timer running locateSerialPort
+    quint16 serialInterval = 0;         //!< @param serialInterval: milliseconds between serial port scans, 0 disabled
+    QThread *printThread = nullptr;     //!< @param printThread: Thread the print worker lives in
+    PrintThread *printWorker = nullptr; //!< @param printWorker: print worker reused for every job
+    bool optimizeJobStart = false;      //!< @param optimizeJobStart: overlap heating with homing at the start of jobs
+    bool hotProbe = false;              //!< @param hotProbe: the probe needs a hot nozzle
+    AtCoreProtocol::SeqLock<AtCoreProtocol::PrinterSnapshot> snapshot;//!< @param snapshot: last state published
+    SharedSnapshot *sharedSnapshot = nullptr;//!< @param sharedSnapshot: segment snapshot is exported to, may be null
+    quint64 commandsSent = 0;           //!< @param commandsSent: commands written since connecting
+    quint64 commandsAcknowledged = 0;   //!< @param commandsAcknowledged: acknowledges since connecting
+    quint64 bytesSent = 0;              //!< @param bytesSent: bytes written since connecting
+    quint64 linesReceived = 0;          //!< @param linesReceived: lines read since connecting
 };
 
 AtCore::AtCore(QObject *parent) :
@@ -70,9 +167,34 @@ AtCore::AtCore(QObject *parent) :
     qRegisterMetaType<AtCore::STATES>("AtCore::STATES");
     setState(AtCore::DISCONNECTED);
 
-    d->tempTimer = new QTimer(this);
-    d->tempTimer->setInterval(5000);
-    d->tempTimer->setSingleShot(false);
+    //Acknowledges come from IFirmware::readyForCommand, received lines only fill replies.
+    AtCoreProtocol::Dialect dialect;
+    dialect.name = "IFirmware";
+    d->protocol.setDialect(dialect);
+    d->protocol.setWriteHandler([this](const std::string & command) {
+        if (!serialInitialized()) {
+            qCDebug(ATCORE_PLUGIN) << "Can't process queue ! Serial not initialized.";
+            return false;
+        }
+        const QString text = QString::fromStdString(command);
+        if (firmwarePluginLoaded()) {
+            serial()->pushCommand(firmwarePlugin()->translate(text), firmwarePlugin()->lineTerminator());
+        } else {
+            serial()->pushCommand(text.toLocal8Bit());
+        }
+        d->commandsSent++;
+        publishSnapshot();
+        return true;
+    });
+    d->protocol.setRejectHandler([this](const std::string & command) {
+        const QString text = QString::fromStdString(command);
+        qCDebug(ATCORE_CORE) << "Command is longer than the firmware accepts:" << text;
+        emit commandRejected(text);
+    });
+    connect(&d->temperature, &Temperature::bedTemperatureChanged, this, &AtCore::publishSnapshot);
+    connect(&d->temperature, &Temperature::bedTargetTemperatureChanged, this, &AtCore::publishSnapshot);
+    connect(&d->temperature, &Temperature::extruderTemperatureChanged, this, &AtCore::publishSnapshot);
+    connect(&d->temperature, &Temperature::extruderTargetTemperatureChanged, this, &AtCore::publishSnapshot);
 
     QStringList pathList = AtCoreDirectories::pluginDir;
     pathList.append(QLibraryInfo::location(QLibraryInfo::PluginsPath) + QStringLiteral("/AtCore"));
@@ -97,6 +219,19 @@ AtCore::AtCore(QObject *parent) :
     setState(AtCore::DISCONNECTED);
 }
 
+AtCore::~AtCore()
+{
+    if (d->printThread) {
+        d->printThread->quit();
+        d->printThread->wait();
+    }
+    stopPeriodic(d->tempTimer);
+    stopPeriodic(d->statusTimer);
+    stopPeriodic(d->serialTimer);
+    delete d->sharedSnapshot;
+    delete d;
+}
+
 QString AtCore::version() const
 {
     QString versionString = QString::fromLatin1(ATCORE_VERSION_STRING);
@@ -173,9 +308,9 @@ void AtCore::findFirmware(const QByteArray &message)
     }
     qCDebug(ATCORE_CORE) << "Firmware Name:" << fwName;
 
-    if (message.contains("EXTRUDER_COUNT:")) {
-        //this code is broken if more then 9 extruders are detected. since only one char is returned
-        d->extruderCount = message.at(message.indexOf("EXTRUDER_COUNT:") + 15) - '0';
+    QRegularExpressionMatch extruderCheck = QRegularExpression(QStringLiteral("EXTRUDER_COUNT:(?<count>\\d+)")).match(QString::fromLatin1(message));
+    if (extruderCheck.hasMatch()) {
+        d->extruderCount = extruderCheck.captured(QStringLiteral("count")).toInt();
     }
     qCDebug(ATCORE_CORE) << "Extruder Count:" << QString::number(extruderCount());
 
@@ -191,7 +326,13 @@ void AtCore::loadFirmwarePlugin(const QString &fwName)
         } else {
             qCDebug(ATCORE_PLUGIN) << "Loading plugin.";
         }
-        d->firmwarePlugin = qobject_cast<IFirmware *>(d->pluginLoader.instance());
+        //The plugin instance is shared by every AtCore of the process, each connection gets its own handler.
+        IFirmware *factory = qobject_cast<IFirmware *>(d->pluginLoader.instance());
+        delete d->firmwarePlugin;
+        d->firmwarePlugin = factory ? factory->create() : nullptr;
+        if (factory && !d->firmwarePlugin) {
+            qCDebug(ATCORE_PLUGIN) << "Plugin" << factory->name() << "has no invokable constructor.";
+        }
 
         if (!firmwarePluginLoaded()) {
             qCDebug(ATCORE_PLUGIN) << "No plugin loaded.";
@@ -199,14 +340,21 @@ void AtCore::loadFirmwarePlugin(const QString &fwName)
             setState(AtCore::CONNECTING);
         } else {
             qCDebug(ATCORE_PLUGIN) << "Connected to" << firmwarePlugin()->name();
+            firmwarePlugin()->setParent(this);
             firmwarePlugin()->init(this);
             disconnect(serial(), &SerialLayer::receivedCommand, this, &AtCore::findFirmware);
             connect(serial(), &SerialLayer::receivedCommand, this, &AtCore::newMessage);
             connect(firmwarePlugin(), &IFirmware::readyForCommand, this, &AtCore::processQueue);
-            d->ready = true; // ready on new firmware load
+            connect(firmwarePlugin(), &IFirmware::capabilityFound, this, &AtCore::enableCapability);
+            connect(firmwarePlugin(), &IFirmware::statusReported, this, &AtCore::updateMachineStatus);
+            d->protocol.setSendWindow(std::size_t(firmwarePlugin()->sendWindow()), std::size_t(firmwarePlugin()->lineTerminator().size()));
+            d->protocol.setMaxLineLength(std::size_t(firmwarePlugin()->maxLineLength()));
+            d->protocol.setReady(true); // ready on new firmware load
             if (firmwarePlugin()->name() != QStringLiteral("Grbl")) {
-                connect(d->tempTimer, &QTimer::timeout, this, &AtCore::checkTemperature);
-                d->tempTimer->start();
+                startPeriodic(d->tempTimer, d->tempInterval, &AtCore::checkTemperature);
+            }
+            if (!firmwarePlugin()->statusQuery().isEmpty() && statusInterval() > 0) {
+                startPeriodic(d->statusTimer, d->statusInterval, &AtCore::checkStatus);
             }
             setState(IDLE);
         }
@@ -219,6 +367,13 @@ bool AtCore::initSerial(const QString &port, int baud)
 {
     d->serial = new SerialLayer(port, baud);
     if (serialInitialized()) {
+        d->commandsSent = 0;
+        d->commandsAcknowledged = 0;
+        d->bytesSent = 0;
+        d->linesReceived = 0;
+        connect(serial(), &SerialLayer::pushedCommand, this, [this](const QByteArray & bytes) {
+            d->bytesSent += quint64(bytes.size());
+        });
         setState(AtCore::CONNECTING);
         connect(serial(), &SerialLayer::receivedCommand, this, &AtCore::findFirmware);
         return true;
@@ -272,26 +427,165 @@ void AtCore::locateSerialPort()
 
 quint16 AtCore::serialTimerInterval() const
 {
-    if (d->serialTimer != nullptr) {
-        return d->serialTimer->interval();
-    }
-    return 0;
+    return d->serialInterval;
 }
 
 void AtCore::setSerialTimerInterval(const quint16 &newTime)
 {
+    d->serialInterval = newTime;
     if (newTime == 0) {
-        if (d->serialTimer) {
-            disconnect(d->serialTimer, &QTimer::timeout, this, &AtCore::locateSerialPort);
-            delete d->serialTimer;
-        }
+        stopPeriodic(d->serialTimer);
         return;
     }
-    if (!d->serialTimer) {
-        d->serialTimer = new QTimer();
-        connect(d->serialTimer, &QTimer::timeout, this, &AtCore::locateSerialPort);
+    startPeriodic(d->serialTimer, newTime, &AtCore::locateSerialPort);
+}
+
+int AtCore::statusInterval() const
+{
+    return d->statusInterval;
+}
+
+void AtCore::setStatusInterval(int msecs)
+{
+    d->statusInterval = msecs > 0 ? qBound(50, msecs, 200) : 0;
+    if (d->statusInterval == 0) {
+        stopPeriodic(d->statusTimer);
+        return;
+    }
+    if (firmwarePluginLoaded() && !firmwarePlugin()->statusQuery().isEmpty() && state() != AtCore::DISCONNECTED) {
+        startPeriodic(d->statusTimer, d->statusInterval, &AtCore::checkStatus);
+    }
+}
+
+QVariantMap AtCore::machineStatus() const
+{
+    return d->machineStatus;
+}
+
+AtCoreProtocol::PrinterSnapshot AtCore::snapshot() const
+{
+    return d->snapshot.load();
+}
+
+bool AtCore::exportSnapshot(const QString &key)
+{
+    delete d->sharedSnapshot;
+    d->sharedSnapshot = nullptr;
+    if (key.isEmpty()) {
+        return true;
+    }
+    d->sharedSnapshot = new SharedSnapshot(key);
+    if (!d->sharedSnapshot->create()) {
+        qCDebug(ATCORE_CORE) << "Unable to export the snapshot to" << key << d->sharedSnapshot->errorString();
+        delete d->sharedSnapshot;
+        d->sharedSnapshot = nullptr;
+        return false;
+    }
+    publishSnapshot();
+    return true;
+}
+
+void AtCore::startPeriodic(AtCoreTimer &timer, int msecs, void (AtCore::*function)())
+{
+    stopPeriodic(timer);
+    timer.service = TimerService::instance();
+    timer.id = timer.service->start(this, msecs, std::bind(function, this));
+}
+
+void AtCore::stopPeriodic(AtCoreTimer &timer)
+{
+    if (timer.service) {
+        TimerService *service = timer.service;
+        const TimerService::TimerId id = timer.id;
+        if (service->thread() == QThread::currentThread()) {
+            service->stop(id);
+        } else {
+            //Services are not thread safe, stop it from its own thread.
+            QTimer::singleShot(0, service, [service, id] {
+                service->stop(id);
+            });
+        }
+    }
+    timer.service = nullptr;
+    timer.id = 0;
+    timer.restart = false;
+}
+
+bool AtCore::event(QEvent *e)
+{
+    if (e->type() == QEvent::ThreadChange) {
+        //Sent from the old thread, the queued call moves with us and runs on the new one.
+        for (AtCoreTimer *timer : {&d->tempTimer, &d->statusTimer, &d->serialTimer}) {
+            const bool active = timer->isActive();
+            stopPeriodic(*timer);
+            timer->restart = active;
+        }
+        QMetaObject::invokeMethod(this, "restartPeriodic", Qt::QueuedConnection);
+    }
+    return QObject::event(e);
+}
+
+void AtCore::restartPeriodic()
+{
+    if (d->tempTimer.restart) {
+        startPeriodic(d->tempTimer, d->tempInterval, &AtCore::checkTemperature);
+    }
+    if (d->statusTimer.restart) {
+        startPeriodic(d->statusTimer, d->statusInterval, &AtCore::checkStatus);
+    }
+    if (d->serialTimer.restart) {
+        startPeriodic(d->serialTimer, d->serialInterval, &AtCore::locateSerialPort);
+    }
+}
+
+void AtCore::publishSnapshot()
+{
+    AtCoreProtocol::PrinterSnapshot snapshot;
+    snapshot.state = d->printerState;
+
+    //Firmwares reporting every heater (RepRapFirmware) fill them all, else bed and hotend.
+    const std::size_t maxHeaters = AtCoreProtocol::PrinterSnapshot::MaxHeaters;
+    snapshot.heaterCount = quint32(toArray(d->machineStatus.value(QStringLiteral("heaters")), snapshot.temperature, maxHeaters));
+    if (snapshot.heaterCount > 0) {
+        toArray(d->machineStatus.value(QStringLiteral("active")), snapshot.target, snapshot.heaterCount);
+    } else {
+        snapshot.heaterCount = 2;
+        snapshot.temperature[0] = d->temperature.bedTemperature();
+        snapshot.target[0] = d->temperature.bedTargetTemperature();
+        snapshot.temperature[1] = d->temperature.extruderTemperature();
+        snapshot.target[1] = d->temperature.extruderTargetTemperature();
+    }
+
+    for (const QString &key : {QStringLiteral("workPosition"), QStringLiteral("position"), QStringLiteral("machinePosition")}) {
+        const QVariantList position = d->machineStatus.value(key).toList();
+        if (position.size() >= 3) {
+            snapshot.hasPosition = 1;
+            for (int i = 0; i < 3; i++) {
+                snapshot.position[i] = position.at(i).toDouble();
+            }
+            break;
+        }
+    }
+    //Marlin style firmwares only answer M114.
+    if (!snapshot.hasPosition && parsePosition(d->posString, snapshot.position)) {
+        snapshot.hasPosition = 1;
+    }
+
+    snapshot.progress = d->percentage;
+    snapshot.layer = d->printLayer;
+    snapshot.layerCount = d->printLayerCount;
+    snapshot.timeLeft = d->printTimeLeft;
+    snapshot.queueDepth = quint32(d->protocol.queue().size());
+    snapshot.inFlight = quint32(d->protocol.commandsInFlight());
+    snapshot.commandsSent = d->commandsSent;
+    snapshot.commandsAcknowledged = d->commandsAcknowledged;
+    snapshot.bytesSent = d->bytesSent;
+    snapshot.linesReceived = d->linesReceived;
+
+    d->snapshot.store(snapshot);
+    if (d->sharedSnapshot) {
+        d->sharedSnapshot->publish(snapshot);
     }
-    d->serialTimer->start(newTime);
 }
 
 void AtCore::newMessage(const QByteArray &message)
@@ -307,6 +601,9 @@ void AtCore::newMessage(const QByteArray &message)
     if (d->lastMessage.contains("T:") || d->lastMessage.contains("B:")) {
         temperature().decodeTemp(message);
     }
+    d->protocol.receiveLine(std::string(message.constData(), std::size_t(message.size())));
+    d->linesReceived++;
+    publishSnapshot();
     emit(receivedMessage(d->lastMessage));
 }
 
@@ -325,33 +622,187 @@ float AtCore::percentagePrinted() const
     return d->percentage;
 }
 
+int AtCore::printLayer() const
+{
+    return d->printLayer;
+}
+
+int AtCore::printLayerCount() const
+{
+    return d->printLayerCount;
+}
+
+qint64 AtCore::printTimeLeft() const
+{
+    return d->printTimeLeft;
+}
+
+void AtCore::updatePrintProgress(float progress, int layer, int layerCount, qint64 timeLeft)
+{
+    d->percentage = progress;
+    d->printLayer = layer;
+    d->printLayerCount = layerCount;
+    d->printTimeLeft = timeLeft;
+    publishSnapshot();
+    emit(printProgressChanged(progress));
+}
+
 void AtCore::print(const QString &fileName)
 {
-    if (state() == AtCore::CONNECTING) {
-        qCDebug(ATCORE_CORE) << "Load a firmware plugin to print.";
+    if (!preparePrint()) {
         return;
     }
-    //START A THREAD AND CONNECT TO IT
-    setState(AtCore::STARTPRINT);
-    QThread *thread = new QThread();
-    PrintThread *printThread = new PrintThread(this, fileName);
-    printThread->moveToThread(thread);
+    QMetaObject::invokeMethod(d->printWorker, "start", Qt::QueuedConnection, Q_ARG(QString, fileName),
+                              Q_ARG(bool, d->optimizeJobStart), Q_ARG(bool, d->hotProbe),
+                              Q_ARG(int, firmwarePlugin()->sendWindow()), Q_ARG(int, firmwarePlugin()->lineTerminator().size()),
+                              Q_ARG(int, firmwarePlugin()->maxLineLength()));
+}
 
-    connect(printThread, &PrintThread::printProgressChanged, this, &AtCore::printProgressChanged, Qt::QueuedConnection);
-    connect(thread, &QThread::started, printThread, &PrintThread::start);
-    connect(printThread, &PrintThread::finished, thread, &QThread::quit);
-    connect(thread, &QThread::finished, printThread, &PrintThread::deleteLater);
-    if (!thread->isRunning()) {
-        thread->start();
+void AtCore::print(QIODevice *device)
+{
+    if (!preparePrint()) {
+        device->deleteLater();
+        return;
     }
+    //The worker reads the job from its own thread.
+    device->setParent(nullptr);
+    device->moveToThread(d->printThread);
+    QMetaObject::invokeMethod(d->printWorker, "start", Qt::QueuedConnection, Q_ARG(QIODevice *, device),
+                              Q_ARG(bool, d->optimizeJobStart), Q_ARG(bool, d->hotProbe),
+                              Q_ARG(int, firmwarePlugin()->sendWindow()), Q_ARG(int, firmwarePlugin()->lineTerminator().size()),
+                              Q_ARG(int, firmwarePlugin()->maxLineLength()));
+}
+
+bool AtCore::preparePrint()
+{
+    if (!serialInitialized() || !firmwarePluginLoaded() || state() == AtCore::CONNECTING) {
+        qCDebug(ATCORE_CORE) << "Connect to the printer and load a firmware plugin to print.";
+        return false;
+    }
+    if (state() == AtCore::STARTPRINT || state() == AtCore::BUSY || state() == AtCore::PAUSE) {
+        qCDebug(ATCORE_CORE) << "A print job is already running.";
+        return false;
+    }
+    //The worker and its thread are created once and reused for every job.
+    if (!d->printThread) {
+        d->printThread = new QThread(this);
+        d->printWorker = new PrintThread(this);
+        d->printWorker->moveToThread(d->printThread);
+        connect(d->printWorker, &PrintThread::printProgressChanged, this, &AtCore::updatePrintProgress, Qt::QueuedConnection);
+        connect(d->printWorker, &PrintThread::jobStartOverlap, this, &AtCore::jobStartOverlap, Qt::QueuedConnection);
+        connect(d->printWorker, &PrintThread::error, this, &AtCore::printError, Qt::QueuedConnection);
+        connect(d->printWorker, &PrintThread::nextCommand, this, &AtCore::pushJobCommand, Qt::QueuedConnection);
+        connect(d->printThread, &QThread::finished, d->printWorker, &PrintThread::deleteLater);
+        d->printThread->start();
+    }
+    d->percentage = 0;
+    d->printLayer = 0;
+    d->printLayerCount = 0;
+    d->printTimeLeft = 0;
+    setState(AtCore::STARTPRINT);
+    return true;
+}
+
+void AtCore::setJobStartOptimization(bool enabled, bool hotProbe)
+{
+    d->optimizeJobStart = enabled;
+    d->hotProbe = hotProbe;
 }
 
 void AtCore::pushCommand(const QString &comm)
 {
-    d->commandQueue.append(comm);
-    if (d->ready) {
-        processQueue();
+    if (firmwarePluginLoaded() && firmwarePlugin()->isRealtimeCommand(comm)) {
+        pushRealtimeCommand(comm);
+        return;
     }
+    d->protocol.submit(comm.toStdString());
+}
+
+void AtCore::pushCommand(const QString &comm, const std::function<void(const QStringList &reply, bool aborted)> &done)
+{
+    if (firmwarePluginLoaded() && firmwarePlugin()->isRealtimeCommand(comm)) {
+        pushRealtimeCommand(comm);
+        //Realtime commands have no acknowledge, answer from the event loop like queued ones.
+        QTimer::singleShot(0, this, [done] {
+            done(QStringList(), false);
+        });
+        return;
+    }
+    d->protocol.submit(comm.toStdString(), [this, done](const std::vector<std::string> & reply, bool aborted) {
+        if (aborted) {
+            //Dropped while stopping or resetting, answer once that is done.
+            const QStringList lines = toStringList(reply);
+            QTimer::singleShot(0, this, [done, lines] {
+                done(lines, true);
+            });
+            return;
+        }
+        done(toStringList(reply), false);
+    });
+}
+
+void AtCore::pushJobCommand(const QString &comm)
+{
+    //The worker counts the lines in flight to keep the send window of the firmware full.
+    QPointer<PrintThread> worker(d->printWorker);
+    const auto done = [worker] {
+        if (worker) {
+            QMetaObject::invokeMethod(worker, "commandDone", Qt::QueuedConnection);
+        }
+    };
+    if (firmwarePluginLoaded() && firmwarePlugin()->isRealtimeCommand(comm)) {
+        pushRealtimeCommand(comm);
+        done();
+        return;
+    }
+    d->protocol.submit(comm.toStdString(), [done](const std::vector<std::string> &, bool) {
+        done();
+    });
+}
+
+CommandReply *AtCore::request(const QString &comm)
+{
+    CommandReply *reply = new CommandReply(comm, this);
+    QPointer<CommandReply> handle(reply);
+    pushCommand(comm, [handle](const QStringList & lines, bool aborted) {
+        if (handle) {
+            handle->setFinished(lines, aborted);
+        }
+    });
+    return reply;
+}
+
+CommandReply *AtCore::pushCommands(const QList<QByteArray> &commands)
+{
+    CommandReply *reply = new CommandReply(commands.isEmpty() ? QString() : QString::fromLatin1(commands.last()), this);
+    QPointer<CommandReply> handle(reply);
+    if (commands.isEmpty()) {
+        QTimer::singleShot(0, reply, [handle] {
+            handle->setFinished(QStringList());
+        });
+        return reply;
+    }
+
+    std::vector<std::string> batch;
+    batch.reserve(std::size_t(commands.size()));
+    for (const QByteArray &command : commands) {
+        batch.emplace_back(command.constData(), std::size_t(command.size()));
+    }
+    d->protocol.submit(batch, [handle](const std::vector<std::string> & lines, bool aborted) {
+        if (!handle) {
+            return;
+        }
+        const QStringList reply = toStringList(lines);
+        if (aborted) {
+            //Dropped while stopping or resetting, finish once that is done like pushCommand().
+            QTimer::singleShot(0, handle.data(), [handle, reply] {
+                handle->setFinished(reply, true);
+            });
+            return;
+        }
+        handle->setFinished(reply);
+    });
+    return reply;
 }
 
 void AtCore::closeConnection()
@@ -363,10 +814,10 @@ void AtCore::closeConnection()
         }
         if (firmwarePluginLoaded()) {
             disconnect(firmwarePlugin(), &IFirmware::readyForCommand, this, &AtCore::processQueue);
-            if (firmwarePlugin()->name() != QStringLiteral("Grbl")) {
-                disconnect(d->tempTimer, &QTimer::timeout, this, &AtCore::checkTemperature);
-                d->tempTimer->stop();
-            }
+            disconnect(firmwarePlugin(), &IFirmware::capabilityFound, this, &AtCore::enableCapability);
+            disconnect(firmwarePlugin(), &IFirmware::statusReported, this, &AtCore::updateMachineStatus);
+            stopPeriodic(d->statusTimer);
+            stopPeriodic(d->tempTimer);
         }
         serial()->close();
         setState(AtCore::DISCONNECTED);
@@ -384,6 +835,7 @@ void AtCore::setState(AtCore::STATES state)
         qCDebug(ATCORE_CORE) << "Atcore state changed from [" \
                              << d->printerState << "] to [" << state << "]";
         d->printerState = state;
+        publishSnapshot();
         emit(stateChanged(d->printerState));
     }
 }
@@ -391,7 +843,7 @@ void AtCore::setState(AtCore::STATES state)
 void AtCore::stop()
 {
     setState(AtCore::STOP);
-    d->commandQueue.clear();
+    d->protocol.clear();
     setExtruderTemp(0, 0);
     setBedTemp(0);
     home(AtCore::X);
@@ -402,8 +854,33 @@ void AtCore::emergencyStop()
     if (state() == AtCore::BUSY) {
         setState(AtCore::STOP);
     }
-    d->commandQueue.clear();
-    serial()->pushCommand(GCode::toCommand(GCode::M112).toLocal8Bit());
+    d->protocol.clear();
+    serial()->discardPendingOutput();
+    if (firmwarePluginLoaded() && !firmwarePlugin()->resetCommand().isEmpty()) {
+        //The firmware drops what it buffered, nothing in flight will be acknowledged.
+        serial()->pushUrgentCommand(firmwarePlugin()->resetCommand(), QByteArray());
+        d->protocol.reset();
+        return;
+    }
+    if (firmwarePluginLoaded()) {
+        serial()->pushUrgentCommand(firmwarePlugin()->translate(GCode::toCommand(GCode::M112)), firmwarePlugin()->lineTerminator());
+        return;
+    }
+    serial()->pushUrgentCommand(GCode::toCommand(GCode::M112).toLocal8Bit());
+}
+
+void AtCore::pushRealtimeCommand(const QString &comm)
+{
+    if (!serialInitialized()) {
+        qCDebug(ATCORE_CORE) << "There is no open device to send commands";
+        return;
+    }
+    //Quick stop discards every move still waiting to be sent.
+    if (comm.startsWith(QStringLiteral("M410"))) {
+        d->protocol.clear();
+        serial()->discardPendingOutput();
+    }
+    serial()->pushUrgentCommand(firmwarePlugin()->translate(comm), firmwarePlugin()->lineTerminator());
 }
 
 void AtCore::requestFirmware()
@@ -468,6 +945,11 @@ void AtCore::detectFirmware()
 
 void AtCore::pause(const QString &pauseActions)
 {
+    if (firmwarePluginLoaded() && !firmwarePlugin()->feedHoldCommand().isEmpty()) {
+        serial()->pushUrgentCommand(firmwarePlugin()->feedHoldCommand(), QByteArray());
+        setState(AtCore::PAUSE);
+        return;
+    }
     pushCommand(GCode::toCommand(GCode::M114));
     setState(AtCore::PAUSE);
     if (!pauseActions.isEmpty()) {
@@ -480,6 +962,11 @@ void AtCore::pause(const QString &pauseActions)
 
 void AtCore::resume()
 {
+    if (firmwarePluginLoaded() && !firmwarePlugin()->feedResumeCommand().isEmpty()) {
+        serial()->pushUrgentCommand(firmwarePlugin()->feedResumeCommand(), QByteArray());
+        setState(AtCore::BUSY);
+        return;
+    }
     pushCommand(GCode::toCommand(GCode::G0, QString::fromLatin1(d->posString)));
     setState(AtCore::BUSY);
 }
@@ -562,35 +1049,63 @@ int AtCore::extruderCount() const
     return d->extruderCount;
 }
 
+int AtCore::commandQueueSize() const
+{
+    return int(d->protocol.queue().size());
+}
+
 void AtCore::processQueue()
 {
-    d->ready = true;
+    d->commandsAcknowledged++;
+    d->protocol.acknowledge();
+    publishSnapshot();
+}
 
-    if (d->commandQueue.isEmpty()) {
+void AtCore::checkTemperature()
+{
+    //Firmwares reporting their whole state at once are polled for it instead.
+    const QString status = firmwarePluginLoaded() ? firmwarePlugin()->statusCommand() : QString();
+    const QString query = status.isEmpty() ? GCode::toCommand(GCode::M105) : status;
+    if (d->protocol.queue().contains(query.toStdString())) {
         return;
     }
+    pushCommand(query);
+}
 
-    if (!serialInitialized()) {
-        qCDebug(ATCORE_PLUGIN) << "Can't process queue ! Serial not initialized.";
+void AtCore::checkStatus()
+{
+    if (!serialInitialized() || !firmwarePluginLoaded()) {
         return;
     }
+    //Answered out of band, the status query has no acknowledge.
+    serial()->pushUrgentCommand(firmwarePlugin()->statusQuery(), QByteArray());
+}
 
-    QString text = d->commandQueue.takeAt(0);
-
-    if (firmwarePluginLoaded()) {
-        serial()->pushCommand(firmwarePlugin()->translate(text));
-    } else {
-        serial()->pushCommand(text.toLocal8Bit());
+void AtCore::updateMachineStatus(const QVariantMap &status)
+{
+    const QString alarm = QStringLiteral("Alarm");
+    const QString machineState = status.value(QStringLiteral("state")).toString();
+    if (machineState == alarm && state() != AtCore::ERRORSTATE) {
+        //The firmware refuses every command until it is homed or unlocked, ex Grbl after emergencyStop().
+        qCDebug(ATCORE_CORE) << "Firmware alarm" << status.value(QStringLiteral("alarm")).toString();
+        setState(AtCore::ERRORSTATE);
+    } else if (!machineState.isEmpty() && machineState != alarm && state() == AtCore::ERRORSTATE
+               && d->machineStatus.value(QStringLiteral("state")).toString() == alarm) {
+        setState(AtCore::IDLE);
     }
-    d->ready = false;
+    d->machineStatus = status;
+    publishSnapshot();
+    emit machineStatusChanged(status);
 }
 
-void AtCore::checkTemperature()
+void AtCore::enableCapability(const QString &capability)
 {
-    if (d->commandQueue.contains(GCode::toCommand(GCode::M105))) {
-        return;
+    qCDebug(ATCORE_CORE) << "Firmware capability:" << capability;
+    if (capability == QStringLiteral("AUTOREPORT_TEMP") && d->tempTimer.isActive()) {
+        //Let the firmware report temperatures instead of polling with M105.
+        stopPeriodic(d->tempTimer);
+        pushCommand(GCode::toCommand(GCode::M155, QString::number(d->tempInterval / 1000)));
     }
-    pushCommand(GCode::toCommand(GCode::M105));
 }
 
 void AtCore::showMessage(const QString &message)
@@ -29,15 +29,21 @@
 #include <QList>
 #include <QSerialPortInfo>
 
+#include <functional>
+
 #include "ifirmware.h"
 #include "temperature.h"
 #include "atcore_export.h"
+#include "protocol/printersnapshot.h"
 
 class SerialLayer;
 class IFirmware;
+class CommandReply;
+class QIODevice;
 class QTime;
 
 struct AtCorePrivate;
+struct AtCoreTimer;
 
 /**
  * @brief The AtCore class
@@ -55,6 +61,8 @@ class ATCORE_EXPORT AtCore : public QObject
     Q_PROPERTY(QString version READ version)
     Q_PROPERTY(QStringList availableFirmwarePlugins READ availableFirmwarePlugins)
     Q_PROPERTY(quint16 serialTimerInterval READ serialTimerInterval WRITE setSerialTimerInterval)
+    Q_PROPERTY(int statusInterval READ statusInterval WRITE setStatusInterval)
+    Q_PROPERTY(QVariantMap machineStatus READ machineStatus NOTIFY machineStatusChanged)
     Q_PROPERTY(QStringList serialPorts READ serialPorts NOTIFY portsChanged)
     Q_PROPERTY(QStringList portSpeeds READ portSpeeds)
     Q_PROPERTY(QString connectedPort READ connectedPort)
@@ -98,6 +106,7 @@ public:
      * @param parent: parent of the object
      */
     explicit AtCore(QObject *parent = nullptr);
+    ~AtCore() override;
 
     /**
      * @brief version
@@ -167,6 +176,9 @@ public:
 
     /**
      * @brief Attempt to autodetect the firmware of connect serial device
+     *
+     * Capabilities in the firmware's M115 reply are read into IFirmware::capabilities()
+     * and the fastest supported features are used, ex AUTOREPORT_TEMP replaces M105 polling.
      * @sa loadFirmwarePlugin(),availableFirmwarePlugins(),firmwarePlugin()
      */
     Q_INVOKABLE void detectFirmware();
@@ -184,26 +196,120 @@ public:
      */
     int extruderCount() const;
 
+    /**
+     * @brief Number of commands waiting in the command queue, not sent yet
+     */
+    int commandQueueSize() const;
+
     /**
      * @brief Return printed percentage
-     * @sa printProgressChanged()
+     *
+     * Estimated time of the commands sent over the estimated time of the job.
+     * @sa printProgressChanged(),printTimeLeft()
      */
     float percentagePrinted() const;
 
+    /**
+     * @brief Layer being printed, 0 before the first layer
+     * @sa printLayerCount(),printProgressChanged()
+     */
+    int printLayer() const;
+
+    /**
+     * @brief Number of layers of the print job
+     * @sa printLayer()
+     */
+    int printLayerCount() const;
+
+    /**
+     * @brief Estimated milliseconds left of the print job, heating not included
+     * @sa percentagePrinted(),printProgressChanged()
+     */
+    qint64 printTimeLeft() const;
+
     /**
      * @brief The temperature of the current hotend as told by the Firmware.
      */
     Temperature &temperature() const;
 
+    /**
+     * @brief Push a command into the command queue and call \p done once the printer acknowledged it
+     *
+     * \p done gets the lines received between sending the command and its acknowledge,
+     * it is called from the event loop of AtCore. The command is not coalesced with
+     * other commands. See AtCoreCoroutines for co_await support.
+     * If the command is dropped, by stop() or a firmware reset, \p done is called with aborted set.
+     * @param comm : Command
+     * @param done : called with the reply of the command
+     * @sa pushCommand(const QString &)
+     */
+    void pushCommand(const QString &comm, const std::function<void(const QStringList &reply, bool aborted)> &done);
+
+    /**
+     * @brief Push a command answering with data, ex M114 or M503, into the command queue
+     *
+     * The returned CommandReply collects the lines received for this command only
+     * and emits CommandReply::finished() once the printer acknowledged it.
+     * @param comm : Command
+     * @return reply of the command, delete it with deleteLater() when done
+     * @sa pushCommand()
+     */
+    Q_INVOKABLE CommandReply *request(const QString &comm);
+
+    /**
+     * @brief Push a batch of commands into the command queue in one go
+     *
+     * The commands are queued as they are and in order, they are neither
+     * coalesced nor checked for realtime commands.
+     * @param commands : Commands, already encoded
+     * @return reply of the last command, finished once the whole batch was acknowledged.
+     * Delete it with deleteLater() when done
+     * @sa pushCommand(),request()
+     */
+    CommandReply *pushCommands(const QList<QByteArray> &commands);
+
     /**
     * @brief Return the amount of miliseconds the serialTimer is set to. 0 = Disabled
     */
     quint16 serialTimerInterval() const;
 
+    /**
+     * @brief Return the amount of miliseconds between status queries. 0 = Disabled
+     * @sa setStatusInterval()
+     */
+    int statusInterval() const;
+
+    /**
+     * @brief Last status reported by the firmware
+     * @sa machineStatusChanged(), IFirmware::statusReported()
+     */
+    QVariantMap machineStatus() const;
+
+    /**
+     * @brief State, temperatures, position, progress, queue and counters read at once
+     *
+     * Published on every change without locking, safe to call from any thread
+     * and cheap enough to poll at high rates.
+     * @sa exportSnapshot()
+     */
+    AtCoreProtocol::PrinterSnapshot snapshot() const;
+
+    /**
+     * @brief Also publish snapshot() to the shared memory segment \p key
+     *
+     * Other processes read it with SharedSnapshot::attach().
+     * @param key: name of the segment, empty to stop exporting
+     * @return False if the segment could not be created
+     */
+    bool exportSnapshot(const QString &key);
+
 signals:
 
     /**
      * @brief Print job's precentage changed.
+     *
+     * Emitted when the progress moved by 0.1% or the layer changed,
+     * printLayer() and printTimeLeft() are updated along.
      * @param newProgress : Message
      * @sa percentagePrinted()
      */
@@ -227,6 +333,38 @@ signals:
      */
     void portsChanged(QStringList);
 
+    /**
+     * @brief The start of a print job was optimized
+     *
+     * This is an upper bound of the time saved, not the saving itself: heaters that
+     * reached their target before homing finished would not have made the printer wait that long.
+     * @param msecs : time homing and probing ran while heating
+     * @sa setJobStartOptimization()
+     */
+    void jobStartOverlap(qint64 msecs);
+
+    /**
+     * @brief A print job could not be started or read to its end
+     * @param error : description of the error
+     * @sa print()
+     */
+    void printError(const QString &error);
+
+    /**
+     * @brief A command was dropped, it is longer than the firmware accepts
+     * Lines of a print job are not dropped: the job fails with printError() instead.
+     * @param command : the command
+     * @sa IFirmware::maxLineLength()
+     */
+    void commandRejected(const QString &command);
+
+    /**
+     * @brief The firmware reported a new status
+     * @param status : state of the machine, see IFirmware::statusReported()
+     * @sa machineStatus()
+     */
+    void machineStatusChanged(const QVariantMap &status);
+
 public slots:
 
     /**
@@ -239,16 +377,54 @@ public slots:
     /**
      * @brief Push a command into the command queue
      *
+     * Realtime commands (see IFirmware::isRealtimeCommand()) skip the queue
+     * and are written to the device at once. Jogs and setpoints are coalesced
+     * with pending ones, see AtCoreProtocol::CommandQueue.
      * @param comm : Command
      */
     void pushCommand(const QString &comm);
 
     /**
      * @brief Public Interface for printing a file
-     * @param fileName: the gcode file to print.
+     *
+     * Ignored unless the port is open and a firmware plugin loaded.
+     * If the file can not be read, or is compressed in a format AtCore was built without,
+     * printError() is emitted and the state goes back to IDLE. A compressed file that fails
+     * to decompress midway emits printError() and ends in ERRORSTATE once the lines
+     * decompressed before the error were sent.
+     * @param fileName: the gcode file to print, it may be gzip or zstd compressed.
      */
     void print(const QString &fileName);
 
+    /**
+     * @brief Print a job read from \p device
+     *
+     * Sequential devices (QProcess, sockets, ...) are printed while the job arrives: lines are
+     * read only as they are sent, the job waits for the ones not received yet and ends once
+     * \p device emits readChannelFinished() or is closed. Limit the read buffer of sockets
+     * (QAbstractSocket::setReadBufferSize()) to hold the sender back.
+     * The size of such jobs is unknown, percentagePrinted() and printTimeLeft() stay at -1
+     * and printLayerCount() counts the layers received so far.
+     * Ignored, and \p device deleted, unless the port is open and a firmware plugin loaded.
+     * @param device: device to read the job from, AtCore takes it over and moves it to the print thread.
+     * It is opened read only if it is not open and deleted when the job ends. If it can not be opened
+     * printError() is emitted, the state goes back to IDLE and it is deleted.
+     * @sa GCodeSource for jobs made by code
+     */
+    void print(QIODevice *device);
+
+    /**
+     * @brief Overlap heating with homing and probing at the start of print jobs
+     *
+     * Bed and hotend targets are set at once, the waits for them are moved down to
+     * the first extrusion. See AtCoreProtocol::optimizeJobStart() for the safety rules.
+     * Disabled by default, applies to the next print().
+     * @param enabled : rewrite the start of print jobs
+     * @param hotProbe : the probe needs a hot nozzle, wait for the hotend before probing
+     * @sa jobStartOverlap()
+     */
+    void setJobStartOptimization(bool enabled, bool hotProbe = false);
+
     /**
      * @brief Stop the Printer by empting the queue and aborting the print job (if running)
      * @sa emergencyStop(),pause(),resume()
@@ -257,6 +433,12 @@ public slots:
 
     /**
      * @brief stop the printer via the emergency stop Command (M112)
+     *
+     * The queue and all output not yet sent are discarded and M112 is
+     * written ahead of everything else. Firmwares with a reset command
+     * (see IFirmware::resetCommand()) are reset instead. Grbl reset in motion
+     * raises an alarm: the state goes to ERRORSTATE until it is homed ($H)
+     * or unlocked ($X), see machineStatusChanged().
      * @sa stop(),pause(),resume()
      */
     void emergencyStop();
@@ -265,7 +447,9 @@ public slots:
      * @brief pause an in process print job
      *
      * Sends M114 on pause to store the location where the head stoped.
-     * This is known to cause problems on fake printers
+     * This is known to cause problems on fake printers.
+     * Firmwares with a feed hold (see IFirmware::feedHoldCommand()) stop at once
+     * and keep their position, \p pauseActions are not used then.
      * @param pauseActions: Gcode to run after pausing commands are ',' separated
      * @sa resume(),stop(),emergencyStop()
      */
@@ -273,7 +457,9 @@ public slots:
 
     /**
      * @brief resume a paused print job.
-     * After returning to location pause was triggered.
+     * After returning to location pause was triggered,
+     * or by ending the feed hold of the firmware. The print job goes on
+     * once the state is back to BUSY.
      * @sa pause(),stop(),emergencyStop()
      */
     void resume();
@@ -378,6 +564,21 @@ public slots:
      */
     void setSerialTimerInterval(const quint16 &newTime);
 
+    /**
+     * @brief Set the time between status queries of firmwares having one (200 is default)
+     *
+     * Queries are bytes written outside the command queue (see IFirmware::statusQuery()),
+     * they take no room from the commands streamed.
+     * @param msecs: Milliseconds between queries, bound to 50 - 200 (20 - 5 Hz). 0 will Disable queries.
+     */
+    void setStatusInterval(int msecs);
+
+protected:
+    /**
+     * @brief Move the periodic timers along with AtCore on QEvent::ThreadChange
+     */
+    bool event(QEvent *e) override;
+
 private slots:
     /**
      * @brief processQueue send commands from the queue.
@@ -385,10 +586,40 @@ private slots:
     void processQueue();
 
     /**
-     * @brief Send M105 to the printer if one is not in the Queue
+     * @brief Queue a line of the print job
+     * The print worker is told once the printer acknowledged it, or it was dropped.
+     * Connect to PrintThread::nextCommand
+     * @param comm: Command
+     */
+    void pushJobCommand(const QString &comm);
+
+    /**
+     * @brief Store the progress of the print job and emit printProgressChanged()
+     * @param progress: percent printed
+     * @param layer: layer being printed
+     * @param layerCount: layers of the job
+     * @param timeLeft: estimated milliseconds left
+     */
+    void updatePrintProgress(float progress, int layer, int layerCount, qint64 timeLeft);
+
+    /**
+     * @brief Send M105, or the status command of the firmware, to the printer if one is not in the Queue
+     * @sa IFirmware::statusCommand()
      */
     void checkTemperature();
 
+    /**
+     * @brief Write the status query of the firmware
+     */
+    void checkStatus();
+
+    /**
+     * @brief Store \p status and emit machineStatusChanged()
+     * Connect to IFirmware::statusReported
+     * @param status: status reported by the firmware
+     */
+    void updateMachineStatus(const QVariantMap &status);
+
     /**
      * @brief Connect to SerialLayer::receivedCommand
      * @param message: new message.
@@ -407,17 +638,57 @@ private slots:
      */
     void locateSerialPort();
 
+    /**
+     * @brief Switch to faster protocol features the firmware supports
+     * Connect to IFirmware::capabilityFound
+     * @param capability: capability reported by the firmware
+     */
+    void enableCapability(const QString &capability);
+
+    /**
+     * @brief Start again, on the service of the current thread, the timers stopped by a thread change
+     */
+    void restartPeriodic();
+
 private:
     /**
      * @brief True if a firmware plugin is loaded
      */
     bool firmwarePluginLoaded() const;
 
+    /**
+     * @brief Get the print worker ready for a new job
+     * @return false if no job can be started now
+     */
+    bool preparePrint();
+
     /**
      * @brief True if a serial port is initialized
      */
     bool serialInitialized() const;
 
+    /**
+     * @brief Write a realtime command to the device, bypassing the queue
+     * @param comm: Command
+     */
+    void pushRealtimeCommand(const QString &comm);
+
+    /**
+     * @brief Publish the current state to snapshot() and the exported segment
+     */
+    void publishSnapshot();
+
+    /**
+     * @brief Run \p function every \p msecs from the calling thread's TimerService, restarting \p timer if running
+     * @param timer: timer, replaced by the new one
+     */
+    void startPeriodic(AtCoreTimer &timer, int msecs, void (AtCore::*function)());
+
+    /**
+     * @brief Stop \p timer on the service running it, if running, and clear it
+     */
+    void stopPeriodic(AtCoreTimer &timer);
+
     /**
      * @brief send firmware request to the printer
      */
@@ -0,0 +1,73 @@
+/* AtCore
+   Copyright (C) <2026>
+
+   Authors:
+       The AtCore contributors
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+/*
+ * co_await support for AtCore, only available to code built with C++20 coroutines.
+ * Everything here is inline, AtCore itself does not need coroutines.
+ *
+ * AtCoreProtocol::Routine calibrate(AtCore &core)
+ * {
+ *     if (!co_await AtCoreProtocol::send(core, QStringLiteral("G28"))) {
+ *         co_return; // stopped before homing finished
+ *     }
+ *     const QStringList position = (co_await AtCoreProtocol::query(core, QStringLiteral("M114"))).lines;
+ * }
+ */
+#if defined(__cpp_impl_coroutine)
+
+#include <QStringList>
+
+#include "atcore.h"
+#include "protocol/coroutine.h"
+
+namespace AtCoreProtocol
+{
+/**
+ * @brief Send \p command, co_await returns once the printer acknowledged it
+ *
+ * The coroutine is resumed from the event loop of \p core.
+ * @param core: AtCore of the printer
+ * @param command: Command to send
+ * @return awaiter resolving to the reply
+ */
+inline ReplyAwaiter<QStringList> send(AtCore &core, const QString &command)
+{
+    return ReplyAwaiter<QStringList>([&core, command](std::function<void(const QStringList &, bool)> done) {
+        core.pushCommand(command, done);
+    });
+}
+
+/**
+ * @brief Send a command answering with data, ex M114, co_await returns the reply lines
+ * @param core: AtCore of the printer
+ * @param command: Command to send
+ * @return awaiter resolving to the reply
+ */
+inline ReplyAwaiter<QStringList> query(AtCore &core, const QString &command)
+{
+    return send(core, command);
+}
+}
+
+#endif
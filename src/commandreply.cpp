@@ -0,0 +1,78 @@
+/* AtCore
+   Copyright (C) <2026>
+
+   Authors:
+       The AtCore contributors
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "commandreply.h"
+
+/**
+ * @brief The CommandReplyPrivate class
+ */
+class CommandReplyPrivate
+{
+public:
+    QString command;        //!< @param command: the command sent
+    QStringList lines;      //!< @param lines: lines of the reply
+    bool finished = false;  //!< @param finished: true once the command was acknowledged or dropped
+    bool aborted = false;   //!< @param aborted: true if the command was dropped
+};
+
+CommandReply::CommandReply(const QString &command, QObject *parent) :
+    QObject(parent),
+    d(new CommandReplyPrivate)
+{
+    d->command = command;
+}
+
+CommandReply::~CommandReply()
+{
+    delete d;
+}
+
+QString CommandReply::command() const
+{
+    return d->command;
+}
+
+QStringList CommandReply::lines() const
+{
+    return d->lines;
+}
+
+bool CommandReply::isFinished() const
+{
+    return d->finished;
+}
+
+bool CommandReply::isAborted() const
+{
+    return d->aborted;
+}
+
+void CommandReply::setFinished(const QStringList &lines, bool aborted)
+{
+    d->lines = lines;
+    d->finished = true;
+    d->aborted = aborted;
+    if (aborted) {
+        emit this->aborted();
+    }
+    emit finished();
+}
@@ -0,0 +1,106 @@
+/* AtCore
+   Copyright (C) <2026>
+
+   Authors:
+       The AtCore contributors
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <QObject>
+#include <QStringList>
+
+#include "atcore_export.h"
+
+class AtCore;
+class CommandReplyPrivate;
+/**
+ * @brief The CommandReply class
+ * Reply of the printer to one command
+ *
+ * Holds the lines received between sending the command and its "ok".
+ * Lines nobody asked for, like auto reported temperatures or busy
+ * notices, are left out. If the command is dropped before the printer
+ * acknowledged it, ex by AtCore::stop(), aborted() is emitted before finished().
+ * AtCore creates it, delete it with deleteLater() once you are done with it.
+ * @sa AtCore::request()
+ */
+class ATCORE_EXPORT CommandReply : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(QString command READ command CONSTANT)
+    Q_PROPERTY(QStringList lines READ lines NOTIFY finished)
+    Q_PROPERTY(bool finished READ isFinished NOTIFY finished)
+    Q_PROPERTY(bool aborted READ isAborted NOTIFY finished)
+
+public:
+    ~CommandReply() override;
+
+    /**
+     * @brief The command this is the reply to
+     */
+    QString command() const;
+
+    /**
+     * @brief Lines of the reply, empty until finished
+     */
+    QStringList lines() const;
+
+    /**
+     * @brief True once the printer acknowledged the command or it was dropped
+     */
+    bool isFinished() const;
+
+    /**
+     * @brief True if the command was dropped before the printer acknowledged it
+     */
+    bool isAborted() const;
+
+signals:
+    /**
+     * @brief The printer acknowledged the command, lines() is complete, or it was dropped
+     * @sa isAborted()
+     */
+    void finished();
+
+    /**
+     * @brief The command was dropped before the printer acknowledged it
+     *
+     * lines() holds what was received so far. finished() follows.
+     */
+    void aborted();
+
+private:
+    friend class AtCore;
+
+    /**
+     * @brief Create a new CommandReply
+     * @param command: the command sent
+     * @param parent: parent of this object
+     */
+    CommandReply(const QString &command, QObject *parent);
+
+    /**
+     * @brief Store the reply and emit finished()
+     * @param lines: lines of the reply
+     * @param aborted: the command was dropped, emit aborted() first
+     */
+    void setFinished(const QStringList &lines, bool aborted = false);
+
+    CommandReplyPrivate *d;
+};
@@ -0,0 +1,552 @@
+/* AtCore
+   Copyright (C) <2026>
+
+   Authors:
+       The AtCore contributors
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <QFile>
+#include <QLoggingCategory>
+#include <QMetaObject>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QQueue>
+#include <QThread>
+#include <QWaitCondition>
+
+#include <climits>
+#include <cstring>
+#include <memory>
+
+#ifdef ATCORE_HAVE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef ATCORE_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+#include "compressedjob.h"
+
+Q_LOGGING_CATEGORY(COMPRESSED_JOB, "org.kde.atelier.core.compressedJob")
+
+namespace
+{
+const int _chunkSize = 64 * 1024;       //Bytes read from the file, and decompressed, at once
+const qint64 _readAhead = 1024 * 1024;  //Decompressed bytes kept ahead of the reader
+
+/**
+ * @brief Decompresses one format, a step at a time
+ */
+class Decoder
+{
+public:
+    virtual ~Decoder()
+    {
+    }
+
+    /**
+     * @brief Decompress from \p in up to one chunk into \p out
+     * @param in: next compressed byte, moved past the bytes used
+     * @param inEnd: end of the compressed bytes
+     * @param out: set to the decompressed bytes, may be empty
+     * @return false if the data is corrupt, see error
+     */
+    virtual bool decode(const char *&in, const char *inEnd, QByteArray &out) = 0;
+
+    /**
+     * @brief True if the data so far ended with a whole stream
+     */
+    virtual bool complete() const = 0;
+
+    QString error;  //!< @param error: why decode() failed
+};
+
+#ifdef ATCORE_HAVE_ZLIB
+/**
+ * @brief gzip decoder, files of several members are read whole
+ */
+class GzipDecoder : public Decoder
+{
+public:
+    GzipDecoder()
+    {
+        std::memset(&m_stream, 0, sizeof(m_stream));
+        //15 + 32: largest window, gzip or zlib header
+        inflateInit2(&m_stream, 15 + 32);
+    }
+
+    ~GzipDecoder() override
+    {
+        inflateEnd(&m_stream);
+    }
+
+    bool decode(const char *&in, const char *inEnd, QByteArray &out) override
+    {
+        if (m_ended && in != inEnd) {
+            //Another member follows.
+            inflateReset(&m_stream);
+            m_ended = false;
+        }
+        out.resize(_chunkSize);
+        m_stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(in));
+        m_stream.avail_in = uInt(inEnd - in);
+        m_stream.next_out = reinterpret_cast<Bytef *>(out.data());
+        m_stream.avail_out = uInt(out.size());
+        const int result = inflate(&m_stream, Z_NO_FLUSH);
+        in = reinterpret_cast<const char *>(m_stream.next_in);
+        out.resize(out.size() - int(m_stream.avail_out));
+        if (result == Z_STREAM_END) {
+            m_ended = true;
+            return true;
+        }
+        if (result == Z_OK || result == Z_BUF_ERROR) {
+            return true;
+        }
+        error = m_stream.msg ? QString::fromLatin1(m_stream.msg) : QStringLiteral("zlib error %1").arg(result);
+        return false;
+    }
+
+    bool complete() const override
+    {
+        return m_ended;
+    }
+
+private:
+    z_stream m_stream;
+    bool m_ended = false;
+};
+#endif
+
+#ifdef ATCORE_HAVE_ZSTD
+/**
+ * @brief Zstandard decoder, files of several frames are read whole
+ */
+class ZstdDecoder : public Decoder
+{
+public:
+    ZstdDecoder()
+        : m_stream(ZSTD_createDStream())
+    {
+        ZSTD_initDStream(m_stream);
+    }
+
+    ~ZstdDecoder() override
+    {
+        ZSTD_freeDStream(m_stream);
+    }
+
+    bool decode(const char *&in, const char *inEnd, QByteArray &out) override
+    {
+        out.resize(_chunkSize);
+        ZSTD_inBuffer input = {in, std::size_t(inEnd - in), 0};
+        ZSTD_outBuffer output = {out.data(), std::size_t(out.size()), 0};
+        const std::size_t result = ZSTD_decompressStream(m_stream, &output, &input);
+        if (ZSTD_isError(result)) {
+            out.clear();
+            error = QString::fromLatin1(ZSTD_getErrorName(result));
+            return false;
+        }
+        in += input.pos;
+        out.resize(int(output.pos));
+        //0 once a frame is done and flushed.
+        m_ended = result == 0;
+        return true;
+    }
+
+    bool complete() const override
+    {
+        return m_ended;
+    }
+
+private:
+    ZSTD_DStream *m_stream;
+    bool m_ended = false;
+};
+#endif
+}
+
+/**
+ * @brief Decompressed bytes and where they end in the compressed file
+ */
+struct CompressedChunk {
+    QByteArray data;            //!< @param data: decompressed bytes
+    qint64 compressedEnd;       //!< @param compressedEnd: compressed bytes used once data is read
+};
+
+/**
+ * @brief The CompressedJobPrivate class
+ */
+class CompressedJobPrivate
+{
+public:
+    /**
+     * @brief Decompress the file into chunks, run by the worker thread
+     */
+    void decompress();
+
+    /**
+     * @brief Queue a chunk, waiting for the reader to catch up first
+     * @return false if the worker has to stop
+     */
+    bool push(const QByteArray &data, qint64 compressedEnd);
+
+    /**
+     * @brief Queue CompressedJob::dataArrived once, call locked
+     */
+    void notify();
+
+    CompressedJob *q = nullptr;         //!< @param q: the job
+    QFile file;                         //!< @param file: compressed file, read by the worker
+    qint64 compressedSize = 0;          //!< @param compressedSize: size of file
+    qint64 position = 0;                //!< @param position: compressed bytes behind the data read
+    std::unique_ptr<Decoder> decoder;   //!< @param decoder: decoder for the format of file
+    QThread *worker = nullptr;          //!< @param worker: thread running decompress()
+    bool finishReported = false;        //!< @param finishReported: readChannelFinished was emitted
+
+    QMutex mutex;                       //!< @param mutex: guards the members below
+    QWaitCondition dataReady;           //!< @param dataReady: a chunk was queued or the worker finished
+    QWaitCondition spaceFree;           //!< @param spaceFree: the reader took data or the worker has to stop
+    QQueue<CompressedChunk> chunks;     //!< @param chunks: decompressed, not read yet
+    int offset = 0;                     //!< @param offset: bytes of the first chunk already read
+    qint64 pending = 0;                 //!< @param pending: bytes in chunks not read yet
+    bool stop = false;                  //!< @param stop: the worker has to stop
+    bool finished = false;              //!< @param finished: the worker is done, no chunk will follow
+    bool notified = false;              //!< @param notified: dataArrived is queued
+    QString error;                      //!< @param error: why the file could not be decompressed to its end
+};
+
+/**
+ * @brief Thread running CompressedJobPrivate::decompress
+ */
+class CompressedJobWorker : public QThread
+{
+public:
+    explicit CompressedJobWorker(CompressedJobPrivate *job)
+        : m_job(job)
+    {
+    }
+
+protected:
+    void run() override
+    {
+        m_job->decompress();
+    }
+
+private:
+    CompressedJobPrivate *m_job;
+};
+
+void CompressedJobPrivate::decompress()
+{
+    QByteArray input;
+    const char *in = nullptr;
+    const char *inEnd = nullptr;
+    bool eof = false;
+    QString failure;
+
+    while (true) {
+        if (in == inEnd && !eof) {
+            input = file.read(_chunkSize);
+            eof = input.isEmpty();
+            in = input.constData();
+            inEnd = in + input.size();
+        }
+        const char *before = in;
+        QByteArray out;
+        if (!decoder->decode(in, inEnd, out)) {
+            failure = decoder->error;
+            break;
+        }
+        const qint64 used = file.pos() - (inEnd - in);
+        if (!out.isEmpty()) {
+            if (!push(out, used)) {
+                break;
+            }
+            continue;
+        }
+        if (in != before) {
+            continue;
+        }
+        if (in != inEnd) {
+            failure = QStringLiteral("Decompression stalled");
+            break;
+        }
+        if (eof) {
+            if (!decoder->complete()) {
+                failure = QStringLiteral("Compressed file ends unexpectedly");
+            }
+            break;
+        }
+    }
+
+    QMutexLocker lock(&mutex);
+    if (!failure.isEmpty() && !stop) {
+        qCWarning(COMPRESSED_JOB) << "Unable to decompress" << file.fileName() << failure;
+        error = failure;
+    }
+    finished = true;
+    dataReady.wakeAll();
+    notify();
+}
+
+bool CompressedJobPrivate::push(const QByteArray &data, qint64 compressedEnd)
+{
+    QMutexLocker lock(&mutex);
+    while (pending >= _readAhead && !stop) {
+        spaceFree.wait(&mutex);
+    }
+    if (stop) {
+        return false;
+    }
+    chunks.enqueue(CompressedChunk{data, compressedEnd});
+    pending += data.size();
+    dataReady.wakeAll();
+    notify();
+    return true;
+}
+
+void CompressedJobPrivate::notify()
+{
+    if (!notified) {
+        notified = true;
+        QMetaObject::invokeMethod(q, "dataArrived", Qt::QueuedConnection);
+    }
+}
+
+CompressedJob::Format CompressedJob::detect(const QString &fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return None;
+    }
+    const QByteArray magic = file.read(4);
+    if (magic.startsWith("\x1f\x8b")) {
+        return Gzip;
+    }
+    if (magic == QByteArray("\x28\xb5\x2f\xfd", 4)) {
+        return Zstd;
+    }
+    return None;
+}
+
+bool CompressedJob::isSupported(Format format)
+{
+    switch (format) {
+#ifdef ATCORE_HAVE_ZLIB
+    case Gzip:
+        return true;
+#endif
+#ifdef ATCORE_HAVE_ZSTD
+    case Zstd:
+        return true;
+#endif
+    default:
+        return false;
+    }
+}
+
+CompressedJob::CompressedJob(const QString &fileName, QObject *parent) :
+    QIODevice(parent),
+    d(new CompressedJobPrivate)
+{
+    d->q = this;
+    d->file.setFileName(fileName);
+}
+
+CompressedJob::~CompressedJob()
+{
+    stopWorker();
+    delete d;
+}
+
+bool CompressedJob::open(OpenMode mode)
+{
+    if (mode & WriteOnly) {
+        setErrorString(tr("CompressedJob is read only"));
+        return false;
+    }
+    const Format format = detect(d->file.fileName());
+    switch (format) {
+#ifdef ATCORE_HAVE_ZLIB
+    case Gzip:
+        d->decoder.reset(new GzipDecoder);
+        break;
+#endif
+#ifdef ATCORE_HAVE_ZSTD
+    case Zstd:
+        d->decoder.reset(new ZstdDecoder);
+        break;
+#endif
+    default:
+        setErrorString(format == None ? tr("%1 is not compressed").arg(d->file.fileName())
+                       : tr("AtCore was built without support for the compression of %1").arg(d->file.fileName()));
+        return false;
+    }
+    if (!d->file.open(QIODevice::ReadOnly)) {
+        setErrorString(d->file.errorString());
+        return false;
+    }
+    d->compressedSize = d->file.size();
+    d->position = 0;
+    d->chunks.clear();
+    d->offset = 0;
+    d->pending = 0;
+    d->stop = false;
+    d->finished = false;
+    d->notified = false;
+    d->finishReported = false;
+    d->error.clear();
+
+    if (!QIODevice::open(mode)) {
+        d->file.close();
+        return false;
+    }
+    d->worker = new CompressedJobWorker(d);
+    d->worker->start();
+    qCDebug(COMPRESSED_JOB) << "Decompressing" << d->file.fileName() << d->compressedSize << "bytes";
+    return true;
+}
+
+void CompressedJob::close()
+{
+    stopWorker();
+    d->file.close();
+    QIODevice::close();
+}
+
+bool CompressedJob::isSequential() const
+{
+    return true;
+}
+
+qint64 CompressedJob::bytesAvailable() const
+{
+    QMutexLocker lock(&d->mutex);
+    return d->pending + QIODevice::bytesAvailable();
+}
+
+bool CompressedJob::canReadLine() const
+{
+    if (QIODevice::canReadLine()) {
+        return true;
+    }
+    QMutexLocker lock(&d->mutex);
+    for (int i = 0; i < d->chunks.size(); ++i) {
+        if (d->chunks.at(i).data.indexOf('\n', i == 0 ? d->offset : 0) != -1) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool CompressedJob::atEnd() const
+{
+    QMutexLocker lock(&d->mutex);
+    return QIODevice::bytesAvailable() == 0 && d->pending == 0 && (d->finished || !isOpen());
+}
+
+bool CompressedJob::waitForReadyRead(int msecs)
+{
+    QMutexLocker lock(&d->mutex);
+    while (d->pending == 0 && !d->finished && d->worker) {
+        if (!d->dataReady.wait(&d->mutex, msecs < 0 ? ULONG_MAX : ulong(msecs))) {
+            break;
+        }
+    }
+    return d->pending > 0;
+}
+
+bool CompressedJob::hasError() const
+{
+    QMutexLocker lock(&d->mutex);
+    return !d->error.isEmpty();
+}
+
+qint64 CompressedJob::compressedSize() const
+{
+    return d->compressedSize;
+}
+
+qint64 CompressedJob::compressedPosition() const
+{
+    return d->position;
+}
+
+qint64 CompressedJob::readData(char *data, qint64 maxSize)
+{
+    QMutexLocker lock(&d->mutex);
+    qint64 read = 0;
+    while (read < maxSize && !d->chunks.isEmpty()) {
+        const CompressedChunk &chunk = d->chunks.head();
+        const int size = int(qMin(maxSize - read, qint64(chunk.data.size() - d->offset)));
+        std::memcpy(data + read, chunk.data.constData() + d->offset, std::size_t(size));
+        read += size;
+        d->offset += size;
+        if (d->offset == chunk.data.size()) {
+            d->position = chunk.compressedEnd;
+            d->offset = 0;
+            d->chunks.dequeue();
+        }
+    }
+    d->pending -= read;
+    if (read > 0) {
+        d->spaceFree.wakeAll();
+        return read;
+    }
+    return d->finished ? -1 : 0;
+}
+
+qint64 CompressedJob::writeData(const char *data, qint64 maxSize)
+{
+    Q_UNUSED(data);
+    Q_UNUSED(maxSize);
+    return -1;
+}
+
+void CompressedJob::dataArrived()
+{
+    bool finished = false;
+    {
+        QMutexLocker lock(&d->mutex);
+        d->notified = false;
+        finished = d->finished;
+        if (!d->error.isEmpty()) {
+            setErrorString(d->error);
+        }
+    }
+    emit readyRead();
+    if (finished && !d->finishReported) {
+        d->finishReported = true;
+        emit readChannelFinished();
+    }
+}
+
+void CompressedJob::stopWorker()
+{
+    if (!d->worker) {
+        return;
+    }
+    {
+        QMutexLocker lock(&d->mutex);
+        d->stop = true;
+        d->spaceFree.wakeAll();
+    }
+    d->worker->wait();
+    delete d->worker;
+    d->worker = nullptr;
+}
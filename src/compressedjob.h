@@ -0,0 +1,141 @@
+/* AtCore
+   Copyright (C) <2026>
+
+   Authors:
+       The AtCore contributors
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <QIODevice>
+#include <QString>
+
+#include "atcore_export.h"
+
+class CompressedJobPrivate;
+
+/**
+ * @brief The CompressedJob class
+ * Gcode job read from a gzip or zstd compressed file, decompressed while it is printed
+ *
+ * A worker thread decompresses the file a chunk at a time, a little ahead of
+ * the reader, so the job is never written to disk and never held whole in memory.
+ * The decompressed size is unknown until the end: compressedPosition() over
+ * compressedSize() tells how much of the job was read.
+ * PrintThread prints compressed files given to AtCore::print() through it.
+ */
+class ATCORE_EXPORT CompressedJob : public QIODevice
+{
+    Q_OBJECT
+public:
+    /**
+     * @brief Compression of a file
+     */
+    enum Format {
+        None = 0,   /*!< Not compressed, or not in a known format */
+        Gzip,       /*!< gzip, .gz */
+        Zstd,       /*!< Zstandard, .zst */
+    };
+
+    /**
+     * @brief Compression of \p fileName, from its first bytes
+     */
+    static Format detect(const QString &fileName);
+
+    /**
+     * @brief True if AtCore was built with support for \p format
+     */
+    static bool isSupported(Format format);
+
+    /**
+     * @brief Create a new CompressedJob
+     * @param fileName: compressed gcode file
+     * @param parent: parent of this object
+     */
+    explicit CompressedJob(const QString &fileName, QObject *parent = nullptr);
+    ~CompressedJob() override;
+
+    /**
+     * @brief Open the file and start decompressing, only QIODevice::ReadOnly is supported
+     */
+    bool open(OpenMode mode) override;
+
+    /**
+     * @brief Stop decompressing and close the file
+     */
+    void close() override;
+
+    /**
+     * @brief The job is decompressed as it is read, it can not seek
+     */
+    bool isSequential() const override;
+
+    /**
+     * @brief Bytes decompressed and not read yet
+     */
+    qint64 bytesAvailable() const override;
+
+    /**
+     * @brief True if a whole line was decompressed and not read yet
+     */
+    bool canReadLine() const override;
+
+    /**
+     * @brief True once the whole file was decompressed and read
+     */
+    bool atEnd() const override;
+
+    /**
+     * @brief Wait up to \p msecs for decompressed data
+     * @return true if data can be read
+     */
+    bool waitForReadyRead(int msecs) override;
+
+    /**
+     * @brief True if the file could not be decompressed to its end, see errorString()
+     */
+    bool hasError() const;
+
+    /**
+     * @brief Size of the compressed file
+     */
+    qint64 compressedSize() const;
+
+    /**
+     * @brief Bytes of the compressed file behind the data read so far
+     */
+    qint64 compressedPosition() const;
+
+protected:
+    qint64 readData(char *data, qint64 maxSize) override;
+    qint64 writeData(const char *data, qint64 maxSize) override;
+
+private slots:
+    /**
+     * @brief Tell readers about the data decompressed, queued by the worker
+     */
+    void dataArrived();
+
+private:
+    /**
+     * @brief Stop the worker thread and wait for it
+     */
+    void stopWorker();
+
+    CompressedJobPrivate *d;
+};
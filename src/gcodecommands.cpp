@@ -259,6 +259,8 @@ QString GCode::toString(MCommands gcode)
         return QObject::tr("M144: Stand by your bed");
     case M150://Marlin
         return QObject::tr("M150: Set display color");
+    case M155://Marlin
+        return QObject::tr("M155: Automatically send temperatures");
     case M163://Repetier > 0.92
         return QObject::tr("M163: Set weight of mixed material");
     case M164://Repetier > 0.92
@@ -560,6 +562,12 @@ QString GCode::toCommand(MCommands gcode, const QString &value1, const QString &
         }
         return QObject::tr("ERROR! M140: It's obligatory to have an argument");
     }
+    case M155: {
+        if (!value1.isEmpty()) {
+            return QStringLiteral("M155 S%1").arg(value1);
+        }
+        return QObject::tr("ERROR! M155: It's obligatory to have an argument");
+    }
     case M190: {
         if (!value1.isEmpty()) {
             return QStringLiteral("M190 S%1").arg(value1);
@@ -578,6 +586,12 @@ QString GCode::toCommand(MCommands gcode, const QString &value1, const QString &
         }
         return QObject::tr("ERROR! M221: It's obligatory to have an argument");
     }
+    case M408: {
+        if (!value1.isEmpty()) {
+            return QStringLiteral("M408 S%1").arg(value1);
+        }
+        return QStringLiteral("M408");
+    }
     default:
         return QObject::tr("Not supported or implemented!");
     }
@@ -69,7 +69,7 @@ public:
         M120, M121, M122, M123, M124, M126, M127, M128, M129,
         M130, M131, M132, M133, M134, M135, M136,
         M140, M141, M142, M143, M144, M146, M149,
-        M150,
+        M150, M155,
         M160, M163, M164,
         M190, M191,
         M200, M201, M202, M203, M204, M205, M206, M207, M208, M209,
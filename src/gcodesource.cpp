@@ -0,0 +1,120 @@
+/* AtCore
+   Copyright (C) <2026>
+
+   Authors:
+       The AtCore contributors
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <QMetaObject>
+
+#include <cstring>
+
+#include "gcodesource.h"
+
+/**
+ * @brief The GCodeSourcePrivate class
+ */
+class GCodeSourcePrivate
+{
+public:
+    GCodeSource::Generator generator;   //!< @param generator: makes the next commands
+    QByteArray batch;                   //!< @param batch: commands made but not read yet
+    bool done = false;                  //!< @param done: the generator returned no command
+};
+
+GCodeSource::GCodeSource(const Generator &generator, QObject *parent) :
+    QIODevice(parent),
+    d(new GCodeSourcePrivate)
+{
+    d->generator = generator;
+}
+
+GCodeSource::~GCodeSource()
+{
+    delete d;
+}
+
+bool GCodeSource::open(OpenMode mode)
+{
+    if (mode & WriteOnly) {
+        setErrorString(tr("GCodeSource is read only"));
+        return false;
+    }
+    return QIODevice::open(mode);
+}
+
+bool GCodeSource::isSequential() const
+{
+    return true;
+}
+
+qint64 GCodeSource::bytesAvailable() const
+{
+    pull();
+    return d->batch.size() + QIODevice::bytesAvailable();
+}
+
+bool GCodeSource::canReadLine() const
+{
+    return QIODevice::canReadLine() || (pull() && d->batch.contains('\n'));
+}
+
+bool GCodeSource::atEnd() const
+{
+    return QIODevice::bytesAvailable() == 0 && !pull();
+}
+
+qint64 GCodeSource::readData(char *data, qint64 maxSize)
+{
+    if (!pull()) {
+        return d->done ? -1 : 0;
+    }
+    const int size = int(qMin(maxSize, qint64(d->batch.size())));
+    std::memcpy(data, d->batch.constData(), size_t(size));
+    d->batch.remove(0, size);
+    return size;
+}
+
+qint64 GCodeSource::writeData(const char *data, qint64 maxSize)
+{
+    Q_UNUSED(data);
+    Q_UNUSED(maxSize);
+    return -1;
+}
+
+bool GCodeSource::pull() const
+{
+    if (!d->batch.isEmpty()) {
+        return true;
+    }
+    if (d->done || !isOpen() || !d->generator) {
+        return false;
+    }
+    const QStringList commands = d->generator();
+    if (commands.isEmpty()) {
+        d->done = true;
+        //Readers wait for more lines until the channel finished, tell them from the event loop.
+        QMetaObject::invokeMethod(const_cast<GCodeSource *>(this), "readChannelFinished", Qt::QueuedConnection);
+        return false;
+    }
+    for (const QString &command : commands) {
+        d->batch.append(command.toLocal8Bit());
+        d->batch.append('\n');
+    }
+    return true;
+}
@@ -0,0 +1,105 @@
+/* AtCore
+   Copyright (C) <2026>
+
+   Authors:
+       The AtCore contributors
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <QIODevice>
+#include <QStringList>
+
+#include <functional>
+
+#include "atcore_export.h"
+
+class GCodeSourcePrivate;
+/**
+ * @brief The GCodeSource class
+ * Job made by code, pulled one batch of commands at a time
+ *
+ * Print it with AtCore::print(QIODevice *): the print job asks the generator
+ * for the next batch only once the commands before were sent, so however
+ * long the generated program runs, only one batch is held in memory.
+ * The generator is called from the print thread.
+ * @code
+ * int line = 0;
+ * core->print(new GCodeSource([&line] {
+ *     if (line == 100) {
+ *         return QStringList();
+ *     }
+ *     return QStringList({QStringLiteral("G1 X%1 Y%1 F3000").arg(++line)});
+ * }));
+ * @endcode
+ */
+class ATCORE_EXPORT GCodeSource : public QIODevice
+{
+    Q_OBJECT
+public:
+    /**
+     * @brief Returns the next commands of the job, an empty list once the job is done
+     */
+    typedef std::function<QStringList()> Generator;
+
+    /**
+     * @brief Create a new GCodeSource
+     * @param generator: called for the next commands
+     * @param parent: parent of this object
+     */
+    explicit GCodeSource(const Generator &generator, QObject *parent = nullptr);
+    ~GCodeSource() override;
+
+    /**
+     * @brief Open the source, only QIODevice::ReadOnly is supported
+     */
+    bool open(OpenMode mode) override;
+
+    /**
+     * @brief Commands are made as they are read, a source can not seek
+     */
+    bool isSequential() const override;
+
+    /**
+     * @brief Bytes of the current batch left to read, pulls the next batch when it is read
+     */
+    qint64 bytesAvailable() const override;
+
+    /**
+     * @brief True if a command can be read, pulls the next batch when needed
+     */
+    bool canReadLine() const override;
+
+    /**
+     * @brief True once the generator is done and every command was read
+     */
+    bool atEnd() const override;
+
+protected:
+    qint64 readData(char *data, qint64 maxSize) override;
+    qint64 writeData(const char *data, qint64 maxSize) override;
+
+private:
+    /**
+     * @brief Pull the next batch if the current one was read
+     * @return false once the generator is done and every command was read
+     */
+    bool pull() const;
+
+    GCodeSourcePrivate *d;
+};
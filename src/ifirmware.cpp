@@ -21,6 +21,8 @@
     You should have received a copy of the GNU Lesser General Public
     License along with this library.  If not, see <http://www.gnu.org/licenses/>.
 */
+#include <QStringList>
+
 #include "ifirmware.h"
 #include "atcore.h"
 
@@ -29,7 +31,8 @@
  * @param parent: parent of this object
  */
 struct IFirmwarePrivate {
-    AtCore *parent;
+    AtCore *parent = nullptr;
+    QStringList capabilities;
     /**
      * @brief command finished string
      */
@@ -38,6 +41,15 @@ struct IFirmwarePrivate {
 
 const QString IFirmwarePrivate::_ok = QStringLiteral("ok");
 
+namespace
+{
+const QStringList _realtimeCommands = {
+    QStringLiteral("M108"),
+    QStringLiteral("M112"),
+    QStringLiteral("M410")
+};
+}
+
 IFirmware::IFirmware()
     : d(new IFirmwarePrivate)
 {
@@ -46,6 +58,7 @@ IFirmware::IFirmware()
 void IFirmware::init(AtCore *parent)
 {
     d->parent = parent;
+    d->capabilities.clear();
     connect(d->parent, &AtCore::receivedMessage, this, &IFirmware::checkCommand);
 }
 
@@ -56,10 +69,27 @@ AtCore *IFirmware::core() const
 
 IFirmware::~IFirmware()
 {
+    delete d;
+}
+
+IFirmware *IFirmware::create() const
+{
+    return qobject_cast<IFirmware *>(metaObject()->newInstance());
 }
 
 void IFirmware::checkCommand(const QByteArray &lastMessage)
 {
+    if (lastMessage.startsWith("Cap:")) {
+        //Cap:NAME:1
+        const QList<QByteArray> capability = lastMessage.split(':');
+        if (capability.size() == 3 && capability.at(2).trimmed() == "1") {
+            const QString name = QString::fromLatin1(capability.at(1));
+            if (!d->capabilities.contains(name)) {
+                d->capabilities.append(name);
+                emit capabilityFound(name);
+            }
+        }
+    }
     validateCommand(QString::fromLatin1(lastMessage));
 }
 
@@ -74,3 +104,74 @@ QByteArray IFirmware::translate(const QString &command)
 {
     return command.toLocal8Bit();
 }
+
+int IFirmware::sendWindow() const
+{
+    return 0;
+}
+
+QByteArray IFirmware::lineTerminator() const
+{
+    return QByteArray("\n\r");
+}
+
+QString IFirmware::statusCommand() const
+{
+    return QString();
+}
+
+QByteArray IFirmware::statusQuery() const
+{
+    return QByteArray();
+}
+
+QByteArray IFirmware::feedHoldCommand() const
+{
+    return QByteArray();
+}
+
+QByteArray IFirmware::feedResumeCommand() const
+{
+    return QByteArray();
+}
+
+QByteArray IFirmware::resetCommand() const
+{
+    return QByteArray();
+}
+
+bool IFirmware::isRealtimeCommand(const QString &command) const
+{
+    for (const QString &realtime : _realtimeCommands) {
+        if (command.startsWith(realtime)
+                && (command.size() == realtime.size() || !command.at(realtime.size()).isDigit())) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int IFirmware::commandBufferSize() const
+{
+    return 1;
+}
+
+int IFirmware::serialBufferSize() const
+{
+    return 64;
+}
+
+int IFirmware::maxLineLength() const
+{
+    return 0;
+}
+
+QStringList IFirmware::capabilities() const
+{
+    return d->capabilities;
+}
+
+bool IFirmware::hasCapability(const QString &capability) const
+{
+    return d->capabilities.contains(capability);
+}
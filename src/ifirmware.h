@@ -26,6 +26,8 @@
 
 #include <QObject>
 #include <QString>
+#include <QStringList>
+#include <QVariantMap>
 
 #include "atcore_export.h"
 
@@ -36,6 +38,10 @@ struct IFirmwarePrivate;
 /**
  * @brief The IFirmware class
  * Base Class for Firmware Plugins
+ *
+ * The object loaded from a plugin library is shared by the whole process and only
+ * serves as a factory: every connection works with its own handler made by create().
+ * Plugins give their class an invokable default constructor (Q_INVOKABLE) for it.
  */
 class ATCORE_EXPORT  IFirmware : public QObject
 {
@@ -46,6 +52,12 @@ public:
     void init(AtCore *parent);
     ~IFirmware() override;
 
+    /**
+     * @brief Create a new handler of the same firmware for one connection
+     * @return new handler without parent, null if the plugin has no invokable constructor
+     */
+    IFirmware *create() const;
+
     /**
      * @brief Virtual name to be reimplemnted by Firmware plugin
      *
@@ -69,6 +81,107 @@ public:
      */
     virtual QByteArray translate(const QString &command);
 
+    /**
+     * @brief Check if \p command has to bypass the command queue
+     *
+     * Realtime commands are written as soon as they are pushed,
+     * ahead of everything still waiting in the queue.
+     * Default: M108, M112 and M410
+     * @param command: Command to check
+     * @return True if \p command is a realtime command
+     */
+    virtual bool isRealtimeCommand(const QString &command) const;
+
+    /**
+     * @brief Number of commands the firmware can buffer
+     * Default: 1
+     */
+    virtual int commandBufferSize() const;
+
+    /**
+     * @brief Size in bytes of the firmware serial receive buffer
+     * Default: 64
+     */
+    virtual int serialBufferSize() const;
+
+    /**
+     * @brief Longest line the firmware accepts, including the terminator
+     *
+     * Longer commands are not sent, see AtCore::commandRejected(), and a print job holding one fails.
+     * Default: 0, no limit
+     */
+    virtual int maxLineLength() const;
+
+    /**
+     * @brief Bytes that may be sent before the firmware acknowledged them
+     *
+     * Firmwares acknowledging every line in order can be streamed to by counting
+     * characters, commands are then sent while they fit in this many bytes.
+     * Default: 0, wait for the acknowledge of every command.
+     */
+    virtual int sendWindow() const;
+
+    /**
+     * @brief Terminator written after every command
+     * Default: "\n\r"
+     */
+    virtual QByteArray lineTerminator() const;
+
+    /**
+     * @brief Command answering with the state of the whole machine in one reply
+     *
+     * Queued like any command, it is polled instead of M105 so one round trip
+     * brings temperatures, position and progress. The reply is read by validateCommand().
+     * Default: empty, temperatures are polled with M105.
+     */
+    virtual QString statusCommand() const;
+
+    /**
+     * @brief Bytes asking the firmware for a status report
+     *
+     * Written on their own, without terminator and outside the command queue,
+     * so polling never takes room from the commands streamed.
+     * Default: empty, the firmware has no such query.
+     * @sa statusReported()
+     */
+    virtual QByteArray statusQuery() const;
+
+    /**
+     * @brief Bytes stopping motion at once without losing position
+     *
+     * Written without terminator and outside the command queue.
+     * Default: empty, the firmware has no feed hold.
+     * @sa feedResumeCommand()
+     */
+    virtual QByteArray feedHoldCommand() const;
+
+    /**
+     * @brief Bytes resuming motion after feedHoldCommand()
+     * Default: empty
+     */
+    virtual QByteArray feedResumeCommand() const;
+
+    /**
+     * @brief Bytes restarting the firmware, dropping everything it buffered
+     * Default: empty, the firmware has no such command.
+     */
+    virtual QByteArray resetCommand() const;
+
+    /**
+     * @brief Capabilities reported by the firmware
+     *
+     * Names of the enabled "Cap:" entries of the M115 reply (ex AUTOREPORT_TEMP)
+     * @sa hasCapability()
+     */
+    QStringList capabilities() const;
+
+    /**
+     * @brief Check if the firmware reported \p capability as enabled
+     * @param capability: Capability name ex EMERGENCY_PARSER
+     * @sa capabilities()
+     */
+    bool hasCapability(const QString &capability) const;
+
     /**
      * @brief AtCore Parent of the firmware plugin
      * @return
@@ -87,6 +200,18 @@ signals:
      * @brief emit when firmware is ready for a command
      */
     void readyForCommand(void);
+
+    /**
+     * @brief emit when the firmware reported an enabled capability
+     * @param capability: Capability name
+     */
+    void capabilityFound(const QString &capability);
+
+    /**
+     * @brief emit when the firmware answered statusQuery()
+     * @param status: state of the machine, keys depend on the firmware
+     */
+    void statusReported(const QVariantMap &status);
 };
 
 Q_DECLARE_INTERFACE(IFirmware, "org.kde.atelier.core.firmware")
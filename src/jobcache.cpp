@@ -0,0 +1,207 @@
+/* AtCore
+   Copyright (C) <2026>
+
+   Authors:
+       The AtCore contributors
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QLoggingCategory>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSet>
+#include <QWaitCondition>
+#include <QWeakPointer>
+
+#include <cstring>
+
+#include "jobcache.h"
+
+Q_LOGGING_CATEGORY(JOB_CACHE, "org.kde.atelier.core.jobCache")
+
+/**
+ * @brief The CachedJobPrivate class
+ */
+class CachedJobPrivate
+{
+public:
+    QByteArray hash;                        //!< @param hash: content hash
+    QByteArray data;                        //!< @param data: content, read once so later writes to the file don't reach it
+    AtCoreProtocol::JobEstimate estimate;   //!< @param estimate: estimated time and layer of every line
+};
+
+/**
+ * @brief The JobCachePrivate class
+ */
+class JobCachePrivate
+{
+public:
+    /**
+     * @brief What the hash of a file was worked out from
+     */
+    struct FileStamp {
+        qint64 size = -1;       //!< @param size: file size
+        QDateTime modified;     //!< @param modified: last modification
+        QByteArray hash;        //!< @param hash: content hash
+    };
+    mutable QMutex mutex;                           //!< @param mutex: guards the maps, files are read and prepared out of it
+    QWaitCondition loaded;                          //!< @param loaded: a file was read, woken for the ones waiting on loading
+    QHash<QByteArray, QWeakPointer<CachedJob>> jobs;//!< @param jobs: jobs by content hash
+    QHash<QString, FileStamp> files;                //!< @param files: hash of files already read, by path
+    QSet<QString> loading;                          //!< @param loading: files being read, by path
+};
+
+CachedJob::CachedJob()
+    : d(new CachedJobPrivate)
+{
+}
+
+CachedJob::~CachedJob()
+{
+    delete d;
+}
+
+QByteArray CachedJob::hash() const
+{
+    return d->hash;
+}
+
+QByteArray CachedJob::data() const
+{
+    return d->data;
+}
+
+const AtCoreProtocol::JobEstimate &CachedJob::estimate() const
+{
+    return d->estimate;
+}
+
+JobCache::JobCache()
+    : d(new JobCachePrivate)
+{
+}
+
+JobCache::~JobCache()
+{
+    delete d;
+}
+
+JobCache *JobCache::instance()
+{
+    static JobCache cache;
+    return &cache;
+}
+
+int JobCache::jobCount() const
+{
+    QMutexLocker locker(&d->mutex);
+    int count = 0;
+    for (const QWeakPointer<CachedJob> &job : d->jobs) {
+        count += job.isNull() ? 0 : 1;
+    }
+    return count;
+}
+
+QSharedPointer<const CachedJob> JobCache::acquire(const QString &fileName, QString *error)
+{
+    const QFileInfo info(fileName);
+    const QString path = info.canonicalFilePath();
+    QMutexLocker locker(&d->mutex);
+
+    //Drop the jobs no printer runs anymore.
+    for (auto it = d->jobs.begin(); it != d->jobs.end();) {
+        it = it.value().isNull() ? d->jobs.erase(it) : it + 1;
+    }
+    for (auto it = d->files.begin(); it != d->files.end();) {
+        it = d->jobs.contains(it->hash) ? it + 1 : d->files.erase(it);
+    }
+
+    //Printers starting the same file wait for the one reading it, others go on.
+    while (d->loading.contains(path)) {
+        d->loaded.wait(&d->mutex);
+    }
+
+    //A file not changed since it was hashed needs no reading.
+    const auto stamp = d->files.constFind(path);
+    if (stamp != d->files.constEnd() && stamp->size == info.size() && stamp->modified == info.lastModified()) {
+        const QSharedPointer<CachedJob> job = d->jobs.value(stamp->hash).toStrongRef();
+        if (job) {
+            return job;
+        }
+    }
+    d->loading.insert(path);
+    locker.unlock();
+
+    //A private copy, not a mapping: the file may be rewritten or truncated while printers run it.
+    QFile file(path.isEmpty() ? fileName : path);
+    const bool opened = file.open(QFile::ReadOnly);
+    const QByteArray data = opened ? file.readAll() : QByteArray();
+    QSharedPointer<CachedJob> job;
+    if (!opened || file.error() != QFile::NoError) {
+        qCDebug(JOB_CACHE) << "Unable to read" << fileName << file.errorString();
+        if (error) {
+            *error = file.errorString();
+        }
+        locker.relock();
+    } else {
+        const QByteArray hash = QCryptographicHash::hash(data, QCryptographicHash::Sha1);
+        locker.relock();
+        //Same content under another path, share the job already held.
+        job = d->jobs.value(hash).toStrongRef();
+        if (!job) {
+            locker.unlock();
+            const QSharedPointer<CachedJob> prepared = load(path, hash, data);
+            locker.relock();
+            //Unless the same content was loaded from another path meanwhile.
+            job = d->jobs.value(hash).toStrongRef();
+            if (!job) {
+                job = prepared;
+                d->jobs.insert(hash, job);
+            }
+        }
+        JobCachePrivate::FileStamp &entry = d->files[path];
+        entry.size = info.size();
+        entry.modified = info.lastModified();
+        entry.hash = hash;
+    }
+    d->loading.remove(path);
+    d->loaded.wakeAll();
+    return job;
+}
+
+QSharedPointer<CachedJob> JobCache::load(const QString &fileName, const QByteArray &hash, const QByteArray &data) const
+{
+    QSharedPointer<CachedJob> job(new CachedJob);
+    job->d->hash = hash;
+    job->d->data = data;
+    const int size = data.size();
+    const char *content = data.constData();
+    int start = 0;
+    while (start < size) {
+        const char *newLine = static_cast<const char *>(std::memchr(content + start, '\n', std::size_t(size - start)));
+        const int end = newLine ? int(newLine - content) + 1 : size;
+        job->d->estimate.addLine(content + start, std::size_t(end - start));
+        start = end;
+    }
+    qCDebug(JOB_CACHE) << "Cached" << fileName << job->d->estimate.lineCount() << "lines, hash" << hash.toHex();
+    return job;
+}
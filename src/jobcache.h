@@ -0,0 +1,114 @@
+/* AtCore
+   Copyright (C) <2026>
+
+   Authors:
+       The AtCore contributors
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <QByteArray>
+#include <QSharedPointer>
+#include <QString>
+
+#include "atcore_export.h"
+#include "protocol/jobestimate.h"
+
+class CachedJobPrivate;
+class JobCachePrivate;
+
+/**
+ * @brief The CachedJob class
+ * One print job shared, read only, by every printer running it
+ *
+ * Holds a copy of the job in memory and its estimate.
+ * Get it from JobCache::acquire(), it is freed once the last printer released it.
+ */
+class ATCORE_EXPORT CachedJob
+{
+public:
+    ~CachedJob();
+
+    /**
+     * @brief Content hash of the job, the key of the cache
+     */
+    QByteArray hash() const;
+
+    /**
+     * @brief The whole job, shared with the cache
+     * Valid as long as the job is held.
+     */
+    QByteArray data() const;
+
+    /**
+     * @brief Estimated time and layer of every line
+     */
+    const AtCoreProtocol::JobEstimate &estimate() const;
+
+private:
+    friend class JobCache;
+    CachedJob();
+    Q_DISABLE_COPY(CachedJob)
+
+    CachedJobPrivate *d;
+};
+
+/**
+ * @brief The JobCache class
+ * Process wide cache of print jobs, keyed by content hash
+ *
+ * Printers running the same job, even from different paths, share one copy:
+ * memory and preparation scale with the distinct jobs, not the printers.
+ * Safe to use from every print thread.
+ */
+class ATCORE_EXPORT JobCache
+{
+public:
+    /**
+     * @brief The cache of the process
+     */
+    static JobCache *instance();
+
+    /**
+     * @brief Get the job in \p fileName, loading and preparing it if no printer runs it yet
+     *
+     * Files are read and prepared without holding up other files: only the callers
+     * asking for a file being read wait for it.
+     * @param fileName: gcode file
+     * @param error: set to why the file can't be read
+     * @return shared job, null if the file can't be read. Release it by dropping the pointer
+     */
+    QSharedPointer<const CachedJob> acquire(const QString &fileName, QString *error = nullptr);
+
+    /**
+     * @brief Number of distinct jobs held
+     */
+    int jobCount() const;
+
+private:
+    JobCache();
+    ~JobCache();
+    Q_DISABLE_COPY(JobCache)
+
+    /**
+     * @brief Read and prepare the job in \p fileName
+     */
+    QSharedPointer<CachedJob> load(const QString &fileName, const QByteArray &hash, const QByteArray &data) const;
+
+    JobCachePrivate *d;
+};
@@ -41,7 +41,7 @@ public:
     /**
      * @brief Create new AprinterPlugin
      */
-    AprinterPlugin();
+    Q_INVOKABLE AprinterPlugin();
 
     /**
      * @brief Return Plugin name
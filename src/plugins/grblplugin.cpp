@@ -23,8 +23,18 @@
     License along with this library.  If not, see <http://www.gnu.org/licenses/>.
 */
 #include <QString>
+#include <QVariantList>
 
 #include "grblplugin.h"
+#include "protocol/messages.h"
+
+namespace
+{
+QVariantList toList(const double *values)
+{
+    return QVariantList({values[0], values[1], values[2]});
+}
+}
 
 QString GrblPlugin::name() const
 {
@@ -38,6 +48,84 @@ GrblPlugin::GrblPlugin()
 
 void GrblPlugin::validateCommand(const QString &lastMessage)
 {
-    Q_UNUSED(lastMessage);
-    emit readyForCommand();
+    if (lastMessage.startsWith(QChar::fromLatin1('<'))) {
+        AtCoreProtocol::GrblStatus report;
+        if (AtCoreProtocol::parseGrblStatus(lastMessage.toStdString(), report)) {
+            QVariantMap status;
+            status.insert(QStringLiteral("state"), QString::fromStdString(report.state));
+            if (report.hasMachinePosition) {
+                status.insert(QStringLiteral("machinePosition"), toList(report.machinePosition));
+            }
+            if (report.hasWorkPosition) {
+                status.insert(QStringLiteral("workPosition"), toList(report.workPosition));
+            }
+            if (report.plannerBlocks >= 0) {
+                status.insert(QStringLiteral("plannerBlocks"), report.plannerBlocks);
+                status.insert(QStringLiteral("rxBytes"), report.rxBytes);
+            }
+            if (report.hasFeed) {
+                status.insert(QStringLiteral("feed"), report.feed);
+                status.insert(QStringLiteral("spindle"), report.spindle);
+            }
+            emit statusReported(status);
+        }
+        return;
+    }
+    if (lastMessage.startsWith(QStringLiteral("ALARM"))) {
+        //Grbl locks up after a reset in motion or a limit hit, until homed ($H) or unlocked ($X).
+        QVariantMap status;
+        status.insert(QStringLiteral("state"), QStringLiteral("Alarm"));
+        status.insert(QStringLiteral("alarm"), lastMessage.mid(6).trimmed());
+        emit statusReported(status);
+        return;
+    }
+    //Feedback messages and the welcome message are not answers to a line.
+    if (lastMessage.startsWith(QStringLiteral("ok")) || lastMessage.startsWith(QStringLiteral("error:"))) {
+        emit readyForCommand();
+    }
+}
+
+int GrblPlugin::commandBufferSize() const
+{
+    return 15;
+}
+
+int GrblPlugin::serialBufferSize() const
+{
+    return 128;
+}
+
+int GrblPlugin::maxLineLength() const
+{
+    return 80;
+}
+
+int GrblPlugin::sendWindow() const
+{
+    return serialBufferSize();
+}
+
+QByteArray GrblPlugin::lineTerminator() const
+{
+    return QByteArray("\n");
+}
+
+QByteArray GrblPlugin::statusQuery() const
+{
+    return QByteArray("?");
+}
+
+QByteArray GrblPlugin::feedHoldCommand() const
+{
+    return QByteArray("!");
+}
+
+QByteArray GrblPlugin::feedResumeCommand() const
+{
+    return QByteArray("~");
+}
+
+QByteArray GrblPlugin::resetCommand() const
+{
+    return QByteArray(1, char(0x18));
 }
@@ -41,7 +41,7 @@ public:
     /**
      * @brief Create new GrblPlugin
      */
-    GrblPlugin();
+    Q_INVOKABLE GrblPlugin();
 
     /**
      * @brief Return Plugin name
@@ -50,7 +50,56 @@ public:
     QString name() const override;
 
     /**
-     * @brief Grbl does not return anything on command execution
+     * @brief Grbl buffers 15 commands
+     */
+    int commandBufferSize() const override;
+
+    /**
+     * @brief Grbl receives into a 128 byte buffer
+     */
+    int serialBufferSize() const override;
+
+    /**
+     * @brief Grbl accepts lines up to 80 bytes
+     */
+    int maxLineLength() const override;
+
+    /**
+     * @brief Grbl is streamed to by counting characters, the whole receive buffer is used
+     */
+    int sendWindow() const override;
+
+    /**
+     * @brief Grbl answers an empty line with "ok", "\r" must not follow "\n"
+     */
+    QByteArray lineTerminator() const override;
+
+    /**
+     * @brief Grbl answers "?" with a status report, ex "<Idle|MPos:0.000,0.000,0.000|Bf:15,128|FS:0,0>"
+     */
+    QByteArray statusQuery() const override;
+
+    /**
+     * @brief Grbl holds the feed on "!"
+     */
+    QByteArray feedHoldCommand() const override;
+
+    /**
+     * @brief Grbl starts the cycle again on "~"
+     */
+    QByteArray feedResumeCommand() const override;
+
+    /**
+     * @brief Grbl soft resets on ctrl-x (0x18)
+     */
+    QByteArray resetCommand() const override;
+
+    /**
+     * @brief Grbl answers every line with "ok" or "error:", each one frees a command in flight
+     *
+     * Status reports are emitted with statusReported(), keys are "state", "machinePosition",
+     * "workPosition", "plannerBlocks", "rxBytes", "feed" and "spindle" when reported.
+     * An "ALARM:" message is emitted as state "Alarm" with its code as "alarm".
      * @param lastMessage: last message from printer
      */
     void validateCommand(const QString &lastMessage) override;
@@ -27,6 +27,10 @@
 
 #include "marlinplugin.h"
 #include "atcore.h"
+#include "seriallayer.h"
+#include "protocol/meatpack.h"
+
+using AtCoreProtocol::MeatPack;
 
 Q_LOGGING_CATEGORY(MARLIN_PLUGIN, "org.kde.atelier.core.firmware.marlin")
 
@@ -39,3 +43,54 @@ MarlinPlugin::MarlinPlugin()
 {
     qCDebug(MARLIN_PLUGIN) << name() << " plugin loaded!";
 }
+
+int MarlinPlugin::commandBufferSize() const
+{
+    return 4;
+}
+
+int MarlinPlugin::serialBufferSize() const
+{
+    return 128;
+}
+
+int MarlinPlugin::maxLineLength() const
+{
+    return 96;
+}
+
+QByteArray MarlinPlugin::translate(const QString &command)
+{
+    if (!_packing) {
+        return IFirmware::translate(command);
+    }
+    const std::string text = command.toStdString();
+    if (isRealtimeCommand(command)) {
+        //The emergency parser reads the bytes as received, before MeatPack unpacks them.
+        const std::string bytes = MeatPack::command(MeatPack::DisablePacking) + text + '\n' + MeatPack::command(MeatPack::EnablePacking);
+        return QByteArray(bytes.data(), int(bytes.size()));
+    }
+    const std::string bytes = MeatPack::pack(MeatPack::minimize(text, true), true);
+    return QByteArray(bytes.data(), int(bytes.size()));
+}
+
+QByteArray MarlinPlugin::lineTerminator() const
+{
+    return _packing ? QByteArray() : IFirmware::lineTerminator();
+}
+
+void MarlinPlugin::validateCommand(const QString &lastMessage)
+{
+    if (lastMessage.startsWith(QStringLiteral("Cap:MEATPACK:1")) && core()->serialInitialized()) {
+        //Commands written from now on are packed, the firmware reads them in order.
+        const std::string enable = MeatPack::command(MeatPack::EnableNoSpaces) + MeatPack::command(MeatPack::EnablePacking);
+        core()->serial()->pushUrgentCommand(QByteArray(enable.data(), int(enable.size())), QByteArray());
+        _packing = true;
+        qCDebug(MARLIN_PLUGIN) << "MeatPack enabled";
+    } else if (lastMessage.startsWith(QStringLiteral("start"))) {
+        _packing = false;
+    } else if (lastMessage.startsWith(QStringLiteral("[MP]"))) {
+        qCDebug(MARLIN_PLUGIN) << "MeatPack state:" << lastMessage;
+    }
+    IFirmware::validateCommand(lastMessage);
+}
@@ -41,11 +41,50 @@ public:
     /**
      * @brief Create new MarlinPlugin
      */
-    MarlinPlugin();
+    Q_INVOKABLE MarlinPlugin();
 
     /**
      * @brief Return Plugin name
      * @return Marlin
      */
     QString name() const override;
+
+    /**
+     * @brief Marlin buffers 4 commands
+     */
+    int commandBufferSize() const override;
+
+    /**
+     * @brief Marlin receives into a 128 byte buffer
+     */
+    int serialBufferSize() const override;
+
+    /**
+     * @brief Marlin accepts lines up to 96 bytes
+     */
+    int maxLineLength() const override;
+
+    /**
+     * @brief Pack commands with MeatPack once Marlin reported Cap:MEATPACK:1
+     *
+     * Comments and spaces are stripped and the line end is packed along.
+     * Realtime commands are sent unpacked so the emergency parser sees them.
+     * @param command: Command command to translate
+     * @return bytes to write
+     */
+    QByteArray translate(const QString &command) override;
+
+    /**
+     * @brief Packed commands carry their own line end
+     */
+    QByteArray lineTerminator() const override;
+
+    /**
+     * @brief Switch MeatPack on when Marlin reports it, off when Marlin restarts
+     * @param lastMessage: last message from printer
+     */
+    void validateCommand(const QString &lastMessage) override;
+
+private:
+    bool _packing = false;  //!< @param _packing: commands are sent packed
 };
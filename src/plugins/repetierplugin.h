@@ -41,7 +41,7 @@ public:
     /**
      * @brief Create new RepetierPlugin
      */
-    RepetierPlugin();
+    Q_INVOKABLE RepetierPlugin();
 
     /**
      * @brief Return Plugin name
@@ -0,0 +1,100 @@
+/* AtCore KDE Libary for 3D Printers
+    Copyright (C) <2026>
+
+    Authors:
+        The AtCore contributors
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <QLoggingCategory>
+#include <QString>
+#include <QVariantList>
+
+#include "reprapfirmwareplugin.h"
+#include "atcore.h"
+#include "gcodecommands.h"
+#include "protocol/reprapstatus.h"
+
+Q_LOGGING_CATEGORY(REPRAPFIRMWARE_PLUGIN, "org.kde.atelier.core.firmware.reprapfirmware")
+
+namespace
+{
+QVariantList toList(const std::vector<double> &values)
+{
+    QVariantList list;
+    for (double value : values) {
+        list.append(value);
+    }
+    return list;
+}
+}
+
+QString RepRapFirmwarePlugin::name() const
+{
+    return QStringLiteral("RepRapFirmware");
+}
+
+RepRapFirmwarePlugin::RepRapFirmwarePlugin()
+{
+    qCDebug(REPRAPFIRMWARE_PLUGIN) << name() << " plugin loaded!";
+}
+
+QString RepRapFirmwarePlugin::statusCommand() const
+{
+    return GCode::toCommand(GCode::M408, QStringLiteral("0"));
+}
+
+void RepRapFirmwarePlugin::validateCommand(const QString &lastMessage)
+{
+    if (lastMessage.startsWith(QChar::fromLatin1('{'))) {
+        AtCoreProtocol::RepRapStatus report;
+        if (!AtCoreProtocol::parseRepRapStatus(lastMessage.toStdString(), report)) {
+            qCDebug(REPRAPFIRMWARE_PLUGIN) << "Can't read status:" << lastMessage;
+            return;
+        }
+        //Heater 0 is the bed, the hotend of tool n is heater n + 1.
+        const std::size_t hotend = std::size_t(qMax(report.tool, 0) + 1);
+        if (!report.heaters.empty()) {
+            core()->temperature().setBedTemperature(float(report.heaters.front()));
+        }
+        if (report.heaters.size() > hotend) {
+            core()->temperature().setExtruderTemperature(float(report.heaters.at(hotend)));
+        }
+        if (!report.active.empty()) {
+            core()->temperature().setBedTargetTemperature(float(report.active.front()));
+        }
+        if (report.active.size() > hotend) {
+            core()->temperature().setExtruderTargetTemperature(float(report.active.at(hotend)));
+        }
+
+        QVariantMap status;
+        status.insert(QStringLiteral("state"), QString(QChar::fromLatin1(report.status)));
+        status.insert(QStringLiteral("heaters"), toList(report.heaters));
+        status.insert(QStringLiteral("active"), toList(report.active));
+        status.insert(QStringLiteral("position"), toList(report.position));
+        status.insert(QStringLiteral("fanPercent"), toList(report.fanPercent));
+        status.insert(QStringLiteral("tool"), report.tool);
+        if (report.fractionPrinted >= 0) {
+            status.insert(QStringLiteral("fractionPrinted"), report.fractionPrinted);
+        }
+        emit statusReported(status);
+        return;
+    }
+    if (lastMessage.startsWith(QStringLiteral("ok"))) {
+        emit readyForCommand();
+    }
+}
@@ -0,0 +1,63 @@
+/* AtCore KDE Libary for 3D Printers
+    Copyright (C) <2026>
+
+    Authors:
+        The AtCore contributors
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <QObject>
+
+#include "ifirmware.h"
+/**
+ * @brief The RepRapFirmwarePlugin class
+ * Plugin for RepRapFirmware (Duet)
+ */
+class RepRapFirmwarePlugin : public IFirmware
+{
+    Q_OBJECT
+    Q_PLUGIN_METADATA(IID "org.kde.atelier.core.firmware")
+    Q_INTERFACES(IFirmware)
+
+public:
+    /**
+     * @brief Create new RepRapFirmwarePlugin
+     */
+    Q_INVOKABLE RepRapFirmwarePlugin();
+
+    /**
+     * @brief Return Plugin name
+     * @return RepRapFirmware
+     */
+    QString name() const override;
+
+    /**
+     * @brief M408 S0 reports temperatures, position, fans and progress in one reply
+     */
+    QString statusCommand() const override;
+
+    /**
+     * @brief Read M408 replies, only "ok" frees the firmware for the next command
+     *
+     * M408 replies update the temperature and are emitted with statusReported(), keys are "state",
+     * "heaters", "active", "position", "fanPercent", "tool" and "fractionPrinted" when reported.
+     * @param lastMessage: last message from printer
+     */
+    void validateCommand(const QString &lastMessage) override;
+};
@@ -41,7 +41,7 @@ public:
     /**
      * @brief Create new SmoothiePlugin
      */
-    SmoothiePlugin();
+    Q_INVOKABLE SmoothiePlugin();
 
     /**
      * @brief Return Plugin name
@@ -41,7 +41,7 @@ public:
     /**
      * @brief Create new SprinterPlugin
      */
-    SprinterPlugin();
+    Q_INVOKABLE SprinterPlugin();
 
     /**
      * @brief Return Plugin name
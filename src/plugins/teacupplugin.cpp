@@ -27,6 +27,7 @@
 
 #include "teacupplugin.h"
 #include "atcore.h"
+#include "protocol/dialect.h"
 
 Q_LOGGING_CATEGORY(TEACUP_PLUGIN, "org.kde.atelier.core.firmware.teacup")
 
@@ -42,13 +43,7 @@ TeacupPlugin::TeacupPlugin()
 
 QByteArray TeacupPlugin::translate(const QString &command)
 {
-    QString temp = command;
-    if (command.contains(QStringLiteral("M109"))) {
-        temp.replace(QStringLiteral("M109"), QStringLiteral("M104"));
-        temp.append(QStringLiteral("\r\nM116"));
-    } else if (command.contains(QStringLiteral("M190"))) {
-        temp.replace(QStringLiteral("M190"), QStringLiteral("M140"));
-        temp.append(QStringLiteral("\r\nM116"));
-    }
-    return temp.toLocal8Bit();
+    static const AtCoreProtocol::Dialect teacup = AtCoreProtocol::Dialect::teacup();
+    const std::string translated = teacup.translate(command.toStdString());
+    return QByteArray(translated.data(), int(translated.size()));
 }
@@ -41,7 +41,7 @@ public:
     /**
      * @brief Create new TeacupPlugin
      */
-    TeacupPlugin();
+    Q_INVOKABLE TeacupPlugin();
 
     /**
      * @brief Return Plugin name
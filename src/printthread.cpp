@@ -20,11 +20,18 @@
     You should have received a copy of the GNU Lesser General Public
     License along with this library.  If not, see <http://www.gnu.org/licenses/>.
 */
+#include <QBuffer>
+#include <QQueue>
 #include <QTime>
 #include <QLoggingCategory>
 
 #include "printthread.h"
+#include "compressedjob.h"
 #include "gcodecommands.h"
+#include "jobcache.h"
+#include "protocol/jobestimate.h"
+#include "protocol/jobstart.h"
+#include "tracelogger.h"
 
 Q_LOGGING_CATEGORY(PRINT_THREAD, "org.kde.atelier.core.printThread")
 /**
@@ -34,42 +41,131 @@ class PrintThreadPrivate
 {
 public:
     AtCore *core = nullptr;             //!<@param core: Pointer to AtCore
-    QTextStream *gcodestream = nullptr; //!<@param gcodestream: Steam the job is read from
+    QIODevice *device = nullptr;        //!<@param device: device the job is read from
+    CompressedJob *compressed = nullptr;//!<@param compressed: device when the job is decompressed while printed
+    bool inputFinished = false;         //!<@param inputFinished: no more lines will arrive on device
+    bool inputFailed = false;           //!<@param inputFailed: the job could not be read to its end
+    bool starved = false;               //!<@param starved: the job waits for lines to arrive
     float printProgress = 0;            //!<@param printProgress: Progress of the print job
     qint64 totalSize = 0;               //!<@param totalSize: total file size
     qint64 stillSize = 0;               //!<@param stillSize: remaining file
-    QString cline;                      //!<@param cline: current line
+    QString cline;                      //!<@param cline: current line, not sent yet while not empty
+    int sendWindow = 0;                 //!<@param sendWindow: bytes the firmware buffers, 0 for one line per acknowledge
+    int terminatorSize = 1;             //!<@param terminatorSize: bytes added to every line when it is written
+    int maxLineLength = 0;              //!<@param maxLineLength: longest line the firmware accepts, 0 for no limit
+    QQueue<int> inFlight;               //!<@param inFlight: bytes of every line emitted and not done yet
+    int bytesInFlight = 0;              //!<@param bytesInFlight: sum of inFlight
     AtCore::STATES state = AtCore::IDLE;//!<@param state: printer state
-    QFile *file = nullptr;              //!<@param file: gcode File to stream from
+    QBuffer *buffer = nullptr;          //!<@param buffer: reads the job shared by the cache
+    QSharedPointer<const CachedJob> job;//!<@param job: job from the cache, null for other devices
+    QStringList startBlock;             //!<@param startBlock: rewritten start of the job, sent before reading on
+    int firstWait = -1;                 //!<@param firstWait: index of the first heating wait in startBlock
+    QTime jobTime;                      //!<@param jobTime: time since the job started
+    AtCoreProtocol::JobEstimate localEstimate;//!<@param localEstimate: estimate of jobs not from the cache
+    const AtCoreProtocol::JobEstimate *estimate = &localEstimate;//!<@param estimate: estimated time and layer of every line
+    std::size_t lineNumber = 0;         //!<@param lineNumber: lines read from the job
+    int progressStep = -1;              //!<@param progressStep: last progress emitted, in 0.1%
+    int layer = -1;                     //!<@param layer: last layer emitted
 };
 
-PrintThread::PrintThread(AtCore *parent, QString fileName) : d(new PrintThreadPrivate)
+PrintThread::PrintThread(AtCore *parent) : d(new PrintThreadPrivate)
 {
     d->core = parent;
-    d->state = d->core->state();
-    d->file = new QFile(fileName);
-    d->file->open(QFile::ReadOnly);
-    d->totalSize = d->file->bytesAvailable();
-    d->stillSize = d->totalSize;
-    d->gcodestream = new QTextStream(d->file);
+    // child of the worker so it follows it to the print thread
+    d->buffer = new QBuffer(this);
+}
+
+PrintThread::~PrintThread()
+{
+    delete d;
+}
+
+void PrintThread::start(const QString &fileName, bool optimizeStart, bool hotProbe, int sendWindow, int terminatorSize, int maxLineLength)
+{
+    if (CompressedJob::detect(fileName) != CompressedJob::None) {
+        //Decompressed as it is printed, never whole in memory nor on disk.
+        start(new CompressedJob(fileName), optimizeStart, hotProbe, sendWindow, terminatorSize, maxLineLength);
+        return;
+    }
+    //Printers running the same job share it, read and estimated once.
+    QString error;
+    d->job = JobCache::instance()->acquire(fileName, &error);
+    if (!d->job) {
+        failStart(tr("Unable to open %1: %2").arg(fileName, error));
+        return;
+    }
+    d->buffer->setData(d->job->data());
+    start(d->buffer, optimizeStart, hotProbe, sendWindow, terminatorSize, maxLineLength);
 }
 
-void PrintThread::start()
+void PrintThread::start(QIODevice *device, bool optimizeStart, bool hotProbe, int sendWindow, int terminatorSize, int maxLineLength)
 {
-    // we only want to do this when printing
-    connect(d->core->firmwarePlugin(), &IFirmware::readyForCommand, this, &PrintThread::processJob, Qt::QueuedConnection);
-    connect(this, &PrintThread::nextCommand, d->core, &AtCore::pushCommand, Qt::QueuedConnection);
+    if (!device->isOpen() && !device->open(QIODevice::ReadOnly)) {
+        const QString message = tr("Unable to open the job: %1").arg(device->errorString());
+        if (device != d->buffer) {
+            device->deleteLater();
+        }
+        failStart(message);
+        return;
+    }
+    d->device = device;
+    d->compressed = qobject_cast<CompressedJob *>(device);
+    d->state = AtCore::STARTPRINT;
+    //The size of a stream is only known once it finished, a compressed job has its compressed size.
+    d->totalSize = d->compressed ? d->compressed->compressedSize() : d->device->isSequential() ? 0 : d->device->bytesAvailable();
+    d->stillSize = d->totalSize;
+    d->printProgress = d->device->isSequential() && !d->compressed ? -1 : 0;
+    d->lineNumber = 0;
+    d->progressStep = -1;
+    d->layer = -1;
+    d->inputFinished = !d->device->isSequential();
+    d->inputFailed = false;
+    d->starved = false;
+    d->localEstimate.clear();
+    d->estimate = d->job ? &d->job->estimate() : &d->localEstimate;
+    if (d->device->isSequential()) {
+        connect(d->device, &QIODevice::readyRead, this, &PrintThread::resumeJob);
+        connect(d->device, &QIODevice::readChannelFinished, this, &PrintThread::finishInput);
+        connect(d->device, &QIODevice::aboutToClose, this, &PrintThread::finishInput);
+    } else if (!d->job) {
+        prepareEstimate();
+    }
+    d->startBlock.clear();
+    d->firstWait = -1;
+    d->sendWindow = sendWindow;
+    d->terminatorSize = terminatorSize;
+    d->maxLineLength = maxLineLength;
+    d->inFlight.clear();
+    d->bytesInFlight = 0;
+    d->jobTime.start();
+    if (optimizeStart) {
+        if (d->compressed) {
+            //Give the start block its first chunk to work on.
+            d->compressed->waitForReadyRead(1000);
+        }
+        prepareStartBlock(hotProbe);
+    }
+    d->cline.clear();
+
     connect(this, &PrintThread::stateChanged, d->core, &AtCore::setState, Qt::QueuedConnection);
     connect(d->core, &AtCore::stateChanged, this, &PrintThread::setState, Qt::QueuedConnection);
-    connect(this, &PrintThread::finished, this, &PrintThread::deleteLater);
-    // force a command if the printer doesn't send "wait" when idle
+    processJob();
+}
+
+void PrintThread::commandDone()
+{
+    if (d->inFlight.isEmpty()) {
+        //Dropped after the job ended.
+        return;
+    }
+    d->bytesInFlight -= d->inFlight.dequeue();
     processJob();
 }
 
 void PrintThread::processJob()
 {
-    if (d->gcodestream->atEnd()) {
-        endPrint();
+    if (!d->device) {
+        return;
     }
 
     switch (d->state) {
@@ -77,18 +173,38 @@ void PrintThread::processJob()
     case AtCore::IDLE:
     case AtCore::BUSY:
         setState(AtCore::BUSY);
-        nextLine();
-        while (d->cline.isEmpty() && !d->gcodestream->atEnd()) {
-            nextLine();
-        }
-        if (!d->cline.isEmpty()) {
-            qCDebug(PRINT_THREAD) << "cline:" << d->cline;
+        //Send while the firmware has room, the lines queued in it keep its planner busy.
+        while (!d->cline.isEmpty() || fetchCommand()) {
+            const int bytes = d->cline.size() + d->terminatorSize;
+            if (!d->inFlight.isEmpty() && (d->sendWindow == 0 || d->bytesInFlight + bytes > d->sendWindow)) {
+                return;
+            }
+            if (d->maxLineLength > 0 && int(d->cline.toStdString().size()) + qMax(d->terminatorSize, 1) > d->maxLineLength) {
+                //AtCore would drop it, the job would go on without it.
+                emit error(tr("Line %1 is longer than the firmware accepts: %2").arg(d->lineNumber).arg(d->cline));
+                endPrint(true);
+                return;
+            }
+            updateProgress();
+            ATCORE_TRACE(PRINT_THREAD, "cline: line %u, %u start lines left", d->lineNumber, d->startBlock.size());
+            d->inFlight.enqueue(bytes);
+            d->bytesInFlight += bytes;
             emit nextCommand(d->cline);
+            d->cline.clear();
+        }
+        if (!inputAtEnd()) {
+            //readyRead() goes on with the job.
+            qCDebug(PRINT_THREAD) << "Waiting for the job to arrive";
+            d->starved = true;
+        } else if (d->inFlight.isEmpty()) {
+            //The last line was acknowledged.
+            endPrint(d->inputFailed);
         }
         break;
 
     case AtCore::ERRORSTATE:
         qCDebug(PRINT_THREAD) << "Error State";
+        endPrint(true);
         break;
 
     case AtCore::STOP: {
@@ -105,27 +221,172 @@ void PrintThread::processJob()
     }
 }
 
-void PrintThread::endPrint()
+void PrintThread::endPrint(bool failed)
 {
-    emit(printProgressChanged(100));
-    qCDebug(PRINT_THREAD) << "atEnd";
-    disconnect(d->core->firmwarePlugin(), &IFirmware::readyForCommand, this, &PrintThread::processJob);
-    disconnect(this, &PrintThread::nextCommand, d->core, &AtCore::pushCommand);
+    qCDebug(PRINT_THREAD) << "atEnd" << (failed ? "on an error" : "");
     disconnect(d->core, &AtCore::stateChanged, this, &PrintThread::setState);
-    emit(stateChanged(AtCore::FINISHEDPRINT));
-    emit(stateChanged(AtCore::IDLE));
+    if (failed) {
+        emit(stateChanged(AtCore::ERRORSTATE));
+    } else {
+        emit(printProgressChanged(100, d->estimate->layerCount(), d->estimate->layerCount(), 0));
+        emit(stateChanged(AtCore::FINISHEDPRINT));
+        emit(stateChanged(AtCore::IDLE));
+    }
     disconnect(this, &PrintThread::stateChanged, d->core, &AtCore::setState);
+    d->startBlock.clear();
+    d->cline.clear();
+    d->inFlight.clear();
+    d->bytesInFlight = 0;
+    d->starved = false;
+    if (d->device == d->buffer) {
+        d->device->close();
+        d->buffer->setData(QByteArray());
+        d->job.clear();
+    } else {
+        disconnect(d->device, nullptr, this, nullptr);
+        d->device->deleteLater();
+    }
+    d->device = nullptr;
+    d->compressed = nullptr;
+    emit finished();
+}
+
+void PrintThread::failStart(const QString &message)
+{
+    qCDebug(PRINT_THREAD) << "Unable to start the job:" << message;
+    emit error(message);
+    //Nothing was sent, the printer is ready for another job.
+    QMetaObject::invokeMethod(d->core, "setState", Qt::QueuedConnection, Q_ARG(AtCore::STATES, AtCore::IDLE));
+    d->job.clear();
     emit finished();
+}
+
+void PrintThread::resumeJob()
+{
+    if (d->starved) {
+        d->starved = false;
+        processJob();
+    }
+}
 
+void PrintThread::finishInput()
+{
+    if (!d->inputFinished && d->compressed && d->compressed->hasError()) {
+        //The lines decompressed before the error are sent, then the job fails.
+        qCDebug(PRINT_THREAD) << "Compressed job failed:" << d->compressed->errorString();
+        d->inputFailed = true;
+        emit error(tr("Unable to decompress the job: %1").arg(d->compressed->errorString()));
+    }
+    d->inputFinished = true;
+    resumeJob();
+}
+
+bool PrintThread::lineAvailable() const
+{
+    return d->device && (d->device->canReadLine() || (d->inputFinished && !d->device->atEnd()));
+}
+
+bool PrintThread::inputAtEnd() const
+{
+    return !d->device || (d->startBlock.isEmpty() && d->inputFinished && d->device->atEnd());
+}
+
+bool PrintThread::fetchCommand()
+{
+    if (!d->startBlock.isEmpty()) {
+        d->cline = d->startBlock.takeFirst();
+        if (d->firstWait-- == 0) {
+            //Homing and probing ran while heating until now.
+            qCDebug(PRINT_THREAD) << "Job start overlapped heating for" << d->jobTime.elapsed() << "ms";
+            emit jobStartOverlap(d->jobTime.elapsed());
+        }
+        return true;
+    }
+    while (lineAvailable()) {
+        nextLine();
+        if (!d->cline.isEmpty()) {
+            return true;
+        }
+    }
+    return false;
+}
+void PrintThread::prepareStartBlock(bool hotProbe)
+{
+    AtCoreProtocol::JobStartOptions options;
+    options.hotProbe = hotProbe;
+
+    std::vector<std::string> lines;
+    //A streamed job is optimized as far as it arrived.
+    while (lineAvailable() && lines.size() < options.maxLines) {
+        nextLine();
+        if (d->cline.isEmpty()) {
+            continue;
+        }
+        lines.push_back(d->cline.toStdString());
+        if (AtCoreProtocol::isExtrusion(lines.back())) {
+            break;
+        }
+    }
+
+    std::size_t firstWait = 0;
+    if (AtCoreProtocol::optimizeJobStart(lines, options, &firstWait)) {
+        qCDebug(PRINT_THREAD) << "Start block rewritten, first wait at line" << firstWait;
+        d->firstWait = int(firstWait);
+    }
+    for (const std::string &line : lines) {
+        d->startBlock.append(QString::fromStdString(line));
+    }
 }
+
+void PrintThread::prepareEstimate()
+{
+    while (!d->device->atEnd()) {
+        const QByteArray line = d->device->readLine();
+        d->localEstimate.addLine(line.constData(), std::size_t(line.size()));
+    }
+    d->device->seek(0);
+    qCDebug(PRINT_THREAD) << "Estimated print time:" << d->localEstimate.totalTime() << "s, layers:" << d->localEstimate.layerCount();
+}
+
+void PrintThread::updateProgress()
+{
+    const std::size_t line = d->lineNumber > 0 ? d->lineNumber - 1 : 0;
+    const double totalTime = d->estimate->totalTime();
+    //Without any move to time, stay with the progress in bytes. Streamed jobs have no total.
+    const bool known = !d->device->isSequential();
+    if (known && totalTime > 0) {
+        d->printProgress = float(d->estimate->timeAt(line) * 100.0 / totalTime);
+    }
+    const int layer = d->estimate->layerAt(line);
+    const int step = int(d->printProgress * 10);
+    if (step == d->progressStep && layer == d->layer) {
+        return;
+    }
+    d->progressStep = step;
+    d->layer = layer;
+    ATCORE_TRACE(PRINT_THREAD, "progress: %f layer: %i", d->printProgress, layer);
+    const qint64 timeLeft = known ? qint64((totalTime - d->estimate->timeAt(line)) * 1000) : -1;
+    emit(printProgressChanged(d->printProgress, layer, d->estimate->layerCount(), timeLeft));
+}
+
 void PrintThread::nextLine()
 {
-    d->cline = d->gcodestream->readLine();
-    qCDebug(PRINT_THREAD) << "Nextline:" << d->cline;
-    d->stillSize -= d->cline.size() + 1; //remove read chars
-    d->printProgress = float(d->totalSize - d->stillSize) * 100.0 / float(d->totalSize);
-    qCDebug(PRINT_THREAD) << "progress:" << QString::number(d->printProgress);
-    emit(printProgressChanged(d->printProgress));
+    const QByteArray line = d->device->readLine();
+    if (d->device->isSequential()) {
+        //Streamed jobs are estimated as they arrive.
+        d->localEstimate.addLine(line.constData(), std::size_t(line.size()));
+    }
+    d->cline = QString::fromLocal8Bit(line);
+    d->lineNumber++;
+    ATCORE_TRACE(PRINT_THREAD, "Nextline: %u %s", d->lineNumber, TraceLogger::text(line));
+    if (d->compressed) {
+        d->stillSize = d->totalSize - d->compressed->compressedPosition();
+    } else {
+        d->stillSize -= line.size(); //remove read chars
+    }
+    if (d->totalSize > 0) {
+        d->printProgress = float(d->totalSize - d->stillSize) * 100.0 / float(d->totalSize);
+    }
     if (d->cline.contains(QChar::fromLatin1(';'))) {
         d->cline.resize(d->cline.indexOf(QChar::fromLatin1(';')));
     }
@@ -145,9 +406,15 @@ void PrintThread::setState(const AtCore::STATES &newState)
     }
     if (newState != d->state) {
         qCDebug(PRINT_THREAD) << "State Changed from [" << d->state << "] to [" << newState << ']';
+        //Nothing may be in flight to call processJob(), go on from here after a pause and end at once on a stop.
+        const bool kick = (d->state == AtCore::PAUSE && newState == AtCore::BUSY)
+                          || newState == AtCore::STOP || newState == AtCore::ERRORSTATE;
         disconnect(d->core, &AtCore::stateChanged, this, &PrintThread::setState);
         d->state = newState;
         emit(stateChanged(d->state));
         connect(d->core, &AtCore::stateChanged, this, &PrintThread::setState, Qt::QueuedConnection);
+        if (kick) {
+            processJob();
+        }
     }
 }
@@ -22,17 +22,18 @@
 */
 #pragma once
 
-#include <QTextStream>
 #include <QFile>
+#include <QIODevice>
 
 #include "atcore.h"
 
 class PrintThreadPrivate;
 /**
  * @brief The PrintThread class
- * A Thread for running a print job
+ * A worker for running print jobs
  *
- * see AtCore::print() for example of how to create a print thread.
+ * AtCore creates one PrintThread per connection, moves it to its own thread
+ * and hands it every job with start(). see AtCore::print() for an example.
  *
  */
 class ATCORE_EXPORT PrintThread : public QObject
@@ -40,11 +41,11 @@ class ATCORE_EXPORT PrintThread : public QObject
     Q_OBJECT
 public:
     /**
-     * @brief Create a new Print Thread
-     * @param parent: Parent of the tread
-     * @param fileName: gcode File to print
+     * @brief Create a new print worker
+     * @param parent: AtCore the jobs are printed on
      */
-    PrintThread(AtCore *parent, QString fileName);
+    explicit PrintThread(AtCore *parent);
+    ~PrintThread() override;
 signals:
     /**
     * @brief Print job has finished
@@ -52,18 +53,28 @@ signals:
     void finished();
 
     /**
-     * @brief A command has caused an error
-     * @param err: the offending command
+     * @brief The job could not be started or read
+     * @param err: description of the error
      */
     void error(QString err);
 
     /**
      * @brief The print job's progress has changed
+     *
+     * Only emitted when the progress moved by 0.1% or the layer changed.
+     * @param progress: estimated time printed over estimated job time, in percent. -1 while the job is streamed,
+     * compressed jobs report the part of the compressed file read
+     * @param layer: layer being printed, 0 before the first layer
+     * @param layerCount: number of layers of the job, of the layers read so far while it is streamed
+     * @param timeLeft: estimated milliseconds left, -1 while the job is streamed
      */
-    void printProgressChanged(float);
+    void printProgressChanged(float progress, int layer, int layerCount, qint64 timeLeft);
 
     /**
      * @brief the next command of the job
+     *
+     * Lines are emitted while they fit in the send window of the firmware, one at a time
+     * if it has none. Call commandDone() for each once it was acknowledged or dropped.
      * @param comm: Command to be sent next
      */
     void nextCommand(const QString &comm);
@@ -74,11 +85,46 @@ signals:
      */
     void stateChanged(const AtCore::STATES &state);
 
+    /**
+     * @brief The start of the job was optimized
+     * @param msecs: time homing and probing ran while heating, an upper bound of the time saved
+     */
+    void jobStartOverlap(qint64 msecs);
+
 public slots:
     /**
-     * @brief start the print thread
+     * @brief start printing a job
+     * May be called again for the next job once finished() was emitted.
+     * @param fileName: gcode File to print, gzip and zstd compressed files are read through CompressedJob
+     * @param optimizeStart: overlap heating with homing and probing, see AtCoreProtocol::optimizeJobStart()
+     * @param hotProbe: the probe needs a hot nozzle
+     * @param sendWindow: bytes the firmware buffers, 0 for one line per acknowledge, see IFirmware::sendWindow()
+     * @param terminatorSize: bytes added to every line when it is written, see IFirmware::lineTerminator()
+     * @param maxLineLength: longest line the firmware accepts, 0 for no limit. A longer line fails the job
      */
-    void start();
+    void start(const QString &fileName, bool optimizeStart = false, bool hotProbe = false, int sendWindow = 0, int terminatorSize = 1, int maxLineLength = 0);
+
+    /**
+     * @brief start printing a job read from \p device
+     *
+     * Sequential devices (pipes, sockets) are read as the job is printed: the job waits
+     * for lines not received yet and ends once \p device emits readChannelFinished()
+     * or is closed. Their total size is unknown, progress is reported by layer.
+     * @param device: device to read the job from, opened read only if it is not open. Deleted when the job ends.
+     * If it can not be opened error() and finished() are emitted and it is deleted
+     * @param optimizeStart: overlap heating with homing and probing, see AtCoreProtocol::optimizeJobStart()
+     * @param hotProbe: the probe needs a hot nozzle
+     * @param sendWindow: bytes the firmware buffers, 0 for one line per acknowledge, see IFirmware::sendWindow()
+     * @param terminatorSize: bytes added to every line when it is written, see IFirmware::lineTerminator()
+     * @param maxLineLength: longest line the firmware accepts, 0 for no limit. A longer line fails the job
+     */
+    void start(QIODevice *device, bool optimizeStart = false, bool hotProbe = false, int sendWindow = 0, int terminatorSize = 1, int maxLineLength = 0);
+    /**
+     * @brief The oldest command emitted with nextCommand() was acknowledged or dropped
+     * Sends more of the job if the send window has room for it.
+     */
+    void commandDone();
+
 private slots:
     /**
      * @brief process the current job
@@ -91,15 +137,66 @@ private slots:
      */
     void setState(const AtCore::STATES &state);
 
+    /**
+     * @brief Go on with the job if it waited for lines
+     * Connect to QIODevice::readyRead
+     */
+    void resumeJob();
+
+    /**
+     * @brief No more lines will arrive, the job ends after the ones received
+     * Connect to QIODevice::readChannelFinished and QIODevice::aboutToClose
+     */
+    void finishInput();
+
 private:
+    /**
+     * @brief True if a whole line, or the last one, can be read
+     */
+    bool lineAvailable() const;
+
+    /**
+     * @brief Read the next command of the job into cline, from the start block first
+     * @return False if no command can be read now
+     */
+    bool fetchCommand();
+
+    /**
+     * @brief True if every line of the job was read, the start block included
+     */
+    bool inputAtEnd() const;
+
     /**
      * @brief parse the next line
      */
     void nextLine();
 
+    /**
+     * @brief Read the start block of the job and rewrite it
+     * @param hotProbe: the probe needs a hot nozzle
+     */
+    void prepareStartBlock(bool hotProbe);
+
+    /**
+     * @brief Estimate time and layer of every line of the job
+     */
+    void prepareEstimate();
+
+    /**
+     * @brief Update the progress for the line about to be sent
+     */
+    void updateProgress();
+
     /**
      * @brief end the print
+     * @param failed: the job ended on an error, the printer is left in AtCore::ERRORSTATE
+     */
+    void endPrint(bool failed = false);
+
+    /**
+     * @brief Give up a job that could not be started, emitting error() and putting AtCore back to IDLE
+     * @param message: why the job could not start
      */
-    void endPrint();
+    void failStart(const QString &message);
     PrintThreadPrivate *d;
 };
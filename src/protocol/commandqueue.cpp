@@ -0,0 +1,352 @@
+/* AtCore
+   Copyright (C) <2026>
+
+   Authors:
+       The AtCore contributors
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+
+#include "commandqueue.h"
+
+namespace
+{
+const std::string _absolute("G90");
+const std::string _relative("G91");
+const std::string _extruderAbsolute("M82");
+const std::string _extruderRelative("M83");
+const std::string _temperatureQuery("M105");
+
+//Distances are summed in millionths of a millimetre, exactly.
+const int _decimals = 6;
+const long long _unit = 1000000;
+const long long _maxUnits = 1000000000LL * _unit;
+
+/**
+ * @brief Read a single axis move "G1 <axis><distance>"
+ * @param command: Command to read
+ * @param axis: axis of the move
+ * @param distance: distance of the move in millionths, moves with more decimals are not read
+ * @return True if \p command is a single axis move
+ */
+bool readMove(const std::string &command, char &axis, long long &distance)
+{
+    if (command.compare(0, 2, "G1") != 0) {
+        return false;
+    }
+    std::size_t i = 2;
+    if (i < command.size() && command[i] == ' ') {
+        i++;
+    }
+    if (i >= command.size() || std::string("XYZE").find(command[i]) == std::string::npos) {
+        return false;
+    }
+    axis = command[i++];
+    if (i < command.size() && command[i] == ' ') {
+        i++;
+    }
+
+    const bool negative = i < command.size() && command[i] == '-';
+    if (negative) {
+        i++;
+    }
+    if (i >= command.size() || command.back() == '.') {
+        return false;
+    }
+    long long units = 0;
+    int decimals = -1;
+    for (; i < command.size(); i++) {
+        if (command[i] == '.' && decimals < 0) {
+            decimals = 0;
+        } else if (command[i] < '0' || command[i] > '9' || decimals == _decimals || units > _maxUnits) {
+            return false;
+        } else {
+            units = units * 10 + (command[i] - '0');
+            if (decimals >= 0) {
+                decimals++;
+            }
+        }
+    }
+    for (int d = std::max(decimals, 0); d < _decimals; d++) {
+        units *= 10;
+    }
+    distance = negative ? -units : units;
+    return true;
+}
+
+/**
+ * @brief Text of \p distance in millionths, without trailing zeros
+ */
+std::string formatDistance(long long distance)
+{
+    const long long units = distance < 0 ? -distance : distance;
+    char buffer[64];
+    std::snprintf(buffer, sizeof(buffer), "%s%lld.%06lld", distance < 0 ? "-" : "", units / _unit, units % _unit);
+    std::string value(buffer);
+    while (value.back() == '0') {
+        value.pop_back();
+    }
+    if (value.back() == '.') {
+        value.pop_back();
+    }
+    return value;
+}
+
+/**
+ * @brief Tool selected by \p command, -1 if it is not a tool change
+ */
+int toolChange(const std::string &command)
+{
+    if (command.size() < 2 || command[0] != 'T') {
+        return -1;
+    }
+    for (std::size_t i = 1; i < command.size(); i++) {
+        if (command[i] < '0' || command[i] > '9') {
+            return -1;
+        }
+    }
+    return std::atoi(command.c_str() + 1);
+}
+
+/**
+ * @brief Key of the heater or fan a setpoint command is for
+ * @param command: Command to check
+ * @param tool: tool active when \p command runs, the heater of M104 without T
+ * @return The key or an empty string if \p command is not a setpoint
+ */
+std::string setpointKey(const std::string &command, int tool)
+{
+    std::deque<std::string> args;
+    std::size_t start = 0;
+    while (start < command.size()) {
+        std::size_t end = command.find(' ', start);
+        if (end == std::string::npos) {
+            end = command.size();
+        }
+        if (end > start) {
+            args.push_back(command.substr(start, end - start));
+        }
+        start = end + 1;
+    }
+    if (args.empty()) {
+        return std::string();
+    }
+
+    const std::string &code = args.front();
+    std::string key;
+    if (code == "M104") {
+        key = "T";
+    } else if (code == "M140") {
+        key = "B";
+    } else if (code == "M106" || code == "M107") {
+        key = "F";
+    } else {
+        return std::string();
+    }
+
+    std::string index(key == "T" ? std::to_string(tool) : std::string("0"));
+    for (std::size_t i = 1; i < args.size(); i++) {
+        const std::string &arg = args[i];
+        if (arg[0] == 'P' || (key == "T" && arg[0] == 'T')) {
+            index = arg.substr(1);
+        }
+    }
+    return key + index;
+}
+}
+
+namespace AtCoreProtocol
+{
+CommandQueue::CommandQueue() :
+    m_sentRelative(false),
+    m_sentExtruderRelative(false),
+    m_sentTool(0),
+    m_sealed(0)
+{
+}
+
+void CommandQueue::append(const std::string &command)
+{
+    if (mergeModeChange(command) || mergeMove(command) || replaceSetpoint(command)) {
+        return;
+    }
+    m_commands.push_back(command);
+}
+
+void CommandQueue::append(const std::vector<std::string> &commands)
+{
+    m_commands.insert(m_commands.end(), commands.begin(), commands.end());
+    seal();
+}
+
+void CommandQueue::seal()
+{
+    m_sealed = m_commands.size();
+}
+
+const std::string &CommandQueue::front() const
+{
+    return m_commands.front();
+}
+
+std::string CommandQueue::takeFirst()
+{
+    const std::string command = m_commands.front();
+    m_commands.pop_front();
+    if (m_sealed > 0) {
+        m_sealed--;
+    }
+    if (command == _relative) {
+        m_sentRelative = true;
+        m_sentExtruderRelative = true;
+    } else if (command == _absolute) {
+        m_sentRelative = false;
+        m_sentExtruderRelative = false;
+    } else if (command == _extruderRelative) {
+        m_sentExtruderRelative = true;
+    } else if (command == _extruderAbsolute) {
+        m_sentExtruderRelative = false;
+    } else if (toolChange(command) >= 0) {
+        m_sentTool = toolChange(command);
+    }
+    return command;
+}
+
+void CommandQueue::clear()
+{
+    m_commands.clear();
+    m_sealed = 0;
+}
+
+bool CommandQueue::isEmpty() const
+{
+    return m_commands.empty();
+}
+
+std::size_t CommandQueue::size() const
+{
+    return m_commands.size();
+}
+
+bool CommandQueue::contains(const std::string &command) const
+{
+    return std::find(m_commands.begin(), m_commands.end(), command) != m_commands.end();
+}
+
+const std::deque<std::string> &CommandQueue::commands() const
+{
+    return m_commands;
+}
+
+bool CommandQueue::relativeAt(std::size_t index, char axis) const
+{
+    //G90 and G91 set every axis, M82 and M83 only the extruder.
+    const bool extruder = axis == 'E';
+    for (std::size_t i = index; i > 0; i--) {
+        const std::string &command = m_commands[i - 1];
+        if (command == _relative) {
+            return true;
+        } else if (command == _absolute) {
+            return false;
+        } else if (extruder && command == _extruderRelative) {
+            return true;
+        } else if (extruder && command == _extruderAbsolute) {
+            return false;
+        }
+    }
+    return extruder ? m_sentExtruderRelative : m_sentRelative;
+}
+
+int CommandQueue::toolAt(std::size_t index) const
+{
+    for (std::size_t i = index; i > 0; i--) {
+        const int tool = toolChange(m_commands[i - 1]);
+        if (tool >= 0) {
+            return tool;
+        }
+    }
+    return m_sentTool;
+}
+
+bool CommandQueue::mergeModeChange(const std::string &command)
+{
+    //G90 G91 is a no-op when the printer was already relative
+    if (command != _relative || m_commands.empty()) {
+        return false;
+    }
+    const std::size_t last = m_commands.size() - 1;
+    if (last < m_sealed || m_commands[last] != _absolute || !relativeAt(last, 'X') || !relativeAt(last, 'E')) {
+        return false;
+    }
+    m_commands.pop_back();
+    return true;
+}
+
+bool CommandQueue::mergeMove(const std::string &command)
+{
+    if (m_commands.empty()) {
+        return false;
+    }
+    const std::size_t last = m_commands.size() - 1;
+    if (last < m_sealed) {
+        return false;
+    }
+    char axis = 0;
+    char pendingAxis = 0;
+    long long distance = 0;
+    long long pendingDistance = 0;
+    if (!readMove(command, axis, distance) || !readMove(m_commands[last], pendingAxis, pendingDistance)
+            || axis != pendingAxis || !relativeAt(last, axis)) {
+        return false;
+    }
+
+    const long long sum = pendingDistance + distance;
+    if (sum == 0) {
+        //The moves cancel each other out.
+        m_commands.pop_back();
+    } else {
+        m_commands[last] = std::string("G1 ") + axis + formatDistance(sum);
+    }
+    return true;
+}
+
+bool CommandQueue::replaceSetpoint(const std::string &command)
+{
+    //Tool changes stop the search, every setpoint looked at runs with the same tool.
+    const int tool = toolAt(m_commands.size());
+    const std::string key = setpointKey(command, tool);
+    if (key.empty()) {
+        return false;
+    }
+    //Only look back over other setpoints, anything else may depend on the pending value.
+    for (std::size_t i = m_commands.size(); i > m_sealed; i--) {
+        std::string &pending = m_commands[i - 1];
+        const std::string pendingKey = setpointKey(pending, tool);
+        if (pendingKey == key) {
+            pending = command;
+            return true;
+        }
+        if (pendingKey.empty() && pending != _temperatureQuery) {
+            return false;
+        }
+    }
+    return false;
+}
+}
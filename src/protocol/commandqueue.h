@@ -0,0 +1,151 @@
+/* AtCore
+   Copyright (C) <2026>
+
+   Authors:
+       The AtCore contributors
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <string>
+#include <vector>
+
+namespace AtCoreProtocol
+{
+/**
+ * @brief The CommandQueue class
+ * Commands waiting to be sent to the printer
+ *
+ * Commands are coalesced while they wait in the queue:
+ * - A relative single axis move (G1) following a pending one on the same axis is merged into it,
+ *   the distances are summed exactly, moves with more than 6 decimals are left alone.
+ *   G90/G91 set the mode of every axis, M82/M83 the mode of the extruder.
+ * - A new setpoint (M104, M140, M106, M107) replaces a pending one for the same heater or fan.
+ *   M104 without T is for the active tool.
+ *
+ * Only the tail of the queue is rewritten and never past a command that
+ * could depend on the old value, so the printer ends up in the same state.
+ * Commands queued before seal() are never rewritten.
+ */
+class CommandQueue
+{
+public:
+    CommandQueue();
+
+    /**
+     * @brief Append \p command to the queue, coalescing it with pending commands if possible
+     * @param command: Command to queue
+     */
+    void append(const std::string &command);
+
+    /**
+     * @brief Append \p commands as they are, in order and sealed
+     *
+     * Neither coalesced with each other nor with the queued commands.
+     * @param commands: Commands to queue
+     */
+    void append(const std::vector<std::string> &commands);
+
+    /**
+     * @brief Keep the commands queued so far as they are, later commands are not merged into them
+     */
+    void seal();
+
+    /**
+     * @brief The next command to send, the queue must not be empty
+     */
+    const std::string &front() const;
+
+    /**
+     * @brief Remove and return the next command to send, the queue must not be empty
+     */
+    std::string takeFirst();
+
+    /**
+     * @brief Remove all commands from the queue
+     */
+    void clear();
+
+    /**
+     * @brief True if there is no command waiting
+     */
+    bool isEmpty() const;
+
+    /**
+     * @brief Number of commands waiting
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief True if \p command is waiting in the queue
+     * @param command: Command to look for
+     */
+    bool contains(const std::string &command) const;
+
+    /**
+     * @brief Commands waiting in the queue, next command first
+     */
+    const std::deque<std::string> &commands() const;
+
+private:
+    CommandQueue(const CommandQueue &) = delete;
+    CommandQueue &operator=(const CommandQueue &) = delete;
+
+    /**
+     * @brief Merge a relative single axis move into the pending one
+     * @param command: Command to merge
+     * @return True if the command was merged
+     */
+    bool mergeMove(const std::string &command);
+
+    /**
+     * @brief Drop a pending G90 when G91 follows it
+     * @param command: Command to check
+     * @return True if the command was absorbed
+     */
+    bool mergeModeChange(const std::string &command);
+
+    /**
+     * @brief Replace a pending setpoint for the same heater or fan
+     * @param command: Command to check
+     * @return True if a pending setpoint was replaced
+     */
+    bool replaceSetpoint(const std::string &command);
+
+    /**
+     * @brief True if \p axis moves are relative when the command at \p index runs.
+     * @param index: Position in the queue
+     * @param axis: X, Y, Z or E
+     */
+    bool relativeAt(std::size_t index, char axis) const;
+
+    /**
+     * @brief Tool active when the command at \p index runs
+     * @param index: Position in the queue
+     */
+    int toolAt(std::size_t index) const;
+
+    std::deque<std::string> m_commands;
+    bool m_sentRelative;
+    bool m_sentExtruderRelative;
+    int m_sentTool;
+    std::size_t m_sealed;
+};
+}
@@ -0,0 +1,168 @@
+/* AtCore
+   Copyright (C) <2026>
+
+   Authors:
+       The AtCore contributors
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+/*
+ * C++20 coroutine support, only available to code built with coroutines.
+ * The library itself is C++11, everything here is inline.
+ */
+#if defined(__cpp_impl_coroutine)
+
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "protocolengine.h"
+
+namespace AtCoreProtocol
+{
+/**
+ * @brief The Routine struct
+ * Return type of a fire and forget coroutine
+ *
+ * The coroutine runs until its first co_await and is resumed from the
+ * completion of the awaited command, on the thread driving the connection.
+ */
+struct Routine {
+    struct promise_type {
+        Routine get_return_object()
+        {
+            return Routine();
+        }
+        std::suspend_never initial_suspend() noexcept
+        {
+            return std::suspend_never();
+        }
+        std::suspend_never final_suspend() noexcept
+        {
+            return std::suspend_never();
+        }
+        void return_void()
+        {
+        }
+        void unhandled_exception()
+        {
+            std::terminate();
+        }
+    };
+};
+
+/**
+ * @brief The Reply struct
+ * Result of an awaited command
+ *
+ * @param Lines: type of the reply lines
+ */
+template<typename Lines>
+struct Reply {
+    Lines lines;            //!< @param lines: lines received for the command
+    bool aborted = false;   //!< @param aborted: the command was dropped before the printer acknowledged it
+
+    /**
+     * @brief True if the printer acknowledged the command
+     */
+    explicit operator bool() const
+    {
+        return !aborted;
+    }
+};
+
+/**
+ * @brief The ReplyAwaiter class
+ * Suspend the coroutine until a command is acknowledged or dropped
+ *
+ * A command dropped by a stop or a firmware reset resumes the coroutine
+ * with Reply::aborted set, the coroutine frame is never left suspended.
+ * @param Lines: type of the reply lines
+ */
+template<typename Lines>
+class ReplyAwaiter
+{
+public:
+    /**
+     * @brief Queue the command, calling the given function once it is acknowledged or dropped
+     */
+    typedef std::function<void(std::function<void(const Lines &lines, bool aborted)>)> Submit;
+
+    /**
+     * @brief Create a new ReplyAwaiter
+     * @param submit: queues the command
+     */
+    explicit ReplyAwaiter(Submit submit) :
+        m_submit(std::move(submit))
+    {
+    }
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+        m_submit([this, handle](const Lines & lines, bool aborted) {
+            m_reply.lines = lines;
+            m_reply.aborted = aborted;
+            handle.resume();
+        });
+    }
+
+    Reply<Lines> await_resume()
+    {
+        return std::move(m_reply);
+    }
+
+private:
+    Submit m_submit;
+    Reply<Lines> m_reply;
+};
+
+/**
+ * @brief Send \p command, co_await returns once the printer acknowledged it
+ * @param engine: engine of the connection
+ * @param command: Command to send
+ * @return awaiter resolving to the reply
+ */
+inline ReplyAwaiter<std::vector<std::string>> send(ProtocolEngine &engine, const std::string &command)
+{
+    return ReplyAwaiter<std::vector<std::string>>([&engine, command](ProtocolEngine::Completion completion) {
+        engine.submit(command, completion);
+    });
+}
+
+/**
+ * @brief Send a command answering with data, ex M114, co_await returns the reply lines
+ * @param engine: engine of the connection
+ * @param command: Command to send
+ * @return awaiter resolving to the reply
+ */
+inline ReplyAwaiter<std::vector<std::string>> query(ProtocolEngine &engine, const std::string &command)
+{
+    return send(engine, command);
+}
+}
+
+#endif
@@ -0,0 +1,80 @@
+/* AtCore
+   Copyright (C) <2026>
+
+   Authors:
+       The AtCore contributors
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "dialect.h"
+
+namespace
+{
+/**
+ * @brief Replace every \p from in \p command by \p to
+ * @return True if \p from was found
+ */
+bool replace(std::string &command, const std::string &from, const std::string &to)
+{
+    bool found = false;
+    for (std::size_t pos = command.find(from); pos != std::string::npos; pos = command.find(from, pos + to.size())) {
+        command.replace(pos, from.size(), to);
+        found = true;
+    }
+    return found;
+}
+}
+
+namespace AtCoreProtocol
+{
+Dialect Dialect::generic()
+{
+    Dialect dialect;
+    dialect.name = "Generic";
+    dialect.isAcknowledge = [](const std::string & line) {
+        return line.find("ok") != std::string::npos;
+    };
+    dialect.translate = [](const std::string & command) {
+        return command;
+    };
+    return dialect;
+}
+
+Dialect Dialect::grbl()
+{
+    Dialect dialect = generic();
+    dialect.name = "Grbl";
+    dialect.isAcknowledge = [](const std::string & line) {
+        return line.compare(0, 2, "ok") == 0 || line.compare(0, 6, "error:") == 0;
+    };
+    return dialect;
+}
+
+Dialect Dialect::teacup()
+{
+    Dialect dialect = generic();
+    dialect.name = "Teacup";
+    dialect.translate = [](const std::string & command) {
+        std::string temp = command;
+        if (replace(temp, "M109", "M104") || replace(temp, "M190", "M140")) {
+            temp.append("\r\nM116");
+        }
+        return temp;
+    };
+    return dialect;
+}
+}
@@ -0,0 +1,65 @@
+/* AtCore
+   Copyright (C) <2026>
+
+   Authors:
+       The AtCore contributors
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <functional>
+#include <string>
+
+namespace AtCoreProtocol
+{
+/**
+ * @brief The Dialect struct
+ * What sets a firmware apart at the protocol level
+ */
+struct Dialect {
+    /**
+     * @brief True if \p line tells the firmware is ready for the next command
+     */
+    typedef std::function<bool(const std::string &line)> AcknowledgeCheck;
+
+    /**
+     * @brief Rewrite a command into what the firmware understands
+     */
+    typedef std::function<std::string(const std::string &command)> Translator;
+
+    std::string name;               //!< @param name: name of the firmware
+    AcknowledgeCheck isAcknowledge; //!< @param isAcknowledge: check for the acknowledge line
+    Translator translate;           //!< @param translate: command translation
+
+    /**
+     * @brief Dialect of firmwares answering "ok" and taking commands as they are
+     */
+    static Dialect generic();
+
+    /**
+     * @brief Dialect of Teacup, waits for temperature with M116
+     */
+    static Dialect teacup();
+
+    /**
+     * @brief Dialect of Grbl, answers every line with "ok" or "error:"
+     * Meant to be used with a send window, see ProtocolEngine::setSendWindow()
+     */
+    static Dialect grbl();
+};
+}
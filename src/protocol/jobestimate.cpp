@@ -0,0 +1,186 @@
+/* AtCore
+   Copyright (C) <2026>
+
+   Authors:
+       The AtCore contributors
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+#include "jobestimate.h"
+
+namespace
+{
+const double _defaultFeedrate = 1500;
+const char _axes[] = {'X', 'Y', 'Z', 'E'};
+
+/**
+ * @brief True if \p line starts with \p prefix
+ */
+bool startsWith(const char *line, std::size_t length, const char *prefix)
+{
+    const std::size_t prefixLength = std::strlen(prefix);
+    return length >= prefixLength && std::memcmp(line, prefix, prefixLength) == 0;
+}
+
+/**
+ * @brief Read the value of parameter \p letter
+ * @return True if the parameter was found
+ */
+bool parameter(const std::string &command, char letter, double &value)
+{
+    for (std::size_t i = command.find(' '); i != std::string::npos; i = command.find(' ', i + 1)) {
+        if (i + 1 < command.size() && command[i + 1] == letter) {
+            value = std::strtod(command.c_str() + i + 2, nullptr);
+            return true;
+        }
+    }
+    return false;
+}
+}
+
+namespace AtCoreProtocol
+{
+JobEstimate::JobEstimate()
+{
+    clear();
+}
+
+void JobEstimate::clear()
+{
+    m_times.clear();
+    m_layerStarts.clear();
+    m_time = 0;
+    std::fill(m_position, m_position + 4, 0.0);
+    m_feedrate = _defaultFeedrate;
+    m_layerZ = 0;
+    m_relative = false;
+    m_relativeExtrusion = false;
+    m_layerComments = false;
+}
+
+void JobEstimate::newLayer()
+{
+    m_layerStarts.push_back(m_times.size());
+}
+
+void JobEstimate::addLine(const char *line, std::size_t length)
+{
+    while (length > 0 && (*line == ' ' || *line == '\t')) {
+        line++;
+        length--;
+    }
+    if (startsWith(line, length, ";LAYER:") || startsWith(line, length, ";LAYER_CHANGE")) {
+        if (!m_layerComments) {
+            //Comments win over the Z heuristic.
+            m_layerComments = true;
+            m_layerStarts.clear();
+        }
+        newLayer();
+    }
+
+    const char *comment = static_cast<const char *>(std::memchr(line, ';', length));
+    std::string command(line, comment ? std::size_t(comment - line) : length);
+    while (!command.empty() && (command.back() == ' ' || command.back() == '\r' || command.back() == '\n')) {
+        command.pop_back();
+    }
+    const std::string code = command.substr(0, command.find(' '));
+
+    if (code == "G0" || code == "G1" || code == "G2" || code == "G3") {
+        double feedrate = 0;
+        if (parameter(command, 'F', feedrate) && feedrate > 0) {
+            m_feedrate = feedrate;
+        }
+        double delta[4] = {0, 0, 0, 0};
+        for (int axis = 0; axis < 4; axis++) {
+            double value = 0;
+            if (!parameter(command, _axes[axis], value)) {
+                continue;
+            }
+            const bool relative = axis == 3 ? m_relativeExtrusion : m_relative;
+            delta[axis] = relative ? value : value - m_position[axis];
+            m_position[axis] += delta[axis];
+        }
+        //Arcs are counted as their chord.
+        double distance = std::sqrt(delta[0] * delta[0] + delta[1] * delta[1] + delta[2] * delta[2]);
+        if (distance == 0) {
+            distance = std::fabs(delta[3]);
+        }
+        m_time += distance / (m_feedrate / 60.0);
+        if (!m_layerComments && delta[3] > 0 && m_position[2] > m_layerZ + 1e-4) {
+            m_layerZ = m_position[2];
+            newLayer();
+        }
+    } else if (code == "G4") {
+        double value = 0;
+        if (parameter(command, 'P', value)) {
+            m_time += value / 1000.0;
+        } else if (parameter(command, 'S', value)) {
+            m_time += value;
+        }
+    } else if (code == "G90") {
+        m_relative = false;
+        m_relativeExtrusion = false;
+    } else if (code == "G91") {
+        m_relative = true;
+        m_relativeExtrusion = true;
+    } else if (code == "M82") {
+        m_relativeExtrusion = false;
+    } else if (code == "M83") {
+        m_relativeExtrusion = true;
+    } else if (code == "G92") {
+        for (int axis = 0; axis < 4; axis++) {
+            parameter(command, _axes[axis], m_position[axis]);
+        }
+    } else if (code == "G28") {
+        m_position[0] = m_position[1] = m_position[2] = 0;
+    }
+    m_times.push_back(float(m_time));
+}
+
+std::size_t JobEstimate::lineCount() const
+{
+    return m_times.size();
+}
+
+double JobEstimate::timeAt(std::size_t line) const
+{
+    if (m_times.empty()) {
+        return 0;
+    }
+    return m_times[std::min(line, m_times.size() - 1)];
+}
+
+double JobEstimate::totalTime() const
+{
+    return m_time;
+}
+
+int JobEstimate::layerAt(std::size_t line) const
+{
+    return int(std::upper_bound(m_layerStarts.begin(), m_layerStarts.end(), line) - m_layerStarts.begin());
+}
+
+int JobEstimate::layerCount() const
+{
+    return int(m_layerStarts.size());
+}
+}
@@ -0,0 +1,110 @@
+/* AtCore
+   Copyright (C) <2026>
+
+   Authors:
+       The AtCore contributors
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace AtCoreProtocol
+{
+/**
+ * @brief The JobEstimate class
+ * Estimated time and layer of every line of a print job
+ *
+ * Built once when the job is prepared by feeding it every line of the job.
+ * Moves take their length over their feedrate, dwells their time, acceleration
+ * and heating are not accounted for. Layers come from the slicer's layer
+ * comments (";LAYER:", ";LAYER_CHANGE") or else from Z going up before an extrusion.
+ */
+class JobEstimate
+{
+public:
+    JobEstimate();
+
+    /**
+     * @brief Add the next line of the job
+     * @param line: line as read from the job, comments allowed
+     * @param length: length of the line
+     */
+    void addLine(const char *line, std::size_t length);
+
+    /**
+     * @brief Add the next line of the job
+     * @param line: line as read from the job, comments allowed
+     */
+    void addLine(const std::string &line)
+    {
+        addLine(line.data(), line.size());
+    }
+
+    /**
+     * @brief Forget the job
+     */
+    void clear();
+
+    /**
+     * @brief Number of lines added
+     */
+    std::size_t lineCount() const;
+
+    /**
+     * @brief Estimated seconds from the start of the job until \p line is done
+     * @param line: index of the line
+     */
+    double timeAt(std::size_t line) const;
+
+    /**
+     * @brief Estimated seconds the whole job takes
+     */
+    double totalTime() const;
+
+    /**
+     * @brief Layer \p line is in, starting at 1. 0 before the first layer
+     * @param line: index of the line
+     */
+    int layerAt(std::size_t line) const;
+
+    /**
+     * @brief Number of layers of the job
+     */
+    int layerCount() const;
+
+private:
+    /**
+     * @brief Start a new layer at the current line
+     */
+    void newLayer();
+
+    std::vector<float> m_times;             //!< @param m_times: seconds until the end of each line
+    std::vector<std::size_t> m_layerStarts; //!< @param m_layerStarts: first line of each layer
+    double m_time;                          //!< @param m_time: seconds until the end of the last line
+    double m_position[4];                   //!< @param m_position: X Y Z E
+    double m_feedrate;                      //!< @param m_feedrate: mm/min
+    double m_layerZ;                        //!< @param m_layerZ: Z of the last layer found by the heuristic
+    bool m_relative;                        //!< @param m_relative: moves are relative (G91)
+    bool m_relativeExtrusion;               //!< @param m_relativeExtrusion: extrusion is relative (M83)
+    bool m_layerComments;                   //!< @param m_layerComments: the job has layer comments
+};
+}
@@ -0,0 +1,193 @@
+/* AtCore
+   Copyright (C) <2026>
+
+   Authors:
+       The AtCore contributors
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <algorithm>
+
+#include "jobstart.h"
+
+namespace
+{
+/**
+ * @brief First word of \p line, ex "G1"
+ */
+std::string code(const std::string &line)
+{
+    return line.substr(0, line.find(' '));
+}
+
+/**
+ * @brief True if \p line has a parameter starting with \p letter
+ */
+bool hasParameter(const std::string &line, char letter)
+{
+    for (std::size_t i = line.find(' '); i != std::string::npos && i + 1 < line.size(); i = line.find(' ', i + 1)) {
+        if (line[i + 1] == letter) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool isProbe(const std::string &command)
+{
+    return command == "G29" || command == "G30" || command == "G32" || command == "M48";
+}
+
+/**
+ * @brief True if \p command changes what the heater waited on by \p wait heats to
+ * @param wait: "M190" or "M109"
+ */
+bool isBarrier(const std::string &wait, const std::string &command)
+{
+    if (wait == "M190") {
+        return command == "M140" || command == "M190";
+    }
+    return command == "M104" || command == "M109"
+           || (command.size() > 1 && command[0] == 'T' && command.find_first_not_of("0123456789", 1) == std::string::npos);
+}
+
+/**
+ * @brief Find the first wait \p wait with a S parameter before \p end
+ * @return its index or std::string::npos
+ */
+std::size_t findWait(const std::vector<std::string> &lines, const std::string &wait, std::size_t end)
+{
+    for (std::size_t i = 0; i < end; i++) {
+        if (code(lines[i]) == wait) {
+            return hasParameter(lines[i], 'S') ? i : std::string::npos;
+        }
+    }
+    return std::string::npos;
+}
+
+/**
+ * @brief Where the setpoint of the wait at \p index may be moved up to, it is inserted before that index
+ *
+ * The setpoint stays after tool changes, so it heats the tool the wait was for.
+ */
+std::size_t setpointTarget(const std::vector<std::string> &lines, std::size_t index)
+{
+    const std::string wait = code(lines[index]);
+    for (std::size_t i = index; i > 0; i--) {
+        if (isBarrier(wait, code(lines[i - 1]))) {
+            return i;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Where the wait at \p index may be moved to, the wait is inserted before that index
+ */
+std::size_t waitTarget(const std::vector<std::string> &lines, std::size_t index, std::size_t extrusion, bool beforeProbe)
+{
+    const std::string wait = code(lines[index]);
+    for (std::size_t i = index + 1; i < extrusion; i++) {
+        const std::string command = code(lines[i]);
+        if (isBarrier(wait, command) || (beforeProbe && isProbe(command))) {
+            return i;
+        }
+    }
+    return extrusion;
+}
+}
+
+namespace AtCoreProtocol
+{
+bool isExtrusion(const std::string &line)
+{
+    const std::string command = code(line);
+    if (command != "G1" && command != "G0" && command != "G2" && command != "G3") {
+        return false;
+    }
+    //Retracts too: the firmware refuses any cold E move, waits stay ahead of them.
+    return line.find(" E") != std::string::npos;
+}
+
+bool optimizeJobStart(std::vector<std::string> &lines, const JobStartOptions &options, std::size_t *firstWait)
+{
+    std::size_t extrusion = 0;
+    while (extrusion < lines.size() && extrusion < options.maxLines && !isExtrusion(lines[extrusion])) {
+        extrusion++;
+    }
+    if (extrusion == lines.size() || extrusion == options.maxLines) {
+        return false;
+    }
+
+    const std::size_t bedWait = findWait(lines, "M190", extrusion);
+    const std::size_t hotendWait = findWait(lines, "M109", extrusion);
+    if (bedWait == std::string::npos && hotendWait == std::string::npos) {
+        return false;
+    }
+
+    //Setpoints and waits keyed by the index they go before.
+    std::vector<std::pair<std::size_t, std::string>> setpoints;
+    std::vector<std::pair<std::size_t, std::size_t>> waits;
+    bool moved = false;
+    const std::size_t found[] = {bedWait, hotendWait};
+    for (std::size_t wait : found) {
+        if (wait == std::string::npos) {
+            continue;
+        }
+        const bool beforeProbe = wait == bedWait || options.hotProbe;
+        const std::size_t target = waitTarget(lines, wait, extrusion, beforeProbe);
+        moved = moved || target > wait + 1;
+        waits.push_back(std::make_pair(target, wait));
+        setpoints.push_back(std::make_pair(setpointTarget(lines, wait), (wait == bedWait ? "M140" : "M104") + lines[wait].substr(4)));
+    }
+    if (!moved) {
+        return false;
+    }
+    //Bed first where both go to the same place.
+    std::stable_sort(setpoints.begin(), setpoints.end(), [](const std::pair<std::size_t, std::string> & a, const std::pair<std::size_t, std::string> & b) {
+        return a.first < b.first;
+    });
+    std::sort(waits.begin(), waits.end());
+
+    std::vector<std::string> rewritten;
+    rewritten.reserve(lines.size() + setpoints.size());
+    std::size_t nextSetpoint = 0;
+    std::size_t next = 0;
+    std::size_t first = lines.size() + setpoints.size();
+    for (std::size_t i = 0; i <= lines.size(); i++) {
+        //Heating starts before anything else waits at the same place.
+        while (nextSetpoint < setpoints.size() && setpoints[nextSetpoint].first == i) {
+            rewritten.push_back(setpoints[nextSetpoint++].second);
+        }
+        while (next < waits.size() && waits[next].first == i) {
+            first = std::min(first, rewritten.size());
+            rewritten.push_back(lines[waits[next++].second]);
+        }
+        if (i == lines.size()) {
+            break;
+        }
+        if (i != bedWait && i != hotendWait) {
+            rewritten.push_back(lines[i]);
+        }
+    }
+    lines.swap(rewritten);
+    if (firstWait) {
+        *firstWait = first;
+    }
+    return true;
+}
+}
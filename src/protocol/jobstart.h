@@ -0,0 +1,62 @@
+/* AtCore
+   Copyright (C) <2026>
+
+   Authors:
+       The AtCore contributors
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace AtCoreProtocol
+{
+/**
+ * @brief Options of optimizeJobStart()
+ */
+struct JobStartOptions {
+    bool hotProbe = false;          //!< @param hotProbe: the probe needs a hot nozzle, ex nozzle contact probes
+    std::size_t maxLines = 1000;    //!< @param maxLines: longest start block looked at, in lines
+};
+
+/**
+ * @brief True if \p line is a move of the extruder, retracts included
+ * @param line: command without comment
+ */
+bool isExtrusion(const std::string &line);
+
+/**
+ * @brief Rewrite the start block of a job so heating overlaps homing and probing
+ *
+ * \p lines is the start of the job up to and including its first extrusion.
+ * The targets of the first M190 and M109 are set as early as possible with M140 and M104,
+ * the waits are moved down to the first extrusion. Safety rules:
+ * - The bed wait stays before any probing (G29, G30, G32, M48), the bed must have expanded.
+ * - With JobStartOptions::hotProbe the hotend wait stays before probing too.
+ * - A wait never moves past another setpoint for the same heater or a tool change.
+ * - A setpoint never moves up past those either, M104 heats the tool its wait was for.
+ * - Cooling waits (R parameter) are left alone.
+ * @param lines: commands without comments, rewritten in place
+ * @param options: options of the rewrite
+ * @param firstWait: set to the index of the first wait left, if not null
+ * @return True if \p lines was rewritten, false if no wait could be moved
+ */
+bool optimizeJobStart(std::vector<std::string> &lines, const JobStartOptions &options = JobStartOptions(), std::size_t *firstWait = nullptr);
+}
@@ -0,0 +1,65 @@
+/* AtCore
+   Copyright (C) <2026>
+
+   Authors:
+       The AtCore contributors
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <cstring>
+
+#include "lineframer.h"
+
+namespace AtCoreProtocol
+{
+LineFramer::LineFramer(LineHandler handler) :
+    m_handler(handler)
+{
+}
+
+void LineFramer::setLineHandler(LineHandler handler)
+{
+    m_handler = handler;
+}
+
+void LineFramer::feed(const char *data, std::size_t size)
+{
+    const char *end = data + size;
+    while (data < end) {
+        const char *newLine = static_cast<const char *>(std::memchr(data, '\n', std::size_t(end - data)));
+        const char *stop = newLine ? newLine : end;
+        for (const char *c = data; c < stop; ++c) {
+            if (*c != '\r') {
+                m_partial.push_back(*c);
+            }
+        }
+        if (!newLine) {
+            break;
+        }
+        if (m_handler) {
+            m_handler(m_partial);
+        }
+        m_partial.clear();
+        data = newLine + 1;
+    }
+}
+
+void LineFramer::reset()
+{
+    m_partial.clear();
+}
+}
@@ -0,0 +1,73 @@
+/* AtCore
+   Copyright (C) <2026>
+
+   Authors:
+       The AtCore contributors
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+
+namespace AtCoreProtocol
+{
+/**
+ * @brief The LineFramer class
+ * Split the raw byte stream of a device into lines
+ *
+ * Both "\n" and "\n\r" line ends are accepted, '\r' is dropped.
+ */
+class LineFramer
+{
+public:
+    /**
+     * @brief Called for every complete line, without line end
+     */
+    typedef std::function<void(const std::string &line)> LineHandler;
+
+    /**
+     * @brief Create a new LineFramer
+     * @param handler: called for every complete line
+     */
+    explicit LineFramer(LineHandler handler = LineHandler());
+
+    /**
+     * @brief Set the function called for every complete line
+     * @param handler: line handler
+     */
+    void setLineHandler(LineHandler handler);
+
+    /**
+     * @brief Feed bytes read from the device
+     * @param data: bytes read
+     * @param size: number of bytes
+     */
+    void feed(const char *data, std::size_t size);
+
+    /**
+     * @brief Drop the incomplete line that is being collected
+     */
+    void reset();
+
+private:
+    LineHandler m_handler;
+    std::string m_partial;
+};
+}
@@ -0,0 +1,179 @@
+/* AtCore
+   Copyright (C) <2026>
+
+   Authors:
+       The AtCore contributors
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <cstring>
+
+#include "meatpack.h"
+
+namespace
+{
+const unsigned char _literal = 0xF;
+const unsigned char _signal = 0xFF;
+const char _codes[] = "0123456789. \nGX";
+
+//Commands whose text is kept as written.
+const char *const _textCommands[] = {"M23", "M28", "M30", "M32", "M117", "M118", "M928"};
+
+unsigned char code(char c, bool noSpaces)
+{
+    if (c >= '0' && c <= '9') {
+        return static_cast<unsigned char>(c - '0');
+    }
+    switch (c) {
+    case '.':
+        return 10;
+    case ' ':
+        return noSpaces ? _literal : 11;
+    case 'E':
+        return noSpaces ? 11 : _literal;
+    case '\n':
+        return 12;
+    case 'G':
+        return 13;
+    case 'X':
+        return 14;
+    default:
+        return _literal;
+    }
+}
+
+char character(unsigned char code, bool noSpaces)
+{
+    if (code == 11 && noSpaces) {
+        return 'E';
+    }
+    return _codes[code];
+}
+
+bool isTextCommand(const std::string &line)
+{
+    for (const char *command : _textCommands) {
+        const std::size_t length = std::strlen(command);
+        if (line.compare(0, length, command) == 0 && (line.size() == length || line.at(length) < '0' || line.at(length) > '9')) {
+            return true;
+        }
+    }
+    return false;
+}
+}
+
+namespace AtCoreProtocol
+{
+std::string MeatPack::command(Command command)
+{
+    std::string bytes(2, char(_signal));
+    bytes.push_back(char(command));
+    return bytes;
+}
+
+std::string MeatPack::minimize(const std::string &line, bool noSpaces)
+{
+    std::string text = line.substr(0, line.find(';'));
+    const std::size_t begin = text.find_first_not_of(" \t\r\n");
+    if (begin == std::string::npos) {
+        return std::string();
+    }
+    text = text.substr(begin, text.find_last_not_of(" \t\r\n") - begin + 1);
+    if (isTextCommand(text)) {
+        return text;
+    }
+    std::string result;
+    result.reserve(text.size());
+    for (char c : text) {
+        if (c == ' ' || c == '\t') {
+            if (noSpaces || result.empty() || result.back() == ' ') {
+                continue;
+            }
+            c = ' ';
+        }
+        result.push_back(c);
+    }
+    return result;
+}
+
+std::string MeatPack::pack(const std::string &line, bool noSpaces)
+{
+    std::string text = line;
+    text.push_back('\n');
+    //A line end in the low bits ends the byte, the firmware skips the high bits.
+    if (text.size() % 2) {
+        text.push_back('\n');
+    }
+    std::string bytes;
+    bytes.reserve(text.size());
+    for (std::size_t i = 0; i < text.size(); i += 2) {
+        const unsigned char first = code(text.at(i), noSpaces);
+        const unsigned char second = code(text.at(i + 1), noSpaces);
+        bytes.push_back(char(first | (second << 4)));
+        if (first == _literal) {
+            bytes.push_back(text.at(i));
+        }
+        if (second == _literal) {
+            bytes.push_back(text.at(i + 1));
+        }
+    }
+    return bytes;
+}
+
+std::string MeatPack::unpack(const std::string &data, bool noSpaces)
+{
+    std::string text;
+    bool packing = false;
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        const unsigned char byte = static_cast<unsigned char>(data.at(i));
+        if (byte == _signal && i + 2 < data.size() && static_cast<unsigned char>(data.at(i + 1)) == _signal) {
+            switch (static_cast<unsigned char>(data.at(i + 2))) {
+            case EnablePacking:
+                packing = true;
+                break;
+            case DisablePacking:
+            case ResetAll:
+                packing = false;
+                break;
+            case EnableNoSpaces:
+                noSpaces = true;
+                break;
+            case DisableNoSpaces:
+                noSpaces = false;
+                break;
+            default:
+                break;
+            }
+            i += 2;
+            continue;
+        }
+        if (!packing) {
+            text.push_back(char(byte));
+            continue;
+        }
+        const unsigned char first = byte & 0xF;
+        const unsigned char second = byte >> 4;
+        const char firstChar = first == _literal && i + 1 < data.size() ? data.at(++i) : character(first, noSpaces);
+        text.push_back(firstChar);
+        //The high bits of a byte ending a line are skipped.
+        if (first != 12) {
+            text.push_back(second == _literal && i + 1 < data.size() ? data.at(++i) : character(second, noSpaces));
+        }
+    }
+    return text;
+}
+}
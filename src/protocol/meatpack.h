@@ -0,0 +1,84 @@
+/* AtCore
+   Copyright (C) <2026>
+
+   Authors:
+       The AtCore contributors
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <string>
+
+namespace AtCoreProtocol
+{
+/**
+ * @brief The MeatPack class
+ * Packing of commands for firmwares built with MeatPack (Marlin)
+ *
+ * The 15 most common characters of G-code ("0"-"9", ".", " ", "\n", "G" and "X")
+ * are sent as 4 bit codes, two in a byte, the first one in the low bits. Other
+ * characters are sent whole in the byte after their code 0xF. In no spaces mode
+ * the space code stands for "E" and spaces are left out.
+ * Control commands are sent as 0xFF 0xFF command, packing or not.
+ */
+class MeatPack
+{
+public:
+    /**
+     * @brief MeatPack control commands
+     */
+    enum Command {
+        EnablePacking   = 0xFB,
+        DisablePacking  = 0xFA,
+        ResetAll        = 0xF9,
+        QueryConfig     = 0xF8,
+        EnableNoSpaces  = 0xF7,
+        DisableNoSpaces = 0xF6,
+    };
+
+    /**
+     * @brief Bytes sending \p command
+     */
+    static std::string command(Command command);
+
+    /**
+     * @brief Strip the comment and the spaces not needed from \p line
+     *
+     * Spaces are kept in the text of commands taking one, ex M117 or M23.
+     * @param line: command, comments allowed
+     * @param noSpaces: leave out every space between words
+     */
+    static std::string minimize(const std::string &line, bool noSpaces = false);
+
+    /**
+     * @brief Pack \p line and its line end
+     * @param line: command without line end, see minimize()
+     * @param noSpaces: the firmware is in no spaces mode
+     * @return bytes to write, line end included
+     */
+    static std::string pack(const std::string &line, bool noSpaces = false);
+
+    /**
+     * @brief Unpack what pack() wrote, as the firmware reads it
+     * @param data: packed lines, control commands allowed
+     * @param noSpaces: the firmware is in no spaces mode
+     * @return lines read, each one ended by "\n"
+     */
+    static std::string unpack(const std::string &data, bool noSpaces = false);
+};
+}
@@ -0,0 +1,221 @@
+/* AtCore
+   Copyright (C) <2026>
+
+   Authors:
+       The AtCore contributors
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <cstdlib>
+#include <cstring>
+
+#include "messages.h"
+
+namespace
+{
+bool startsWith(const char *line, std::size_t length, const char *prefix)
+{
+    const std::size_t prefixLength = std::strlen(prefix);
+    return length >= prefixLength && std::memcmp(line, prefix, prefixLength) == 0;
+}
+
+/**
+ * @brief Find \p key in \p line
+ * @return position right after key or nullptr
+ */
+const char *find(const char *line, std::size_t length, const char *key)
+{
+    const std::size_t keyLength = std::strlen(key);
+    if (length < keyLength) {
+        return nullptr;
+    }
+    const char *last = line + length - keyLength;
+    for (const char *c = line; c <= last; ++c) {
+        if (*c == key[0] && std::memcmp(c, key, keyLength) == 0) {
+            return c + keyLength;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Read a number at \p begin, stopping at \p end
+ * @param value: number read
+ * @return position after the number or \p begin if there is none
+ */
+const char *readNumber(const char *begin, const char *end, float &value)
+{
+    char buffer[32];
+    std::size_t size = 0;
+    const char *c = begin;
+    if (c < end && *c == '-') {
+        buffer[size++] = *c++;
+    }
+    bool digits = false;
+    while (c < end && size < sizeof(buffer) - 1 && ((*c >= '0' && *c <= '9') || *c == '.')) {
+        digits = digits || *c != '.';
+        buffer[size++] = *c++;
+    }
+    if (!digits) {
+        return begin;
+    }
+    buffer[size] = '\0';
+    value = float(std::strtod(buffer, nullptr));
+    return c;
+}
+
+/**
+ * @brief Read up to \p count numbers separated by ',' following a key
+ * @return number of values read
+ */
+int readList(const char *begin, const char *end, double *values, int count)
+{
+    int read = 0;
+    const char *c = begin;
+    while (read < count) {
+        float value = 0;
+        const char *next = readNumber(c, end, value);
+        if (next == c) {
+            break;
+        }
+        values[read++] = value;
+        if (next >= end || *next != ',') {
+            break;
+        }
+        c = next + 1;
+    }
+    return read;
+}
+
+/**
+ * @brief Read the "value /target" block following a "T:" or "B:" key
+ * @return true if a value was found
+ */
+bool readBlock(const char *begin, const char *end, float &value, float &target)
+{
+    const char *c = readNumber(begin, end, value);
+    if (c == begin) {
+        return false;
+    }
+    while (c < end && *c == ' ') {
+        ++c;
+    }
+    target = 0;
+    if (c < end && *c == '/') {
+        readNumber(c + 1, end, target);
+    }
+    return true;
+}
+}
+
+namespace AtCoreProtocol
+{
+int classifyMessage(const char *line, std::size_t length)
+{
+    int flags = NoMessage;
+    if (startsWith(line, length, "ok")) {
+        flags |= Acknowledge;
+    }
+    if (startsWith(line, length, "Error") || startsWith(line, length, "error") || startsWith(line, length, "!!")) {
+        flags |= Error;
+    }
+    if (startsWith(line, length, "Resend:") || startsWith(line, length, "rs ")) {
+        flags |= Resend;
+    }
+    if (startsWith(line, length, "echo:busy") || startsWith(line, length, "wait")) {
+        flags |= Busy;
+    }
+    if (startsWith(line, length, "start")) {
+        flags |= Start;
+    }
+    if (startsWith(line, length, "X:")) {
+        flags |= Position;
+    }
+    if (startsWith(line, length, "Cap:")) {
+        flags |= Capability;
+    }
+    if (startsWith(line, length, "<")) {
+        return flags | Status;
+    }
+    if (find(line, length, "FIRMWARE_NAME:")) {
+        flags |= FirmwareInfo;
+    } else if (find(line, length, "T:") || find(line, length, "B:")) {
+        flags |= Temperature;
+    }
+    return flags;
+}
+
+bool parseTemperature(const char *line, std::size_t length, TemperatureReport &report)
+{
+    const char *end = line + length;
+    const char *extruder = find(line, length, "T:");
+    const char *bed = find(line, length, "B:");
+    if (extruder) {
+        report.hasExtruder = readBlock(extruder, end, report.extruder, report.extruderTarget);
+    }
+    if (bed) {
+        report.hasBed = readBlock(bed, end, report.bed, report.bedTarget);
+    }
+    return report.hasExtruder || report.hasBed;
+}
+
+bool parseGrblStatus(const char *line, std::size_t length, GrblStatus &status)
+{
+    if (length < 2 || line[0] != '<') {
+        return false;
+    }
+    const char *end = line + length;
+    const char *c = line + 1;
+    while (c < end && *c != '|' && *c != ',' && *c != '>') {
+        ++c;
+    }
+    status.state.assign(line + 1, c);
+
+    const std::size_t rest = std::size_t(end - c);
+    if (const char *position = find(c, rest, "MPos:")) {
+        status.hasMachinePosition = readList(position, end, status.machinePosition, 3) == 3;
+    }
+    if (const char *position = find(c, rest, "WPos:")) {
+        status.hasWorkPosition = readList(position, end, status.workPosition, 3) == 3;
+    }
+    double offset[3] = {0, 0, 0};
+    const char *workOffset = find(c, rest, "WCO:");
+    if (!status.hasWorkPosition && status.hasMachinePosition && workOffset && readList(workOffset, end, offset, 3) == 3) {
+        for (int axis = 0; axis < 3; axis++) {
+            status.workPosition[axis] = status.machinePosition[axis] - offset[axis];
+        }
+        status.hasWorkPosition = true;
+    }
+    double values[2] = {0, 0};
+    if (const char *buffer = find(c, rest, "Bf:")) {
+        if (readList(buffer, end, values, 2) == 2) {
+            status.plannerBlocks = int(values[0]);
+            status.rxBytes = int(values[1]);
+        }
+    }
+    if (const char *feed = find(c, rest, "FS:")) {
+        const int read = readList(feed, end, values, 2);
+        status.hasFeed = read > 0;
+        status.feed = values[0];
+        status.spindle = read > 1 ? values[1] : 0;
+    } else if (const char *feedOnly = find(c, rest, "F:")) {
+        status.hasFeed = readList(feedOnly, end, values, 1) == 1;
+        status.feed = values[0];
+    }
+    return true;
+}
+}
@@ -0,0 +1,140 @@
+/* AtCore
+   Copyright (C) <2026>
+
+   Authors:
+       The AtCore contributors
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace AtCoreProtocol
+{
+/**
+ * @brief Kinds of information a line from the printer can carry
+ * A line can carry several, ex "ok T:20 /0 B:20 /0"
+ */
+enum MessageFlags {
+    NoMessage       = 0,
+    Acknowledge     = 1 << 0,   //!< Starts with "ok"
+    Error           = 1 << 1,   //!< Starts with "Error" or "error"
+    Resend          = 1 << 2,   //!< Resend request ("Resend:" or "rs")
+    Busy            = 1 << 3,   //!< "echo:busy" or "wait"
+    Start           = 1 << 4,   //!< The firmware (re)started
+    Temperature     = 1 << 5,   //!< Has a "T:" or "B:" temperature report
+    Position        = 1 << 6,   //!< Starts with "X:" (M114 reply)
+    Capability      = 1 << 7,   //!< "Cap:" line of the M115 reply
+    FirmwareInfo    = 1 << 8,   //!< Has "FIRMWARE_NAME:" (M115 reply)
+    Status          = 1 << 9,   //!< Grbl status report "<Idle|MPos:...>"
+};
+
+/**
+ * @brief Classify a line received from the printer
+ * @param line: the line, without line end
+ * @param length: length of the line
+ * @return MessageFlags or'ed together
+ */
+int classifyMessage(const char *line, std::size_t length);
+
+/**
+ * @brief Classify a line received from the printer
+ * @param line: the line, without line end
+ * @return MessageFlags or'ed together
+ */
+inline int classifyMessage(const std::string &line)
+{
+    return classifyMessage(line.data(), line.size());
+}
+
+/**
+ * @brief Temperatures read from a temperature report
+ * Targets are 0 when the report has none.
+ */
+struct TemperatureReport {
+    bool hasExtruder = false;       //!< @param hasExtruder: a "T:" block was found
+    float extruder = 0;             //!< @param extruder: extruder temperature
+    float extruderTarget = 0;       //!< @param extruderTarget: extruder target temperature
+    bool hasBed = false;            //!< @param hasBed: a "B:" block was found
+    float bed = 0;                  //!< @param bed: bed temperature
+    float bedTarget = 0;            //!< @param bedTarget: bed target temperature
+};
+
+/**
+ * @brief Read the first extruder and the bed temperature out of a temperature report
+ *
+ * Handles the formats of all supported firmwares, ex
+ * "ok T:49.74 /60.00 B:36.23 /50.00 @:0 B@:0" or "T:15.50/210.0 B:46.80/82.0"
+ * @param line: the line, without line end
+ * @param length: length of the line
+ * @param report: filled with the temperatures found
+ * @return true if any temperature was found
+ */
+bool parseTemperature(const char *line, std::size_t length, TemperatureReport &report);
+
+/**
+ * @brief Read the first extruder and the bed temperature out of a temperature report
+ * @param line: the line, without line end
+ * @param report: filled with the temperatures found
+ * @return true if any temperature was found
+ */
+inline bool parseTemperature(const std::string &line, TemperatureReport &report)
+{
+    return parseTemperature(line.data(), line.size(), report);
+}
+
+/**
+ * @brief Machine state read from a Grbl status report
+ */
+struct GrblStatus {
+    std::string state;                          //!< @param state: ex "Idle", "Run", "Hold:0", "Alarm"
+    bool hasMachinePosition = false;            //!< @param hasMachinePosition: machinePosition is known
+    double machinePosition[3] = {0, 0, 0};      //!< @param machinePosition: X Y Z in machine coordinates
+    bool hasWorkPosition = false;               //!< @param hasWorkPosition: workPosition is known
+    double workPosition[3] = {0, 0, 0};         //!< @param workPosition: X Y Z in work coordinates
+    int plannerBlocks = -1;                     //!< @param plannerBlocks: free planner blocks, -1 if not reported
+    int rxBytes = -1;                           //!< @param rxBytes: free bytes in the receive buffer, -1 if not reported
+    bool hasFeed = false;                       //!< @param hasFeed: feed is known
+    double feed = 0;                            //!< @param feed: current feed rate
+    double spindle = 0;                         //!< @param spindle: current spindle speed
+};
+
+/**
+ * @brief Read a Grbl status report, ex "<Idle|MPos:0.000,0.000,0.000|Bf:15,128|FS:0,0>"
+ *
+ * Grbl 0.9 reports ("<Idle,MPos:...,WPos:...>") are read too. The work position
+ * is worked out from MPos and WCO when Grbl only reports these.
+ * @param line: the line, without line end
+ * @param length: length of the line
+ * @param status: filled with the state found
+ * @return true if \p line is a status report
+ */
+bool parseGrblStatus(const char *line, std::size_t length, GrblStatus &status);
+
+/**
+ * @brief Read a Grbl status report
+ * @param line: the line, without line end
+ * @param status: filled with the state found
+ * @return true if \p line is a status report
+ */
+inline bool parseGrblStatus(const std::string &line, GrblStatus &status)
+{
+    return parseGrblStatus(line.data(), line.size(), status);
+}
+}
@@ -0,0 +1,60 @@
+/* AtCore
+   Copyright (C) <2026>
+
+   Authors:
+       The AtCore contributors
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <cstdint>
+
+namespace AtCoreProtocol
+{
+/**
+ * @brief The PrinterSnapshot struct
+ * State of one printer in a fixed layout, published whole through a SeqLock
+ *
+ * Plain data only, so it can be copied bytewise and read from another process.
+ * Heater 0 is the bed, the extruders follow.
+ */
+struct PrinterSnapshot {
+    enum {
+        Layout = 1,         //!< Changed with the layout, readers check it
+        MaxHeaters = 8,     //!< Heaters held
+    };
+
+    std::uint32_t layout = Layout;          //!< @param layout: Layout of the writer
+    std::int32_t state = 0;                 //!< @param state: AtCore::STATES
+    std::uint32_t heaterCount = 0;          //!< @param heaterCount: valid entries of temperature and target
+    float temperature[MaxHeaters] = {};     //!< @param temperature: current temperature of every heater
+    float target[MaxHeaters] = {};          //!< @param target: target temperature of every heater
+    std::uint32_t hasPosition = 0;          //!< @param hasPosition: 1 if position was reported
+    double position[3] = {};                //!< @param position: X, Y and Z
+    float progress = 0;                     //!< @param progress: percent of the print job, -1 unknown
+    std::int32_t layer = 0;                 //!< @param layer: layer being printed
+    std::int32_t layerCount = 0;            //!< @param layerCount: layers of the print job
+    std::int64_t timeLeft = 0;              //!< @param timeLeft: estimated msecs left of the job, -1 unknown
+    std::uint32_t queueDepth = 0;           //!< @param queueDepth: commands waiting to be sent
+    std::uint32_t inFlight = 0;             //!< @param inFlight: commands sent and not acknowledged
+    std::uint64_t commandsSent = 0;         //!< @param commandsSent: commands written since connecting
+    std::uint64_t commandsAcknowledged = 0; //!< @param commandsAcknowledged: acknowledges received since connecting
+    std::uint64_t bytesSent = 0;            //!< @param bytesSent: bytes written since connecting
+    std::uint64_t linesReceived = 0;        //!< @param linesReceived: lines read since connecting
+};
+}
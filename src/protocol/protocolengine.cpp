@@ -0,0 +1,289 @@
+/* AtCore
+   Copyright (C) <2026>
+
+   Authors:
+       The AtCore contributors
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <algorithm>
+
+#include "protocolengine.h"
+
+namespace AtCoreProtocol
+{
+ProtocolEngine::ProtocolEngine(const Dialect &dialect) :
+    m_dialect(dialect),
+    m_sent(0),
+    m_window(0),
+    m_terminatorSize(1),
+    m_maxLineLength(0),
+    m_bytesInFlight(0),
+    m_ready(false)
+{
+    m_framer.setLineHandler([this](const std::string & line) {
+        receiveLine(line);
+    });
+}
+
+void ProtocolEngine::setDialect(const Dialect &dialect)
+{
+    m_dialect = dialect;
+}
+
+const Dialect &ProtocolEngine::dialect() const
+{
+    return m_dialect;
+}
+
+void ProtocolEngine::setWriteHandler(WriteHandler handler)
+{
+    m_writeHandler = handler;
+}
+
+void ProtocolEngine::setSendWindow(std::size_t bytes, std::size_t terminatorSize)
+{
+    m_window = bytes;
+    m_terminatorSize = terminatorSize;
+}
+
+std::size_t ProtocolEngine::sendWindow() const
+{
+    return m_window;
+}
+
+std::size_t ProtocolEngine::bytesInFlight() const
+{
+    return m_bytesInFlight;
+}
+
+std::size_t ProtocolEngine::commandsInFlight() const
+{
+    return m_inFlight.size();
+}
+
+void ProtocolEngine::setMaxLineLength(std::size_t bytes)
+{
+    m_maxLineLength = bytes;
+}
+
+std::size_t ProtocolEngine::maxLineLength() const
+{
+    return m_maxLineLength;
+}
+
+void ProtocolEngine::setRejectHandler(RejectHandler handler)
+{
+    m_rejectHandler = handler;
+}
+
+void ProtocolEngine::setLineHandler(LineHandler handler)
+{
+    m_lineHandler = handler;
+}
+
+void ProtocolEngine::setTemperatureHandler(TemperatureHandler handler)
+{
+    m_temperatureHandler = handler;
+}
+
+void ProtocolEngine::submit(const std::string &command)
+{
+    m_queue.append(command);
+    if (m_ready) {
+        sendNext();
+    }
+}
+
+void ProtocolEngine::submit(const std::string &command, Completion completion)
+{
+    m_queue.seal();
+    m_queue.append(command);
+    m_queue.seal();
+    m_completions.push_back(std::make_pair(m_sent + m_queue.size() - 1, completion));
+    if (m_ready) {
+        sendNext();
+    }
+}
+
+void ProtocolEngine::submit(const std::vector<std::string> &commands, Completion completion)
+{
+    if (commands.empty()) {
+        return;
+    }
+    m_queue.seal();
+    m_queue.append(commands);
+    if (completion) {
+        m_completions.push_back(std::make_pair(m_sent + m_queue.size() - 1, completion));
+    }
+    if (m_ready) {
+        sendNext();
+    }
+}
+
+void ProtocolEngine::acknowledge()
+{
+    if (!m_inFlight.empty()) {
+        InFlight done = std::move(m_inFlight.front());
+        m_inFlight.pop_front();
+        m_bytesInFlight -= done.bytes;
+        //Commands submitted from the completion are only queued, they go out below.
+        if (done.completion) {
+            done.completion(done.reply, false);
+        }
+    }
+    m_ready = true;
+    sendNext();
+}
+
+void ProtocolEngine::sendNext()
+{
+    while (!m_queue.isEmpty() && m_writeHandler) {
+        if (m_window == 0 && !m_ready) {
+            return;
+        }
+        const std::string command = m_dialect.translate ? m_dialect.translate(m_queue.front()) : m_queue.front();
+        const std::size_t bytes = command.size() + m_terminatorSize;
+        if (m_maxLineLength > 0 && command.size() + std::max<std::size_t>(m_terminatorSize, 1) > m_maxLineLength) {
+            rejectNext(command);
+            continue;
+        }
+        if (m_window > 0 && !m_inFlight.empty() && m_bytesInFlight + bytes > m_window) {
+            return;
+        }
+        if (!m_writeHandler(command)) {
+            return;
+        }
+        m_queue.takeFirst();
+
+        InFlight sent;
+        sent.command = command;
+        sent.bytes = bytes;
+        if (!m_completions.empty() && m_completions.front().first == m_sent) {
+            sent.completion.swap(m_completions.front().second);
+            m_completions.pop_front();
+        }
+        m_inFlight.push_back(std::move(sent));
+        m_bytesInFlight += bytes;
+        m_sent++;
+        m_ready = false;
+    }
+}
+
+void ProtocolEngine::rejectNext(const std::string &command)
+{
+    m_queue.takeFirst();
+    Completion completion;
+    if (!m_completions.empty() && m_completions.front().first == m_sent) {
+        completion.swap(m_completions.front().second);
+        m_completions.pop_front();
+    }
+    //Keep the positions of the remaining completions.
+    m_sent++;
+    if (m_rejectHandler) {
+        m_rejectHandler(command);
+    }
+    if (completion) {
+        completion(std::vector<std::string>(), true);
+    }
+}
+
+void ProtocolEngine::setReady(bool ready)
+{
+    m_ready = ready;
+}
+
+bool ProtocolEngine::isReady() const
+{
+    return m_ready;
+}
+
+void ProtocolEngine::clear()
+{
+    std::deque<std::pair<std::uint64_t, Completion>> dropped;
+    dropped.swap(m_completions);
+    m_queue.clear();
+    m_framer.reset();
+    //The engine is consistent again, completions may submit new commands.
+    for (auto &completion : dropped) {
+        if (completion.second) {
+            completion.second(std::vector<std::string>(), true);
+        }
+    }
+}
+
+void ProtocolEngine::reset()
+{
+    std::deque<InFlight> dropped;
+    dropped.swap(m_inFlight);
+    m_bytesInFlight = 0;
+    m_ready = true;
+    std::deque<std::pair<std::uint64_t, Completion>> queued;
+    queued.swap(m_completions);
+    m_queue.clear();
+    m_framer.reset();
+    for (InFlight &command : dropped) {
+        if (command.completion) {
+            command.completion(command.reply, true);
+        }
+    }
+    for (auto &completion : queued) {
+        if (completion.second) {
+            completion.second(std::vector<std::string>(), true);
+        }
+    }
+}
+
+const CommandQueue &ProtocolEngine::queue() const
+{
+    return m_queue;
+}
+
+void ProtocolEngine::receive(const char *data, std::size_t size)
+{
+    m_framer.feed(data, size);
+}
+
+bool ProtocolEngine::isUnsolicited(const std::string &line, int flags) const
+{
+    if (line == "ok" || flags & (Busy | Start | Status)) {
+        return true;
+    }
+    //Temperatures without "ok" are auto reported, unless they were asked for.
+    return flags == Temperature && m_inFlight.front().command.compare(0, 4, "M105") != 0;
+}
+
+void ProtocolEngine::receiveLine(const std::string &line)
+{
+    const int flags = classifyMessage(line);
+    if (!m_inFlight.empty() && m_inFlight.front().completion && !isUnsolicited(line, flags)) {
+        m_inFlight.front().reply.push_back(line);
+    }
+    if (m_lineHandler) {
+        m_lineHandler(line, flags);
+    }
+    if (flags & Temperature && m_temperatureHandler) {
+        TemperatureReport report;
+        if (parseTemperature(line, report)) {
+            m_temperatureHandler(report);
+        }
+    }
+    if (m_dialect.isAcknowledge && m_dialect.isAcknowledge(line)) {
+        acknowledge();
+    }
+}
+}
@@ -0,0 +1,290 @@
+/* AtCore
+   Copyright (C) <2026>
+
+   Authors:
+       The AtCore contributors
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "commandqueue.h"
+#include "dialect.h"
+#include "lineframer.h"
+#include "messages.h"
+
+namespace AtCoreProtocol
+{
+/**
+ * @brief The ProtocolEngine class
+ * Talks to a printer without any event loop of its own
+ *
+ * The owner feeds the bytes read from the device to receive() and writes
+ * the commands handed to the write handler. Commands are queued and sent one
+ * at a time, the next one goes out when the dialect sees the acknowledge line
+ * or when acknowledge() is called.
+ *
+ * With a send window (character counting, see setSendWindow()) as many commands
+ * are sent as fit in the receive buffer of the firmware, every acknowledge frees
+ * the bytes of the oldest command in flight.
+ *
+ * A command submitted with a Completion is answered with the lines received
+ * between sending it and its acknowledge. Unsolicited lines (busy notices,
+ * restarts and auto reported temperatures) are not part of the reply. The completion runs on the thread
+ * calling receive() or acknowledge(), no thread is created.
+ */
+class ProtocolEngine
+{
+public:
+    /**
+     * @brief Write a translated command to the device
+     * @return False if it could not be written, the command then stays queued
+     */
+    typedef std::function<bool(const std::string &command)> WriteHandler;
+
+    /**
+     * @brief Called for every line received
+     * @param flags: MessageFlags of the line
+     */
+    typedef std::function<void(const std::string &line, int flags)> LineHandler;
+
+    /**
+     * @brief Called for every temperature report received
+     */
+    typedef std::function<void(const TemperatureReport &report)> TemperatureHandler;
+
+    /**
+     * @brief Called for a command dropped because it is longer than the firmware accepts
+     */
+    typedef std::function<void(const std::string &command)> RejectHandler;
+
+    /**
+     * @brief Called when the printer acknowledged a command, or when it was dropped
+     * @param reply: lines received for the command, without the bare "ok" and unsolicited lines
+     * @param aborted: True if the command was dropped by clear(), reset() or the line length check
+     */
+    typedef std::function<void(const std::vector<std::string> &reply, bool aborted)> Completion;
+
+    /**
+     * @brief Create a new ProtocolEngine
+     * @param dialect: firmware dialect to speak
+     */
+    explicit ProtocolEngine(const Dialect &dialect = Dialect::generic());
+
+    /**
+     * @brief Set the firmware dialect
+     * @param dialect: firmware dialect to speak
+     */
+    void setDialect(const Dialect &dialect);
+
+    /**
+     * @brief The firmware dialect in use
+     */
+    const Dialect &dialect() const;
+
+    /**
+     * @brief Set the function writing commands to the device
+     * @param handler: write handler
+     */
+    void setWriteHandler(WriteHandler handler);
+
+    /**
+     * @brief Stream commands by counting characters instead of waiting for each acknowledge
+     *
+     * Commands are sent while the bytes of all unacknowledged commands fit in \p bytes.
+     * The firmware must acknowledge every line in order, ex Grbl.
+     * @param bytes: size of the firmware receive buffer, 0 to send one command per acknowledge
+     * @param terminatorSize: bytes the write handler adds to every command
+     */
+    void setSendWindow(std::size_t bytes, std::size_t terminatorSize = 1);
+
+    /**
+     * @brief Size of the send window, 0 if commands are sent one per acknowledge
+     */
+    std::size_t sendWindow() const;
+
+    /**
+     * @brief Drop commands the firmware can not read instead of sending them
+     *
+     * The length counts the terminator, at least one byte.
+     * Completions of rejected commands are called aborted.
+     * @param bytes: longest line the firmware accepts, 0 for no limit
+     */
+    void setMaxLineLength(std::size_t bytes);
+
+    /**
+     * @brief Longest line sent, 0 for no limit
+     */
+    std::size_t maxLineLength() const;
+
+    /**
+     * @brief Set the function called for every rejected command
+     * @param handler: reject handler
+     */
+    void setRejectHandler(RejectHandler handler);
+
+    /**
+     * @brief Bytes sent and not acknowledged yet
+     */
+    std::size_t bytesInFlight() const;
+
+    /**
+     * @brief Commands written and not acknowledged yet
+     */
+    std::size_t commandsInFlight() const;
+
+    /**
+     * @brief Set the function called for every line received
+     * @param handler: line handler
+     */
+    void setLineHandler(LineHandler handler);
+
+    /**
+     * @brief Set the function called for every temperature report
+     * @param handler: temperature handler
+     */
+    void setTemperatureHandler(TemperatureHandler handler);
+
+    /**
+     * @brief Queue \p command and send it if the printer is ready
+     * @param command: Command to send
+     */
+    void submit(const std::string &command);
+
+    /**
+     * @brief Queue \p command and call \p completion once it is acknowledged
+     *
+     * The command is not coalesced with the commands queued before or after it.
+     * If the command is dropped before its acknowledge the completion is called aborted.
+     * @param command: Command to send
+     * @param completion: called with the reply of the command
+     */
+    void submit(const std::string &command, Completion completion);
+
+    /**
+     * @brief Queue \p commands in one go and call \p completion once the last one is acknowledged
+     *
+     * The commands keep their order and are not coalesced.
+     * @param commands: Commands to send
+     * @param completion: called with the reply of the last command, may be empty
+     */
+    void submit(const std::vector<std::string> &commands, Completion completion = Completion());
+
+    /**
+     * @brief The printer acknowledged the oldest command in flight, send the next ones
+     */
+    void acknowledge();
+
+    /**
+     * @brief Set if the printer is ready for a command without sending anything
+     * @param ready: True if ready
+     */
+    void setReady(bool ready);
+
+    /**
+     * @brief True if the printer is ready for a command
+     */
+    bool isReady() const;
+
+    /**
+     * @brief Drop the queued commands and any incomplete line
+     *
+     * Completions of the dropped commands are called aborted.
+     */
+    void clear();
+
+    /**
+     * @brief Forget everything, including the commands in flight, after the firmware restarted
+     *
+     * Their completions are called aborted, oldest first, and the engine is ready to send again.
+     */
+    void reset();
+
+    /**
+     * @brief Commands waiting to be sent
+     */
+    const CommandQueue &queue() const;
+
+    /**
+     * @brief Feed bytes read from the device
+     * @param data: bytes read
+     * @param size: number of bytes
+     */
+    void receive(const char *data, std::size_t size);
+
+    /**
+     * @brief Handle a complete line received from the device
+     * @param line: the line, without line end
+     */
+    void receiveLine(const std::string &line);
+
+private:
+    /**
+     * @brief A command written and not acknowledged yet
+     */
+    struct InFlight {
+        std::string command;            //!< @param command: command as written
+        std::size_t bytes;              //!< @param bytes: bytes written
+        Completion completion;          //!< @param completion: called on acknowledge, may be empty
+        std::vector<std::string> reply; //!< @param reply: lines received for the command
+    };
+
+    /**
+     * @brief Write queued commands while the printer can take them
+     */
+    void sendNext();
+
+    /**
+     * @brief Drop the first queued command, it is too long to send
+     * @param command: the command as it would have been written
+     */
+    void rejectNext(const std::string &command);
+
+    /**
+     * @brief True if \p line was not sent in answer to the oldest command in flight
+     * @param line: line received
+     * @param flags: MessageFlags of the line
+     */
+    bool isUnsolicited(const std::string &line, int flags) const;
+
+    ProtocolEngine(const ProtocolEngine &) = delete;
+    ProtocolEngine &operator=(const ProtocolEngine &) = delete;
+
+    Dialect m_dialect;
+    CommandQueue m_queue;
+    LineFramer m_framer;
+    WriteHandler m_writeHandler;
+    LineHandler m_lineHandler;
+    TemperatureHandler m_temperatureHandler;
+    RejectHandler m_rejectHandler;
+    std::deque<std::pair<std::uint64_t, Completion>> m_completions;
+    std::deque<InFlight> m_inFlight;
+    std::uint64_t m_sent;
+    std::size_t m_window;
+    std::size_t m_terminatorSize;
+    std::size_t m_maxLineLength;
+    std::size_t m_bytesInFlight;
+    bool m_ready;
+};
+}
@@ -0,0 +1,215 @@
+/* AtCore
+   Copyright (C) <2026>
+
+   Authors:
+       The AtCore contributors
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <cstdlib>
+#include <cstring>
+
+#include "reprapstatus.h"
+
+namespace
+{
+/**
+ * @brief Single pass reader over a JSON text
+ * Every read moves past the value read and returns false on malformed input.
+ */
+class JsonReader
+{
+public:
+    JsonReader(const char *begin, const char *end)
+        : m_c(begin)
+        , m_end(end)
+    {
+    }
+
+    bool atEnd()
+    {
+        skipSpace();
+        return m_c >= m_end;
+    }
+
+    bool consume(char c)
+    {
+        skipSpace();
+        if (m_c < m_end && *m_c == c) {
+            ++m_c;
+            return true;
+        }
+        return false;
+    }
+
+    char peek()
+    {
+        skipSpace();
+        return m_c < m_end ? *m_c : '\0';
+    }
+
+    bool readString(std::string &value)
+    {
+        if (!consume('"')) {
+            return false;
+        }
+        value.clear();
+        while (m_c < m_end && *m_c != '"') {
+            if (*m_c == '\\' && m_c + 1 < m_end) {
+                ++m_c;
+            }
+            value.push_back(*m_c++);
+        }
+        if (m_c >= m_end) {
+            return false;
+        }
+        ++m_c;
+        return true;
+    }
+
+    bool readNumber(double &value)
+    {
+        skipSpace();
+        char *next = nullptr;
+        //The reply is a single line, strtod stops on the ',' ']' or '}' following the number.
+        value = std::strtod(m_c, &next);
+        if (next == m_c || next > m_end) {
+            return false;
+        }
+        m_c = next;
+        return true;
+    }
+
+    bool readNumbers(std::vector<double> &values)
+    {
+        values.clear();
+        if (!consume('[')) {
+            return false;
+        }
+        if (consume(']')) {
+            return true;
+        }
+        do {
+            double value = 0;
+            if (!readNumber(value)) {
+                return false;
+            }
+            values.push_back(value);
+        } while (consume(','));
+        return consume(']');
+    }
+
+    bool skipValue()
+    {
+        switch (peek()) {
+        case '"': {
+            std::string ignored;
+            return readString(ignored);
+        }
+        case '[':
+            return skipContainer('[', ']');
+        case '{':
+            return skipContainer('{', '}');
+        default:
+            break;
+        }
+        while (m_c < m_end && *m_c != ',' && *m_c != ']' && *m_c != '}') {
+            ++m_c;
+        }
+        return true;
+    }
+
+private:
+    void skipSpace()
+    {
+        while (m_c < m_end && (*m_c == ' ' || *m_c == '\t' || *m_c == '\r' || *m_c == '\n')) {
+            ++m_c;
+        }
+    }
+
+    bool skipContainer(char open, char close)
+    {
+        consume(open);
+        if (consume(close)) {
+            return true;
+        }
+        do {
+            if (open == '{') {
+                std::string key;
+                if (!readString(key) || !consume(':')) {
+                    return false;
+                }
+            }
+            if (!skipValue()) {
+                return false;
+            }
+        } while (consume(','));
+        return consume(close);
+    }
+
+    const char *m_c;
+    const char *m_end;
+};
+}
+
+namespace AtCoreProtocol
+{
+bool parseRepRapStatus(const char *line, std::size_t length, RepRapStatus &status)
+{
+    //strtod needs the text to end, copy lines that are not terminated.
+    std::string text(line, length);
+    JsonReader reader(text.data(), text.data() + text.size());
+    if (!reader.consume('{')) {
+        return false;
+    }
+    if (reader.consume('}')) {
+        return reader.atEnd();
+    }
+    std::string key;
+    std::string value;
+    do {
+        if (!reader.readString(key) || !reader.consume(':')) {
+            return false;
+        }
+        bool ok = true;
+        if (key == "status") {
+            ok = reader.readString(value);
+            status.status = value.empty() ? '\0' : value.at(0);
+        } else if (key == "heaters") {
+            ok = reader.readNumbers(status.heaters);
+        } else if (key == "active") {
+            ok = reader.readNumbers(status.active);
+        } else if (key == "pos") {
+            ok = reader.readNumbers(status.position);
+        } else if (key == "fanPercent") {
+            ok = reader.readNumbers(status.fanPercent);
+        } else if (key == "tool") {
+            double tool = -1;
+            ok = reader.readNumber(tool);
+            status.tool = int(tool);
+        } else if (key == "fraction_printed") {
+            ok = reader.readNumber(status.fractionPrinted);
+        } else {
+            ok = reader.skipValue();
+        }
+        if (!ok) {
+            return false;
+        }
+    } while (reader.consume(','));
+    return reader.consume('}') && reader.atEnd();
+}
+}
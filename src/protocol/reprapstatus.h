@@ -0,0 +1,68 @@
+/* AtCore
+   Copyright (C) <2026>
+
+   Authors:
+       The AtCore contributors
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace AtCoreProtocol
+{
+/**
+ * @brief Machine state read from a RepRapFirmware M408 S0 reply
+ *
+ * M408 answers on one line with a JSON object holding the temperatures, the position,
+ * the fans and the print progress, replacing separate M105, M114 and M27 polls.
+ */
+struct RepRapStatus {
+    char status = 0;                    //!< @param status: "status" letter, ex 'I' idle, 'P' printing, 'A' paused, 'B' busy
+    std::vector<double> heaters;        //!< @param heaters: current temperature of every heater, the bed is usually heater 0
+    std::vector<double> active;         //!< @param active: active target of every heater
+    std::vector<double> position;       //!< @param position: "pos", X Y Z ...
+    std::vector<double> fanPercent;     //!< @param fanPercent: speed of every fan in percent
+    int tool = -1;                      //!< @param tool: selected tool, -1 for none
+    double fractionPrinted = -1;        //!< @param fractionPrinted: "fraction_printed" 0 - 1, -1 if not reported
+};
+
+/**
+ * @brief Read a M408 S0 reply, ex {"status":"I","heaters":[25.0,24.8],"active":[0.0,0.0],"pos":[0.000,0.000,0.000]}
+ *
+ * The line is read in one pass without building a document, keys not in RepRapStatus are skipped.
+ * @param line: the line, without line end
+ * @param length: length of the line
+ * @param status: filled with the state found
+ * @return true if \p line is a complete JSON object
+ */
+bool parseRepRapStatus(const char *line, std::size_t length, RepRapStatus &status);
+
+/**
+ * @brief Read a M408 S0 reply
+ * @param line: the line, without line end
+ * @param status: filled with the state found
+ * @return true if \p line is a complete JSON object
+ */
+inline bool parseRepRapStatus(const std::string &line, RepRapStatus &status)
+{
+    return parseRepRapStatus(line.data(), line.size(), status);
+}
+}
@@ -0,0 +1,161 @@
+/* AtCore
+   Copyright (C) <2026>
+
+   Authors:
+       The AtCore contributors
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <thread>
+#include <type_traits>
+
+namespace AtCoreProtocol
+{
+/**
+ * @brief The SeqLock class
+ * Publishes a value from one writer to any number of readers without locking
+ *
+ * The writer makes the sequence odd, copies the value in and makes it even again.
+ * A reader copies the value out and retries when the sequence was odd or changed
+ * meanwhile, so it always gets a whole value and never holds up the writer.
+ * The value is copied through relaxed atomic words: the storage stays valid in
+ * memory shared between processes, where the atomics used are lock free.
+ * Only one thread may store().
+ */
+template<typename T>
+class SeqLock
+{
+    static_assert(std::is_trivially_copyable<T>::value, "SeqLock copies the value bytewise");
+
+public:
+    /**
+     * @brief Number of 64 bit words holding the value
+     */
+    static const std::size_t WordCount = (sizeof(T) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+    /**
+     * @brief Memory of a SeqLock, may be placed in shared memory
+     */
+    struct Storage {
+        std::atomic<std::uint32_t> sequence;        //!< @param sequence: odd while a store is running
+        std::atomic<std::uint64_t> words[WordCount];//!< @param words: the value
+    };
+
+    /**
+     * @brief SeqLock holding its own storage, with a default value
+     */
+    SeqLock()
+        : m_storage(initialize(&m_own))
+    {
+        store(T());
+    }
+
+    /**
+     * @brief SeqLock over \p storage, made by initialize() in this or another process
+     */
+    explicit SeqLock(Storage *storage)
+        : m_storage(storage)
+    {
+    }
+
+    /**
+     * @brief Make a Storage in \p memory, at least sizeof(Storage) bytes
+     * @return the storage, holding zeros
+     */
+    static Storage *initialize(void *memory)
+    {
+        Storage *storage = new (memory) Storage;
+        storage->sequence.store(0, std::memory_order_relaxed);
+        for (std::size_t i = 0; i < WordCount; i++) {
+            storage->words[i].store(0, std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_release);
+        return storage;
+    }
+
+    /**
+     * @brief Publish \p value, wait free
+     */
+    void store(const T &value)
+    {
+        std::uint64_t words[WordCount] = {};
+        std::memcpy(words, &value, sizeof(T));
+        const std::uint32_t sequence = m_storage->sequence.load(std::memory_order_relaxed);
+        m_storage->sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (std::size_t i = 0; i < WordCount; i++) {
+            m_storage->words[i].store(words[i], std::memory_order_relaxed);
+        }
+        m_storage->sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    /**
+     * @brief Read the value once
+     * @return False if a store ran meanwhile, \p value is then unchanged
+     */
+    bool tryLoad(T &value) const
+    {
+        std::uint64_t words[WordCount];
+        const std::uint32_t before = m_storage->sequence.load(std::memory_order_acquire);
+        if (before & 1) {
+            return false;
+        }
+        for (std::size_t i = 0; i < WordCount; i++) {
+            words[i] = m_storage->words[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (m_storage->sequence.load(std::memory_order_relaxed) != before) {
+            return false;
+        }
+        std::memcpy(&value, words, sizeof(T));
+        return true;
+    }
+
+    /**
+     * @brief Read a consistent value, retrying while stores run
+     */
+    T load() const
+    {
+        T value;
+        while (!tryLoad(value)) {
+            std::this_thread::yield();
+        }
+        return value;
+    }
+
+    /**
+     * @brief Count of the stores, times two: readers polling it know when the value changed
+     */
+    std::uint32_t sequence() const
+    {
+        return m_storage->sequence.load(std::memory_order_acquire);
+    }
+
+private:
+    SeqLock(const SeqLock &) = delete;
+    SeqLock &operator=(const SeqLock &) = delete;
+
+    Storage m_own;
+    Storage *m_storage;
+};
+}
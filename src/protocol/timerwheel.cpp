@@ -0,0 +1,185 @@
+/* AtCore
+   Copyright (C) <2026>
+
+   Authors:
+       The AtCore contributors
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <algorithm>
+#include <limits>
+
+#include "timerwheel.h"
+
+namespace AtCoreProtocol
+{
+
+TimerWheel::TimerWheel(std::uint32_t tickMsecs)
+    : m_tickMsecs(std::max<std::uint32_t>(1, tickMsecs))
+    , m_tick(0)
+    , m_nextId(1)
+    , m_generation(0)
+{
+}
+
+std::uint32_t TimerWheel::tickMsecs() const
+{
+    return m_tickMsecs;
+}
+
+TimerWheel::TimerId TimerWheel::schedule(std::uint64_t delayMsecs, std::uint64_t periodMsecs, Callback callback, std::uint64_t jitterMsecs)
+{
+    if (jitterMsecs > 0) {
+        delayMsecs += std::uniform_int_distribution<std::uint64_t>(0, jitterMsecs)(m_random);
+    }
+    //Rounded up, a timer never expires early.
+    const std::uint64_t delay = std::max<std::uint64_t>(1, (delayMsecs + m_tickMsecs - 1) / m_tickMsecs);
+    const std::uint64_t period = periodMsecs ? std::max<std::uint64_t>(1, (periodMsecs + m_tickMsecs - 1) / m_tickMsecs) : 0;
+    const TimerId id = m_nextId++;
+    Timer &timer = m_timers[id];
+    timer.expiry = m_tick + delay;
+    timer.period = period;
+    timer.callback = std::move(callback);
+    place(id, timer);
+    return id;
+}
+
+void TimerWheel::cancel(TimerId timer)
+{
+    //Its slot entry is left behind, stale, and skipped when the slot is reached.
+    m_timers.erase(timer);
+}
+
+bool TimerWheel::isActive(TimerId timer) const
+{
+    return m_timers.count(timer) > 0;
+}
+
+std::size_t TimerWheel::size() const
+{
+    return m_timers.size();
+}
+
+void TimerWheel::place(TimerId id, Timer &timer)
+{
+    timer.generation = ++m_generation;
+    const std::uint64_t delta = timer.expiry - m_tick;
+    int level = 0;
+    while (level < Levels - 1 && delta >= (std::uint64_t(1) << (SlotBits * (level + 1)))) {
+        level++;
+    }
+    std::uint64_t expiry = timer.expiry;
+    const std::uint64_t range = std::uint64_t(1) << (SlotBits * Levels);
+    if (delta >= range) {
+        //Beyond the last wheel, placed again when its slot comes.
+        expiry = m_tick + range - 1;
+    }
+    const std::size_t slot = (expiry >> (SlotBits * level)) & (Slots - 1);
+    m_slots[level][slot].push_back(Entry(id, timer.generation));
+}
+
+void TimerWheel::cascade(int level)
+{
+    std::vector<Entry> entries;
+    entries.swap(m_slots[level][(m_tick >> (SlotBits * level)) & (Slots - 1)]);
+    for (const Entry &entry : entries) {
+        auto timer = m_timers.find(entry.first);
+        if (timer != m_timers.end() && timer->second.generation == entry.second) {
+            place(entry.first, timer->second);
+        }
+    }
+}
+
+std::size_t TimerWheel::advance(std::uint64_t nowMsecs)
+{
+    const std::uint64_t target = nowMsecs / m_tickMsecs;
+    std::size_t count = 0;
+    while (m_tick < target) {
+        if (m_timers.empty()) {
+            //Nothing to run, only stale entries left behind.
+            for (auto &level : m_slots) {
+                for (auto &slot : level) {
+                    slot.clear();
+                }
+            }
+            m_tick = target;
+            break;
+        }
+        m_tick++;
+        //Coarser wheels first, what they hand down may belong to the finer slot due now.
+        int levels = 0;
+        while (levels < Levels - 1 && (m_tick & ((std::uint64_t(1) << (SlotBits * (levels + 1))) - 1)) == 0) {
+            levels++;
+        }
+        for (int level = levels; level > 0; level--) {
+            cascade(level);
+        }
+
+        std::vector<Entry> due;
+        due.swap(m_slots[0][m_tick & (Slots - 1)]);
+        for (const Entry &entry : due) {
+            auto found = m_timers.find(entry.first);
+            if (found == m_timers.end() || found->second.generation != entry.second) {
+                continue;
+            }
+            const TimerId id = entry.first;
+            //The callback may cancel or reschedule timers, this one included.
+            const Callback callback = found->second.callback;
+            if (found->second.period == 0) {
+                m_timers.erase(found);
+            }
+            callback();
+            count++;
+            found = m_timers.find(id);
+            if (found != m_timers.end() && found->second.generation == entry.second && found->second.period > 0) {
+                Timer &timer = found->second;
+                //Keep the phase, the periods missed while the owner was late run once, not each.
+                timer.expiry += timer.period;
+                if (timer.expiry <= target) {
+                    timer.expiry += ((target - timer.expiry) / timer.period + 1) * timer.period;
+                }
+                place(id, timer);
+            }
+        }
+    }
+    return count;
+}
+
+std::int64_t TimerWheel::msecsToNext(std::uint64_t nowMsecs) const
+{
+    if (m_timers.empty()) {
+        return -1;
+    }
+    std::uint64_t next = std::numeric_limits<std::uint64_t>::max();
+    for (int level = 0; level < Levels; level++) {
+        const int shift = SlotBits * level;
+        for (std::uint64_t i = 1; i <= Slots; i++) {
+            //Slots of coarser wheels are reached when their first tick comes.
+            const std::uint64_t block = (m_tick >> shift) + i;
+            if (!m_slots[level][block & (Slots - 1)].empty()) {
+                next = std::min(next, block << shift);
+                break;
+            }
+        }
+    }
+    if (next == std::numeric_limits<std::uint64_t>::max()) {
+        return -1;
+    }
+    const std::uint64_t nextMsecs = next * m_tickMsecs;
+    return nextMsecs > nowMsecs ? std::int64_t(nextMsecs - nowMsecs) : 0;
+}
+}
@@ -0,0 +1,152 @@
+/* AtCore
+   Copyright (C) <2026>
+
+   Authors:
+       The AtCore contributors
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace AtCoreProtocol
+{
+/**
+ * @brief The TimerWheel class
+ * Hierarchical timer wheel running many periodic and one shot timers from one clock
+ *
+ * Time is counted in ticks of tickMsecs(). Timers due within 64 ticks sit in the
+ * slots of the first wheel, later ones in coarser wheels (64 times coarser each)
+ * and move down as their time comes, so scheduling, cancelling and expiring cost
+ * the same however many timers there are. The owner calls advance() with the time
+ * and sleeps until msecsToNext(), every timer due in the meantime runs in that one call.
+ *
+ * Timers may start at a random offset (jitter) so that timers created together,
+ * ex the polls of many printers connected at once, do not all fire on the same tick.
+ * Periodic timers then keep their phase. No thread nor clock of its own.
+ */
+class TimerWheel
+{
+public:
+    /**
+     * @brief Identifies a timer, never 0
+     */
+    typedef std::uint64_t TimerId;
+
+    /**
+     * @brief Work run when a timer expires
+     */
+    typedef std::function<void()> Callback;
+
+    /**
+     * @brief TimerWheel whose time starts at 0
+     * @param tickMsecs: resolution of the timers
+     */
+    explicit TimerWheel(std::uint32_t tickMsecs = 10);
+
+    /**
+     * @brief Resolution of the timers in msecs
+     */
+    std::uint32_t tickMsecs() const;
+
+    /**
+     * @brief Start a timer
+     * @param delayMsecs: msecs from the last advance() until it first expires, at least one tick
+     * @param periodMsecs: msecs between two expiries, 0 for a one shot timer
+     * @param callback: run on expiry, it may schedule and cancel timers
+     * @param jitterMsecs: up to this many msecs added to the first delay, at random
+     * @return the timer
+     */
+    TimerId schedule(std::uint64_t delayMsecs, std::uint64_t periodMsecs, Callback callback, std::uint64_t jitterMsecs = 0);
+
+    /**
+     * @brief Stop \p timer, nothing happens if it already expired or was cancelled
+     */
+    void cancel(TimerId timer);
+
+    /**
+     * @brief Check \p timer will still expire
+     */
+    bool isActive(TimerId timer) const;
+
+    /**
+     * @brief Number of timers running
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Move the time to \p nowMsecs and run every timer due, in order of expiry
+     * @return Number of timers run
+     */
+    std::size_t advance(std::uint64_t nowMsecs);
+
+    /**
+     * @brief Msecs from \p nowMsecs until the next timer is due, -1 without timers
+     *
+     * Timers in the coarser wheels are counted from the start of their slot,
+     * the owner may wake up early and find nothing due, never late.
+     */
+    std::int64_t msecsToNext(std::uint64_t nowMsecs) const;
+
+private:
+    /**
+     * @brief A timer running
+     */
+    struct Timer {
+        std::uint64_t expiry;       //!< @param expiry: tick it expires on
+        std::uint64_t period;       //!< @param period: ticks between expiries, 0 for one shot
+        std::uint64_t generation;   //!< @param generation: tells the slot entry of its last placement
+        Callback callback;          //!< @param callback: work to run
+    };
+
+    /**
+     * @brief A timer in a slot, stale if the generation changed since
+     */
+    typedef std::pair<TimerId, std::uint64_t> Entry;
+
+    enum {
+        SlotBits = 6,
+        Slots = 1 << SlotBits,
+        Levels = 4,
+    };
+
+    /**
+     * @brief Put \p id in the slot its expiry belongs to
+     */
+    void place(TimerId id, Timer &timer);
+
+    /**
+     * @brief Move the timers of the current slot of wheel \p level down
+     */
+    void cascade(int level);
+
+    std::uint32_t m_tickMsecs;
+    std::uint64_t m_tick;
+    TimerId m_nextId;
+    std::uint64_t m_generation;
+    std::unordered_map<TimerId, Timer> m_timers;
+    std::vector<Entry> m_slots[Levels][Slots];
+    std::minstd_rand m_random;
+};
+}
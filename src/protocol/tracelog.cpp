@@ -0,0 +1,281 @@
+/* AtCore
+   Copyright (C) <2026>
+
+   Authors:
+       The AtCore contributors
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <utility>
+
+#include "tracelog.h"
+
+namespace AtCoreProtocol
+{
+
+const std::size_t TraceRecord::MaxArgs;
+const std::size_t TraceRecord::MaxText;
+const std::size_t TraceLog::DefaultCapacity;
+
+/**
+ * @brief Records of one thread, written by it and read by the drain
+ */
+class TraceLog::Ring
+{
+public:
+    explicit Ring(std::size_t capacity)
+        : m_records(capacity)
+        , m_mask(capacity - 1)
+        , m_head(0)
+        , m_tail(0)
+        , m_dropped(0)
+        , m_retired(false)
+    {
+    }
+
+    /**
+     * @brief Append \p record, false if the ring is full
+     */
+    bool push(const TraceRecord &record)
+    {
+        const std::uint64_t head = m_head.load(std::memory_order_relaxed);
+        if (head - m_tail.load(std::memory_order_acquire) > m_mask) {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        m_records[head & m_mask] = record;
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Move every record written so far to \p out
+     */
+    void popAll(std::vector<TraceRecord> &out)
+    {
+        std::uint64_t tail = m_tail.load(std::memory_order_relaxed);
+        const std::uint64_t head = m_head.load(std::memory_order_acquire);
+        for (; tail != head; ++tail) {
+            out.push_back(m_records[tail & m_mask]);
+        }
+        m_tail.store(tail, std::memory_order_release);
+    }
+
+    bool empty() const
+    {
+        return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_relaxed);
+    }
+
+    std::uint64_t dropped() const
+    {
+        return m_dropped.load(std::memory_order_relaxed);
+    }
+
+    bool retired() const
+    {
+        return m_retired.load(std::memory_order_acquire);
+    }
+
+    void retire()
+    {
+        m_retired.store(true, std::memory_order_release);
+    }
+
+private:
+    std::vector<TraceRecord> m_records;         //!< @param m_records: the ring
+    const std::uint64_t m_mask;                 //!< @param m_mask: capacity - 1, capacity is a power of two
+    std::atomic<std::uint64_t> m_head;          //!< @param m_head: records written, by the owner thread
+    std::atomic<std::uint64_t> m_tail;          //!< @param m_tail: records read, by the drain
+    std::atomic<std::uint64_t> m_dropped;       //!< @param m_dropped: records dropped while full
+    std::atomic<bool> m_retired;                //!< @param m_retired: the owner thread finished
+};
+
+namespace
+{
+std::size_t _powerOfTwo(std::size_t value)
+{
+    std::size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+std::atomic<std::uint64_t> _nextLogSerial(1);
+}
+
+/**
+ * @brief Rings of the calling thread, one per log it traced into
+ * Retired when the thread finishes, the drain frees them once read.
+ */
+struct TraceLog::LocalRings {
+    ~LocalRings()
+    {
+        for (auto &ring : rings) {
+            ring.second->retire();
+        }
+    }
+    std::vector<std::pair<std::uint64_t, std::shared_ptr<Ring>>> rings;   //!< @param rings: ring of each log, by serial
+};
+
+TraceLog::TraceLog()
+    : m_dropped(0)
+    , m_capacity(DefaultCapacity)
+    , m_serial(_nextLogSerial.fetch_add(1))
+{
+}
+
+TraceLog::~TraceLog()
+{
+}
+
+std::uint32_t TraceLog::registerFormat(const char *category, const char *format)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (std::size_t i = 0; i < m_formats.size(); ++i) {
+        if (m_formats[i].category == category && m_formats[i].format == format) {
+            return std::uint32_t(i + 1);
+        }
+    }
+    m_formats.push_back(Format{category, format});
+    return std::uint32_t(m_formats.size());
+}
+
+TraceLog::Ring *TraceLog::localRing()
+{
+    static thread_local LocalRings local;
+    for (const auto &ring : local.rings) {
+        if (ring.first == m_serial) {
+            return ring.second.get();
+        }
+    }
+    auto ring = std::make_shared<Ring>(m_capacity.load(std::memory_order_relaxed));
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_rings.push_back(ring);
+    }
+    local.rings.emplace_back(m_serial, ring);
+    return ring.get();
+}
+
+void TraceLog::write(TraceRecord &record)
+{
+    record.nanos = std::uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now().time_since_epoch()).count());
+    localRing()->push(record);
+}
+
+std::size_t TraceLog::drain(const Consumer &consumer)
+{
+    std::lock_guard<std::mutex> drainLock(m_drainMutex);
+    std::vector<std::shared_ptr<Ring>> rings;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        rings = m_rings;
+    }
+
+    std::vector<TraceRecord> records;
+    for (const auto &ring : rings) {
+        ring->popAll(records);
+    }
+    std::stable_sort(records.begin(), records.end(), [](const TraceRecord & a, const TraceRecord & b) {
+        return a.nanos < b.nanos;
+    });
+
+    std::vector<Format> formats;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        formats = m_formats;
+        //Rings of finished threads go once read, their drops are kept.
+        for (auto it = m_rings.begin(); it != m_rings.end();) {
+            if ((*it)->retired() && (*it)->empty()) {
+                m_dropped.fetch_add((*it)->dropped(), std::memory_order_relaxed);
+                it = m_rings.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    for (const TraceRecord &record : records) {
+        if (record.format == 0 || record.format > formats.size()) {
+            continue;
+        }
+        const Format &format = formats[record.format - 1];
+        consumer(record, format.category, format.format);
+    }
+    return records.size();
+}
+
+std::uint64_t TraceLog::dropped() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::uint64_t total = m_dropped.load(std::memory_order_relaxed);
+    for (const auto &ring : m_rings) {
+        total += ring->dropped();
+    }
+    return total;
+}
+
+void TraceLog::setCapacity(std::size_t records)
+{
+    m_capacity.store(_powerOfTwo(std::max<std::size_t>(records, 2)), std::memory_order_relaxed);
+}
+
+std::string TraceLog::format(const char *format, const TraceRecord &record)
+{
+    std::string text;
+    std::size_t index = 0;
+    char number[32];
+    for (const char *c = format; *c; ++c) {
+        if (*c != '%' || !c[1]) {
+            text += *c;
+            continue;
+        }
+        ++c;
+        if (*c == 's') {
+            text.append(record.text, record.textSize);
+            continue;
+        }
+        if (*c != 'i' && *c != 'u' && *c != 'f') {
+            text += *c;
+            continue;
+        }
+        if (index >= TraceRecord::MaxArgs) {
+            text += '?';
+            continue;
+        }
+        const std::uint64_t value = record.args[index++];
+        if (*c == 'i') {
+            std::snprintf(number, sizeof(number), "%" PRId64, std::int64_t(value));
+        } else if (*c == 'u') {
+            std::snprintf(number, sizeof(number), "%" PRIu64, value);
+        } else {
+            double real;
+            std::memcpy(&real, &value, sizeof(real));
+            std::snprintf(number, sizeof(number), "%g", real);
+        }
+        text += number;
+    }
+    return text;
+}
+
+}
@@ -0,0 +1,215 @@
+/* AtCore
+   Copyright (C) <2026>
+
+   Authors:
+       The AtCore contributors
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace AtCoreProtocol
+{
+/**
+ * @brief One traced event, written as is by the traced thread
+ */
+struct TraceRecord {
+    static const std::size_t MaxArgs = 3;       //!< @param MaxArgs: numeric arguments of a record
+    static const std::size_t MaxText = 120;     //!< @param MaxText: bytes of text kept, a whole gcode line, longer text is cut
+
+    std::uint64_t nanos;                        //!< @param nanos: steady clock time of the event
+    std::uint32_t format;                       //!< @param format: id of the format, from TraceLog::registerFormat()
+    std::uint32_t textSize;                     //!< @param textSize: bytes used in text
+    std::uint64_t args[MaxArgs];                //!< @param args: raw arguments, doubles by their bits
+    char text[MaxText];                         //!< @param text: text argument, not terminated
+};
+
+/**
+ * @brief Text argument of a trace, copied into the record up to TraceRecord::MaxText bytes
+ */
+struct TraceText {
+    const char *data;                           //!< @param data: first byte
+    std::size_t size;                           //!< @param size: bytes of text
+};
+
+/**
+ * @brief Static state of one trace call site
+ * Declare it static, zero initialized, the site registers its format on first use.
+ */
+struct TraceSite {
+    std::atomic<std::uint32_t> format;          //!< @param format: id of the format, 0 until registered
+};
+
+/**
+ * @brief The TraceLog class
+ * Low overhead tracing for hot paths, formatted away from them
+ *
+ * A trace copies its format id and raw arguments into a fixed size record of a
+ * ring owned by the calling thread: no allocation, no lock, no formatting. A
+ * single consumer drains every ring and turns records into text with
+ * format(), usually on a background thread. When a ring is full the record is
+ * dropped and counted, tracing never blocks the traced thread.
+ *
+ * Formats are printf like: %i and %u print a signed or unsigned integer, %f a
+ * double, %s the text argument and %% a percent sign. Numeric arguments fill
+ * the %i, %u and %f in order, the text argument is passed as a TraceText.
+ */
+class TraceLog
+{
+public:
+    /**
+     * @brief Records a ring holds before new ones are dropped
+     */
+    static const std::size_t DefaultCapacity = 4096;
+
+    /**
+     * @brief Called by drain() for every record, oldest first
+     * @param record: the record
+     * @param category: category given when the format was registered
+     * @param format: format of the record
+     */
+    typedef std::function<void(const TraceRecord &record, const char *category, const char *format)> Consumer;
+
+    TraceLog();
+    ~TraceLog();
+
+    /**
+     * @brief Register a format, returning its id
+     * @param category: name the consumer files the records under, must outlive the log
+     * @param format: format of the records, must outlive the log
+     */
+    std::uint32_t registerFormat(const char *category, const char *format);
+
+    /**
+     * @brief Trace from \p site, registering its format on first use
+     * @param site: static state of the call site
+     * @param category: category of the site, used on first use only
+     * @param format: format of the site, used on first use only
+     * @param args: up to TraceRecord::MaxArgs integers or floating point numbers and at most one TraceText
+     */
+    template<typename... Args>
+    void trace(TraceSite &site, const char *category, const char *format, const Args &... args)
+    {
+        static_assert(sizeof...(Args) <= TraceRecord::MaxArgs + 1, "Too many trace arguments");
+        std::uint32_t id = site.format.load(std::memory_order_acquire);
+        if (id == 0) {
+            id = registerFormat(category, format);
+            site.format.store(id, std::memory_order_release);
+        }
+        TraceRecord record = TraceRecord();
+        record.format = id;
+        std::size_t index = 0;
+        pack(record, index, args...);
+        write(record);
+    }
+
+    /**
+     * @brief Stamp \p record and append it to the ring of the calling thread
+     */
+    void write(TraceRecord &record);
+
+    /**
+     * @brief Take every record written so far out of the rings
+     * Records of all threads are passed in time order. Only one drain runs at a time.
+     * @return Number of records passed to \p consumer
+     */
+    std::size_t drain(const Consumer &consumer);
+
+    /**
+     * @brief Records dropped because a ring was full
+     */
+    std::uint64_t dropped() const;
+
+    /**
+     * @brief Capacity of the rings created from now on, rounded up to a power of two
+     */
+    void setCapacity(std::size_t records);
+
+    /**
+     * @brief Text of \p record following \p format
+     */
+    static std::string format(const char *format, const TraceRecord &record);
+
+private:
+    class Ring;
+    struct LocalRings;
+    struct Format {
+        const char *category;                   //!< @param category: category of the records
+        const char *format;                     //!< @param format: format of the records
+    };
+
+    static void pack(TraceRecord &, std::size_t &)
+    {
+    }
+
+    template<typename T, typename... Rest>
+    static void pack(TraceRecord &record, std::size_t &index, const T &value, const Rest &... rest)
+    {
+        packOne(record, index, value);
+        pack(record, index, rest...);
+    }
+
+    template<typename T>
+    static typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value>::type
+    packOne(TraceRecord &record, std::size_t &index, const T &value)
+    {
+        if (index < TraceRecord::MaxArgs) {
+            //Sign extended, %i reads it back as signed.
+            record.args[index++] = std::uint64_t(std::int64_t(value));
+        }
+    }
+
+    template<typename T>
+    static typename std::enable_if<std::is_floating_point<T>::value>::type
+    packOne(TraceRecord &record, std::size_t &index, const T &value)
+    {
+        if (index < TraceRecord::MaxArgs) {
+            const double number = double(value);
+            std::memcpy(&record.args[index++], &number, sizeof(number));
+        }
+    }
+
+    static void packOne(TraceRecord &record, std::size_t &, const TraceText &text)
+    {
+        record.textSize = std::uint32_t(text.size < TraceRecord::MaxText ? text.size : TraceRecord::MaxText);
+        std::memcpy(record.text, text.data, record.textSize);
+    }
+
+    /**
+     * @brief Ring of the calling thread, created on first use
+     */
+    Ring *localRing();
+
+    mutable std::mutex m_mutex;                 //!< @param m_mutex: guards formats and rings
+    std::mutex m_drainMutex;                    //!< @param m_drainMutex: one drain at a time
+    std::vector<Format> m_formats;              //!< @param m_formats: registered formats, id is index + 1
+    std::vector<std::shared_ptr<Ring>> m_rings; //!< @param m_rings: ring of every thread that traced
+    std::atomic<std::uint64_t> m_dropped;       //!< @param m_dropped: drops of the rings already removed
+    std::atomic<std::size_t> m_capacity;        //!< @param m_capacity: capacity of new rings
+    const std::uint64_t m_serial;               //!< @param m_serial: tells the logs apart in the thread local rings
+};
+}
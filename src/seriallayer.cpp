@@ -26,13 +26,12 @@
 #include <QLoggingCategory>
 
 #include "seriallayer.h"
+#include "protocol/lineframer.h"
 
 Q_LOGGING_CATEGORY(SERIAL_LAYER, "org.kde.atelier.core.serialLayer")
 
 namespace
 {
-QByteArray _return = QByteArray("\r");
-QByteArray _newLine = QByteArray("\n");
 QByteArray _newLineReturn = QByteArray("\n\r");
 QStringList _validBaudRates = {
     QStringLiteral("9600"),
@@ -57,7 +56,7 @@ class SerialLayerPrivate
 {
 public:
     bool _serialOpened;                 //!< @param _serialOpened: is serial port opened
-    QByteArray _rawData;                //!< @param _rawData: the raw serial data
+    AtCoreProtocol::LineFramer _framer; //!< @param _framer: splits the raw serial data into lines
     QVector<QByteArray> _rByteCommands; //!< @param _rByteCommand: received Messages
     QVector<QByteArray> _sByteCommands; //!< @param _sByteCommand: sent Messages
 };
@@ -68,33 +67,22 @@ SerialLayer::SerialLayer(const QString &port, uint baud, QObject *parent) :
     setPortName(port);
     setBaudRate(baud);
     open(QIODevice::ReadWrite);
+    d->_framer.setLineHandler([this](const std::string & line) {
+        const QByteArray message(line.data(), int(line.size()));
+        d->_rByteCommands.append(message);
+        emit(receivedCommand(message));
+    });
     connect(this, &QSerialPort::readyRead, this, &SerialLayer::readAllData);
 };
 
 void SerialLayer::readAllData()
 {
-    d->_rawData.append(readAll());
-
     /*
-     * Check if \r exist and remove
-     * Both \n\r and \n are used in string's end and some protocols
+     * Both \n\r and \n are used in string's end and some protocols,
+     * the framer drops \r and hands over every finished line.
      */
-    if (d->_rawData.contains(_return)) {
-        d->_rawData = d->_rawData.replace(_return, QByteArray());
-    }
-
-    QByteArray tempArray;
-    QList<QByteArray> tempList = d->_rawData.split(_newLine.at(0));
-    for (auto i = tempList.begin(); i != tempList.end(); ++i) {
-        // Get finished line to _byteCommands
-        if (i < tempList.end() - 1) {
-            d->_rByteCommands.append(*i);
-            emit(receivedCommand(*i));
-        } else {
-            d->_rawData.clear();
-            d->_rawData.append(*i);
-        }
-    }
+    const QByteArray data = readAll();
+    d->_framer.feed(data.constData(), std::size_t(data.size()));
 }
 
 void SerialLayer::pushCommand(const QByteArray &comm, const QByteArray &term)
@@ -114,6 +102,33 @@ void SerialLayer::pushCommand(const QByteArray &comm)
     pushCommand(comm, _newLineReturn);
 }
 
+void SerialLayer::pushUrgentCommand(const QByteArray &comm, const QByteArray &term)
+{
+    if (!isOpen()) {
+        qCDebug(SERIAL_LAYER) << "Serial not connected !";
+        return;
+    }
+    QByteArray tmp = comm + term;
+    write(tmp);
+    flush();
+    emit(pushedUrgentCommand(tmp));
+    emit(pushedCommand(tmp));
+}
+
+void SerialLayer::pushUrgentCommand(const QByteArray &comm)
+{
+    pushUrgentCommand(comm, _newLineReturn);
+}
+
+void SerialLayer::discardPendingOutput()
+{
+    d->_sByteCommands.clear();
+    if (isOpen()) {
+        //Also discards what the OS has not sent yet (tcflush on unix)
+        clear(QSerialPort::Output);
+    }
+}
+
 void SerialLayer::add(const QByteArray &comm, const QByteArray &term)
 {
     QByteArray tmp = comm + term;
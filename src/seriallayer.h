@@ -55,6 +55,13 @@ signals:
      */
     void pushedCommand(const QByteArray &comm);
 
+    /**
+     * @brief Emit signal when command is pushed ahead of everything else, before pushedCommand()
+     *
+     * @param comm : Command
+     */
+    void pushedUrgentCommand(const QByteArray &comm);
+
     /**
      * @brief Emit signal when command is received
      *
@@ -102,6 +109,35 @@ public:
      */
     void pushCommand(const QByteArray &comm);
 
+    /**
+     * @brief Push command ahead of the normal write path
+     *
+     * The command is written and flushed to the device before returning
+     * instead of waiting for the event loop to drain the write buffer.
+     * It is appended behind the bytes already in the write buffer and does
+     * not overtake them: call discardPendingOutput() first for the command
+     * to be the next bytes sent, it then reaches the device within
+     * urgentLatencyTarget milliseconds.
+     * @param comm : Command
+     * @param term : Terminator
+     */
+    void pushUrgentCommand(const QByteArray &comm, const QByteArray &term);
+
+    /**
+     * @brief Push command ahead of the normal write path
+     *
+     * @param comm : Command, default terminator will be used
+     */
+    void pushUrgentCommand(const QByteArray &comm);
+
+    /**
+     * @brief Drop all output that was not sent to the device yet
+     *
+     * Clears the commands stored with add(), the port write buffer and the
+     * output queue of the operating system.
+     */
+    void discardPendingOutput();
+
     /**
      * @brief Push all commands used in add to serial write
      *
@@ -121,4 +157,9 @@ public:
      * @return QStringList
      */
     QStringList validBaudRates() const;
+
+    /**
+     * @brief Time in milliseconds for an urgent command to reach the device after discardPendingOutput()
+     */
+    static const int urgentLatencyTarget = 5;
 };
@@ -0,0 +1,125 @@
+/* AtCore
+   Copyright (C) <2026>
+
+   Authors:
+       The AtCore contributors
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <QLoggingCategory>
+#include <QSharedMemory>
+
+#include "protocol/seqlock.h"
+#include "sharedsnapshot.h"
+
+Q_LOGGING_CATEGORY(SHARED_SNAPSHOT, "org.kde.atelier.core.sharedSnapshot")
+
+namespace
+{
+typedef AtCoreProtocol::SeqLock<AtCoreProtocol::PrinterSnapshot> SnapshotLock;
+}
+
+/**
+ * @brief The SharedSnapshotPrivate class
+ */
+class SharedSnapshotPrivate
+{
+public:
+    QSharedMemory memory;               //!< @param memory: the segment
+    SnapshotLock *lock = nullptr;       //!< @param lock: SeqLock over the segment, null until created or attached
+    bool owner = false;                 //!< @param owner: the segment was created here
+};
+
+SharedSnapshot::SharedSnapshot(const QString &key)
+    : d(new SharedSnapshotPrivate)
+{
+    d->memory.setKey(key);
+}
+
+SharedSnapshot::~SharedSnapshot()
+{
+    delete d->lock;
+    delete d;
+}
+
+QString SharedSnapshot::key() const
+{
+    return d->memory.key();
+}
+
+bool SharedSnapshot::create()
+{
+    if (!d->memory.create(int(sizeof(SnapshotLock::Storage)))) {
+        qCDebug(SHARED_SNAPSHOT) << "Unable to create" << key() << d->memory.errorString();
+        return false;
+    }
+    //Only this process writes, readers never lock the segment.
+    d->lock = new SnapshotLock(SnapshotLock::initialize(d->memory.data()));
+    d->lock->store(AtCoreProtocol::PrinterSnapshot());
+    d->owner = true;
+    return true;
+}
+
+bool SharedSnapshot::attach()
+{
+    if (!d->memory.attach(QSharedMemory::ReadOnly)) {
+        qCDebug(SHARED_SNAPSHOT) << "Unable to attach to" << key() << d->memory.errorString();
+        return false;
+    }
+    if (d->memory.size() < int(sizeof(SnapshotLock::Storage))) {
+        qCDebug(SHARED_SNAPSHOT) << key() << "is too small for a snapshot.";
+        d->memory.detach();
+        return false;
+    }
+    d->lock = new SnapshotLock(static_cast<SnapshotLock::Storage *>(d->memory.data()));
+    return true;
+}
+
+bool SharedSnapshot::isValid() const
+{
+    return d->lock;
+}
+
+QString SharedSnapshot::errorString() const
+{
+    return d->memory.errorString();
+}
+
+void SharedSnapshot::publish(const AtCoreProtocol::PrinterSnapshot &snapshot)
+{
+    if (d->owner) {
+        d->lock->store(snapshot);
+    }
+}
+
+bool SharedSnapshot::read(AtCoreProtocol::PrinterSnapshot &snapshot) const
+{
+    if (!d->lock) {
+        return false;
+    }
+    const AtCoreProtocol::PrinterSnapshot value = d->lock->load();
+    if (value.layout != AtCoreProtocol::PrinterSnapshot::Layout) {
+        return false;
+    }
+    snapshot = value;
+    return true;
+}
+
+quint32 SharedSnapshot::sequence() const
+{
+    return d->lock ? d->lock->sequence() : 0;
+}
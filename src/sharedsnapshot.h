@@ -0,0 +1,97 @@
+/* AtCore
+   Copyright (C) <2026>
+
+   Authors:
+       The AtCore contributors
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <QString>
+
+#include "atcore_export.h"
+#include "protocol/printersnapshot.h"
+
+class SharedSnapshotPrivate;
+
+/**
+ * @brief The SharedSnapshot class
+ * PrinterSnapshot of a printer in a shared memory segment, for other processes
+ *
+ * The AtCore owning the printer creates the segment and publishes to it, any
+ * number of processes attach to it and read without locking: the segment holds
+ * a SeqLock, readers never wait for the writer nor for each other.
+ * @sa AtCore::exportSnapshot()
+ */
+class ATCORE_EXPORT SharedSnapshot
+{
+public:
+    /**
+     * @brief SharedSnapshot of the segment named \p key
+     */
+    explicit SharedSnapshot(const QString &key);
+    ~SharedSnapshot();
+
+    /**
+     * @brief Name of the segment
+     */
+    QString key() const;
+
+    /**
+     * @brief Create the segment, to publish to it
+     * @return False if it could not be created, see errorString()
+     */
+    bool create();
+
+    /**
+     * @brief Attach to the segment made by create() in another process, to read it
+     * @return False if there is no such segment, see errorString()
+     */
+    bool attach();
+
+    /**
+     * @brief Check the segment was created or attached to
+     */
+    bool isValid() const;
+
+    /**
+     * @brief Why create() or attach() failed
+     */
+    QString errorString() const;
+
+    /**
+     * @brief Publish \p snapshot, only on the created segment
+     */
+    void publish(const AtCoreProtocol::PrinterSnapshot &snapshot);
+
+    /**
+     * @brief Read the last snapshot published
+     * @return False if the segment is not valid or was written with another layout
+     */
+    bool read(AtCoreProtocol::PrinterSnapshot &snapshot) const;
+
+    /**
+     * @brief Count of publications, times two: poll it to read only what changed
+     */
+    quint32 sequence() const;
+
+private:
+    Q_DISABLE_COPY(SharedSnapshot)
+
+    SharedSnapshotPrivate *d;
+};
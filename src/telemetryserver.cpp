@@ -0,0 +1,363 @@
+/* AtCore
+   Copyright (C) <2026>
+
+   Authors:
+       The AtCore contributors
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QLoggingCategory>
+#include <QMap>
+#include <QPointer>
+#include <QSet>
+#include <QTimer>
+#include <QWebSocket>
+#include <QWebSocketServer>
+
+#include <algorithm>
+
+#include "atcore.h"
+#include "telemetryserver.h"
+
+Q_LOGGING_CATEGORY(TELEMETRY_SERVER, "org.kde.atelier.core.telemetryServer")
+
+using AtCoreProtocol::PrinterSnapshot;
+
+namespace
+{
+//Payload QWebSocket puts in one frame before fragmenting a message.
+const qint64 _framePayload = 512 * 1024;
+
+/**
+ * @brief Bytes written for a message of \p payload bytes, frame headers included
+ * QWebSocket::bytesWritten() counts these, sendTextMessage() only the payload.
+ * Frames from the server are not masked.
+ */
+qint64 frameBytes(qint64 payload)
+{
+    qint64 bytes = 0;
+    do {
+        const qint64 size = qMin(payload, _framePayload);
+        bytes += 2 + (size > 0xFFFF ? 8 : size > 125 ? 2 : 0) + size;
+        payload -= size;
+    } while (payload > 0);
+    return bytes;
+}
+
+/**
+ * @brief First \p count values of \p values as a JSON array
+ */
+template<typename T>
+QJsonArray toArray(const T *values, std::size_t count)
+{
+    QJsonArray array;
+    for (std::size_t i = 0; i < count; i++) {
+        array.append(double(values[i]));
+    }
+    return array;
+}
+
+/**
+ * @brief Check the first \p count values of \p a and \p b are the same
+ */
+template<typename T>
+bool sameValues(const T *a, const T *b, std::size_t count)
+{
+    return std::equal(a, a + count, b);
+}
+}
+
+/**
+ * @brief The TelemetryServerPrivate class
+ */
+class TelemetryServerPrivate
+{
+public:
+    /**
+     * @brief A printer published
+     */
+    struct Printer {
+        QPointer<AtCore> core;      //!< @param core: the connection, may be gone
+        PrinterSnapshot last;       //!< @param last: snapshot of the previous tick
+        qint64 sequence = 0;        //!< @param sequence: number of the last update
+    };
+
+    /**
+     * @brief A WebSocket client
+     */
+    struct Client {
+        QWebSocket *socket = nullptr;   //!< @param socket: the connection
+        qint64 backlog = 0;             //!< @param backlog: frame bytes sent and not written yet
+        QSet<QString> printers;         //!< @param printers: printers subscribed to, empty for all
+        QSet<QString> synced;           //!< @param synced: printers the client has the whole state of
+    };
+
+    QWebSocketServer *server = nullptr; //!< @param server: the server
+    QTimer *timer = nullptr;            //!< @param timer: ticks the broadcasts
+    QMap<QString, Printer> printers;    //!< @param printers: printers by name
+    QList<Client *> clients;            //!< @param clients: connected clients
+    int rate = 10;                      //!< @param rate: updates per second
+    qint64 backlogLimit = 256 * 1024;   //!< @param backlogLimit: bytes a client may have waiting
+
+    /**
+     * @brief Forget \p client and let its socket go
+     */
+    void drop(Client *client);
+};
+
+void TelemetryServerPrivate::drop(Client *client)
+{
+    clients.removeOne(client);
+    client->socket->disconnect();
+    client->socket->deleteLater();
+    delete client;
+}
+
+TelemetryServer::TelemetryServer(QObject *parent)
+    : QObject(parent)
+    , d(new TelemetryServerPrivate)
+{
+    d->server = new QWebSocketServer(QStringLiteral("AtCore"), QWebSocketServer::NonSecureMode, this);
+    d->timer = new QTimer(this);
+    d->timer->setInterval(1000 / d->rate);
+    connect(d->server, &QWebSocketServer::newConnection, this, &TelemetryServer::acceptClients);
+    connect(d->timer, &QTimer::timeout, this, &TelemetryServer::broadcast);
+}
+
+TelemetryServer::~TelemetryServer()
+{
+    close();
+    delete d;
+}
+
+bool TelemetryServer::listen(const QHostAddress &address, quint16 port)
+{
+    if (!d->server->listen(address, port)) {
+        qCDebug(TELEMETRY_SERVER) << "Unable to listen on" << address << port << d->server->errorString();
+        return false;
+    }
+    d->timer->start();
+    return true;
+}
+
+quint16 TelemetryServer::port() const
+{
+    return d->server->serverPort();
+}
+
+void TelemetryServer::close()
+{
+    d->timer->stop();
+    while (!d->clients.isEmpty()) {
+        QWebSocket *socket = d->clients.first()->socket;
+        d->drop(d->clients.first());
+        socket->close();
+    }
+    d->server->close();
+}
+
+void TelemetryServer::addPrinter(const QString &name, AtCore *core)
+{
+    TelemetryServerPrivate::Printer printer;
+    printer.core = core;
+    d->printers.insert(name, printer);
+    for (TelemetryServerPrivate::Client *client : d->clients) {
+        client->synced.remove(name);
+    }
+}
+
+void TelemetryServer::removePrinter(const QString &name)
+{
+    d->printers.remove(name);
+}
+
+int TelemetryServer::clientCount() const
+{
+    return d->clients.size();
+}
+
+int TelemetryServer::rate() const
+{
+    return d->rate;
+}
+
+void TelemetryServer::setRate(int rate)
+{
+    d->rate = qBound(1, rate, 60);
+    d->timer->setInterval(1000 / d->rate);
+}
+
+qint64 TelemetryServer::backlogLimit() const
+{
+    return d->backlogLimit;
+}
+
+void TelemetryServer::setBacklogLimit(qint64 bytes)
+{
+    d->backlogLimit = qMax<qint64>(1024, bytes);
+}
+
+void TelemetryServer::acceptClients()
+{
+    while (QWebSocket *socket = d->server->nextPendingConnection()) {
+        TelemetryServerPrivate::Client *client = new TelemetryServerPrivate::Client;
+        client->socket = socket;
+        socket->setParent(this);
+        connect(socket, &QWebSocket::bytesWritten, this, [client](qint64 bytes) {
+            client->backlog = qMax<qint64>(0, client->backlog - bytes);
+        });
+        connect(socket, &QWebSocket::textMessageReceived, this, [client](const QString & message) {
+            const QJsonObject request = QJsonDocument::fromJson(message.toUtf8()).object();
+            if (request.contains(QStringLiteral("subscribe"))) {
+                client->printers.clear();
+                client->synced.clear();
+                for (const QJsonValue &printer : request.value(QStringLiteral("subscribe")).toArray()) {
+                    client->printers.insert(printer.toString());
+                }
+            }
+        });
+        connect(socket, &QWebSocket::disconnected, this, [this, client] {
+            d->drop(client);
+        });
+        d->clients.append(client);
+        qCDebug(TELEMETRY_SERVER) << "Client connected from" << socket->peerAddress();
+    }
+}
+
+void TelemetryServer::broadcast()
+{
+    if (d->clients.isEmpty()) {
+        //Nobody to send to, the next client starts from full snapshots anyway.
+        return;
+    }
+    //Every update is encoded once, clients get the same bytes.
+    QMap<QString, QByteArray> deltas;
+    for (auto it = d->printers.begin(); it != d->printers.end(); ++it) {
+        if (!it->core) {
+            continue;
+        }
+        const PrinterSnapshot snapshot = it->core->snapshot();
+        QJsonObject changes = delta(it->last, snapshot);
+        it->last = snapshot;
+        if (changes.isEmpty()) {
+            continue;
+        }
+        it->sequence++;
+        changes.insert(QStringLiteral("printer"), it.key());
+        changes.insert(QStringLiteral("seq"), it->sequence);
+        deltas.insert(it.key(), QJsonDocument(changes).toJson(QJsonDocument::Compact));
+    }
+    //Full snapshots only for the clients missing them.
+    QMap<QString, QByteArray> fulls;
+    auto fullUpdate = [this, &fulls](const QString & name) -> const QByteArray & {
+        auto full = fulls.find(name);
+        if (full == fulls.end()) {
+            const TelemetryServerPrivate::Printer &printer = d->printers[name];
+            QJsonObject fields = delta(printer.last, printer.last, true);
+            fields.insert(QStringLiteral("printer"), name);
+            fields.insert(QStringLiteral("seq"), printer.sequence);
+            fields.insert(QStringLiteral("full"), true);
+            full = fulls.insert(name, QJsonDocument(fields).toJson(QJsonDocument::Compact));
+        }
+        return full.value();
+    };
+
+    const QList<TelemetryServerPrivate::Client *> clients = d->clients;
+    for (TelemetryServerPrivate::Client *client : clients) {
+        if (client->backlog > 4 * d->backlogLimit) {
+            qCDebug(TELEMETRY_SERVER) << "Dropping slow client" << client->socket->peerAddress();
+            QWebSocket *socket = client->socket;
+            d->drop(client);
+            socket->abort();
+            continue;
+        }
+        if (client->backlog > d->backlogLimit) {
+            //Missing updates, it needs whole snapshots once it caught up.
+            client->synced.clear();
+            continue;
+        }
+        QByteArray message("[");
+        for (auto it = d->printers.constBegin(); it != d->printers.constEnd(); ++it) {
+            const QString &name = it.key();
+            if (!it->core || (!client->printers.isEmpty() && !client->printers.contains(name))) {
+                continue;
+            }
+            if (!client->synced.contains(name)) {
+                client->synced.insert(name);
+                message.append(fullUpdate(name)).append(',');
+            } else if (deltas.contains(name)) {
+                message.append(deltas.value(name)).append(',');
+            }
+        }
+        if (message.size() == 1) {
+            continue;
+        }
+        message[message.size() - 1] = ']';
+        client->backlog += frameBytes(client->socket->sendTextMessage(QString::fromUtf8(message)));
+    }
+}
+
+QJsonObject TelemetryServer::delta(const PrinterSnapshot &from, const PrinterSnapshot &to, bool full)
+{
+    QJsonObject changes;
+    if (full || from.state != to.state) {
+        changes.insert(QStringLiteral("state"), to.state);
+    }
+    const bool heaters = full || from.heaterCount != to.heaterCount;
+    if (heaters || !sameValues(from.temperature, to.temperature, to.heaterCount)) {
+        changes.insert(QStringLiteral("temperature"), toArray(to.temperature, to.heaterCount));
+    }
+    if (heaters || !sameValues(from.target, to.target, to.heaterCount)) {
+        changes.insert(QStringLiteral("target"), toArray(to.target, to.heaterCount));
+    }
+    if (to.hasPosition && (full || !from.hasPosition || !sameValues(from.position, to.position, 3))) {
+        changes.insert(QStringLiteral("position"), toArray(to.position, 3));
+    }
+    if (full || from.progress != to.progress) {
+        changes.insert(QStringLiteral("progress"), double(to.progress));
+    }
+    if (full || from.layer != to.layer) {
+        changes.insert(QStringLiteral("layer"), to.layer);
+    }
+    if (full || from.layerCount != to.layerCount) {
+        changes.insert(QStringLiteral("layerCount"), to.layerCount);
+    }
+    if (full || from.timeLeft != to.timeLeft) {
+        changes.insert(QStringLiteral("timeLeft"), double(to.timeLeft));
+    }
+    if (full || from.queueDepth != to.queueDepth) {
+        changes.insert(QStringLiteral("queueDepth"), int(to.queueDepth));
+    }
+    if (full || from.inFlight != to.inFlight) {
+        changes.insert(QStringLiteral("inFlight"), int(to.inFlight));
+    }
+    if (full || from.commandsSent != to.commandsSent) {
+        changes.insert(QStringLiteral("commandsSent"), double(to.commandsSent));
+    }
+    if (full || from.commandsAcknowledged != to.commandsAcknowledged) {
+        changes.insert(QStringLiteral("commandsAcknowledged"), double(to.commandsAcknowledged));
+    }
+    if (full || from.bytesSent != to.bytesSent) {
+        changes.insert(QStringLiteral("bytesSent"), double(to.bytesSent));
+    }
+    if (full || from.linesReceived != to.linesReceived) {
+        changes.insert(QStringLiteral("linesReceived"), double(to.linesReceived));
+    }
+    return changes;
+}
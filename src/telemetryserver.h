@@ -0,0 +1,132 @@
+/* AtCore
+   Copyright (C) <2026>
+
+   Authors:
+       The AtCore contributors
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <QHostAddress>
+#include <QJsonObject>
+#include <QObject>
+
+#include "atcore_export.h"
+#include "protocol/printersnapshot.h"
+
+class AtCore;
+class TelemetryServerPrivate;
+
+/**
+ * @brief The TelemetryServer class
+ * Pushes the snapshots of many printers to WebSocket clients, ex browsers
+ *
+ * At every tick (see setRate()) the AtCore::snapshot() of each printer is read and
+ * compared with the previous one. What changed is encoded once per printer and the
+ * same bytes go to every client, in one text message per client holding a JSON array:
+ * [{"printer": "name", "seq": 12, "state": 3, "temperature": [60, 210]}, ...]
+ * A client first gets every field of a printer, with "full": true, then only changes.
+ *
+ * A client may send {"subscribe": ["name", ...]} to only get some printers.
+ * Clients not reading fast enough are not buffered for: past backlogLimit() they
+ * miss updates and get a full snapshot again once caught up, past four times the
+ * limit they are disconnected. The work per printer does not grow with the clients.
+ */
+class ATCORE_EXPORT TelemetryServer : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(int rate READ rate WRITE setRate)
+    Q_PROPERTY(qint64 backlogLimit READ backlogLimit WRITE setBacklogLimit)
+
+public:
+    explicit TelemetryServer(QObject *parent = nullptr);
+    ~TelemetryServer() override;
+
+    /**
+     * @brief Accept clients on \p address, port \p port
+     * @param port: 0 to let the system choose, see port()
+     * @return False if the port could not be opened
+     */
+    bool listen(const QHostAddress &address = QHostAddress::LocalHost, quint16 port = 0);
+
+    /**
+     * @brief Port clients connect to
+     */
+    quint16 port() const;
+
+    /**
+     * @brief Disconnect every client and stop listening
+     */
+    void close();
+
+    /**
+     * @brief Publish the snapshots of \p core as printer \p name
+     */
+    void addPrinter(const QString &name, AtCore *core);
+
+    /**
+     * @brief Stop publishing printer \p name
+     */
+    void removePrinter(const QString &name);
+
+    /**
+     * @brief Number of clients connected
+     */
+    int clientCount() const;
+
+    /**
+     * @brief Updates sent per second
+     */
+    int rate() const;
+
+    /**
+     * @brief Bytes a client may have waiting before it misses updates
+     */
+    qint64 backlogLimit() const;
+
+    /**
+     * @brief Fields of \p to that differ from \p from
+     * @param full: every field, whatever changed
+     */
+    static QJsonObject delta(const AtCoreProtocol::PrinterSnapshot &from, const AtCoreProtocol::PrinterSnapshot &to, bool full = false);
+
+public slots:
+    /**
+     * @brief Set the updates sent per second, 1 to 60, default 10
+     */
+    void setRate(int rate);
+
+    /**
+     * @brief Set the bytes a client may have waiting, default 256 KiB
+     */
+    void setBacklogLimit(qint64 bytes);
+
+private slots:
+    /**
+     * @brief Take the clients waiting
+     */
+    void acceptClients();
+
+    /**
+     * @brief Send what changed to every client
+     */
+    void broadcast();
+
+private:
+    TelemetryServerPrivate *d;
+};
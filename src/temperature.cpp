@@ -22,10 +22,10 @@
     You should have received a copy of the GNU Lesser General Public
     License along with this library.  If not, see <http://www.gnu.org/licenses/>.
 */
-#include <QRegularExpressionMatch>
 #include <cmath>
 
 #include "temperature.h"
+#include "protocol/messages.h"
 /**
  * @brief The TemperaturePrivate class
  *
@@ -92,46 +92,15 @@ void Temperature::setExtruderTemperature(float temp)
 
 void Temperature::decodeTemp(const QByteArray &msg)
 {
-    int bloc = msg.indexOf(QStringLiteral("B:"));
+    AtCoreProtocol::TemperatureReport report;
+    AtCoreProtocol::parseTemperature(msg.constData(), std::size_t(msg.size()), report);
 
-    float firstTargetTemperature = 0;
-    float secondTargetTemperature = 0;
-
-    QRegularExpression tempRegEx(QStringLiteral("(T:(?<extruder>\\d+\\.?\\d*))"));
-    QRegularExpression targetTempRegEx(QStringLiteral("(\\/)(?<extruderTarget>\\d*)(.+)"));
-    QRegularExpressionMatch tempCheck = tempRegEx.match(QString::fromLatin1(msg));
-    QRegularExpressionMatch targetTempCheck = targetTempRegEx.match(QString::fromLatin1(msg));
-
-    if (tempCheck.hasMatch()) {
-        setExtruderTemperature(tempCheck.captured(QStringLiteral("extruder")).toFloat());
-    }
-
-    if (targetTempCheck.hasMatch()) {
-        firstTargetTemperature = targetTempCheck.captured(QStringLiteral("extruderTarget")).toFloat();
-    }
-
-    if (bloc != -1) {
-        QRegularExpression bedRegEx(QStringLiteral("(B:(?<bed>\\d+\\.?\\d*))"));
-        QRegularExpressionMatch bedCheck = bedRegEx.match(QString::fromLatin1(msg));
-        QRegularExpression targetBedRegEx(QStringLiteral("B:(.+)(\\/)(?<bedTarget>\\d+)"));
-        QRegularExpressionMatch targetBedCheck = targetBedRegEx.match(QString::fromLatin1(msg));
-
-        if (bedCheck.hasMatch()) {
-            setBedTemperature(bedCheck.captured(QStringLiteral("bed")).toFloat());
-        }
-
-        if (targetBedCheck.hasMatch()) {
-            secondTargetTemperature = targetBedCheck.captured(QStringLiteral("bedTarget")).toFloat();
-        }
+    if (report.hasExtruder) {
+        setExtruderTemperature(report.extruder);
     }
-    //Currently the first value after / is stored in firstTargetTemperature and the second / in secondTargetTemperature
-    //Because of this we need to check what came first in the return and place the values
-    //The regex for temperature needs to look at the whole T: or B: block to correctly decode targets
-    if (bloc < msg.indexOf(QStringLiteral("T:")) && bloc != -1) {
-        setExtruderTargetTemperature(secondTargetTemperature);
-        setBedTargetTemperature(firstTargetTemperature);
-    } else {
-        setExtruderTargetTemperature(firstTargetTemperature);
-        setBedTargetTemperature(secondTargetTemperature);
+    if (report.hasBed) {
+        setBedTemperature(report.bed);
     }
+    setExtruderTargetTemperature(report.extruderTarget);
+    setBedTargetTemperature(report.bedTarget);
 }
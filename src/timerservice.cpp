@@ -0,0 +1,150 @@
+/* AtCore
+   Copyright (C) <2026>
+
+   Authors:
+       The AtCore contributors
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <QElapsedTimer>
+#include <QLoggingCategory>
+#include <QPointer>
+#include <QThreadStorage>
+#include <QTimer>
+
+#include <climits>
+#include <memory>
+
+#include "timerservice.h"
+#include "protocol/timerwheel.h"
+
+Q_LOGGING_CATEGORY(TIMER_SERVICE, "org.kde.atelier.core.timerService")
+
+/**
+ * @brief The TimerServicePrivate class
+ */
+class TimerServicePrivate
+{
+public:
+    AtCoreProtocol::TimerWheel wheel;   //!< @param wheel: every timer of the thread
+    QElapsedTimer clock;                //!< @param clock: time given to the wheel
+    QTimer *alarm = nullptr;            //!< @param alarm: wakes the thread for the next timer due
+    quint64 wakeups = 0;                //!< @param wakeups: times the alarm fired
+    bool advancing = false;             //!< @param advancing: timers are running, the alarm is set once they are done
+};
+
+namespace
+{
+QThreadStorage<TimerService *> _services;
+}
+
+TimerService::TimerService()
+    : d(new TimerServicePrivate)
+{
+    d->clock.start();
+    d->alarm = new QTimer(this);
+    d->alarm->setSingleShot(true);
+    d->alarm->setTimerType(Qt::CoarseTimer);
+    connect(d->alarm, &QTimer::timeout, this, &TimerService::wake);
+}
+
+TimerService::~TimerService()
+{
+    delete d;
+}
+
+TimerService *TimerService::instance()
+{
+    if (!_services.hasLocalData()) {
+        _services.setLocalData(new TimerService);
+    }
+    return _services.localData();
+}
+
+TimerService::TimerId TimerService::start(QObject *context, int intervalMsecs, std::function<void()> work, int jitterMsecs)
+{
+    const quint64 interval = quint64(qMax(intervalMsecs, 1));
+    const quint64 jitter = jitterMsecs < 0 ? interval : quint64(jitterMsecs);
+
+    //The wheel counts delays from its last advance, bring it to now first.
+    if (!d->advancing) {
+        d->advancing = true;
+        d->wheel.advance(quint64(d->clock.elapsed()));
+        d->advancing = false;
+    }
+
+    //The id is only known once scheduled, the callback reads it to stop itself.
+    auto id = std::make_shared<TimerId>(0);
+    QPointer<QObject> guard(context);
+    *id = d->wheel.schedule(interval, interval, [this, id, guard, work] {
+        if (!guard) {
+            d->wheel.cancel(*id);
+            return;
+        }
+        work();
+    }, jitter);
+
+    qCDebug(TIMER_SERVICE) << "Timer" << *id << "every" << interval << "msecs, timers:" << timerCount();
+    reschedule();
+    return *id;
+}
+
+void TimerService::stop(TimerId timer)
+{
+    if (timer == 0) {
+        return;
+    }
+    d->wheel.cancel(timer);
+    reschedule();
+}
+
+bool TimerService::isActive(TimerId timer) const
+{
+    return timer != 0 && d->wheel.isActive(timer);
+}
+
+int TimerService::timerCount() const
+{
+    return int(d->wheel.size());
+}
+
+quint64 TimerService::wakeups() const
+{
+    return d->wakeups;
+}
+
+void TimerService::wake()
+{
+    d->wakeups++;
+    d->advancing = true;
+    d->wheel.advance(quint64(d->clock.elapsed()));
+    d->advancing = false;
+    reschedule();
+}
+
+void TimerService::reschedule()
+{
+    if (d->advancing) {
+        return;
+    }
+    const qint64 next = d->wheel.msecsToNext(quint64(d->clock.elapsed()));
+    if (next < 0) {
+        d->alarm->stop();
+        return;
+    }
+    d->alarm->start(int(qMin<qint64>(next, INT_MAX)));
+}
@@ -0,0 +1,105 @@
+/* AtCore
+   Copyright (C) <2026>
+
+   Authors:
+       The AtCore contributors
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <QObject>
+
+#include <functional>
+
+#include "atcore_export.h"
+
+class TimerServicePrivate;
+
+/**
+ * @brief The TimerService class
+ * Periodic work of every connection of a thread, driven by one timer wheel
+ *
+ * Each connection used to own a handful of QTimers, polling temperatures, status
+ * and serial ports, so a farm of idle printers woke the thread once per timer.
+ * The service keeps them all in one AtCoreProtocol::TimerWheel behind a single
+ * coarse QTimer: the thread wakes once for every timer due at that time, and
+ * jitter keeps connections opened together from polling in lock step.
+ * Use it from the thread the work belongs to, each thread has its own service.
+ */
+class ATCORE_EXPORT TimerService : public QObject
+{
+    Q_OBJECT
+public:
+    /**
+     * @brief Identifier of a timer of the service, 0 is never used
+     */
+    typedef quint64 TimerId;
+
+    /**
+     * @brief The service of the calling thread, created on first use
+     */
+    static TimerService *instance();
+
+    ~TimerService() override;
+
+    /**
+     * @brief Run \p work every \p intervalMsecs until stopped or \p context is destroyed
+     * @param context: object the work belongs to, the timer stops with it
+     * @param intervalMsecs: msecs between runs, the first run is one interval from now
+     * @param work: function to run, it may start and stop timers
+     * @param jitterMsecs: the first run is delayed by a random amount up to this, -1 for the interval
+     * @return id of the timer
+     */
+    TimerId start(QObject *context, int intervalMsecs, std::function<void()> work, int jitterMsecs = -1);
+
+    /**
+     * @brief Stop \p timer, nothing happens if it is not running
+     */
+    void stop(TimerId timer);
+
+    /**
+     * @brief True if \p timer is running
+     */
+    bool isActive(TimerId timer) const;
+
+    /**
+     * @brief Number of running timers
+     */
+    int timerCount() const;
+
+    /**
+     * @brief Number of times the service woke its thread
+     */
+    quint64 wakeups() const;
+
+private:
+    TimerService();
+    Q_DISABLE_COPY(TimerService)
+
+    /**
+     * @brief Run every timer due and sleep until the next one
+     */
+    void wake();
+
+    /**
+     * @brief Restart the wake up timer for the next timer due
+     */
+    void reschedule();
+
+    TimerServicePrivate *d;
+};
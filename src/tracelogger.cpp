@@ -0,0 +1,113 @@
+/* AtCore
+   Copyright (C) <2026>
+
+   Authors:
+       The AtCore contributors
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <QLoggingCategory>
+#include <QMessageLogger>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QWaitCondition>
+
+#include "tracelogger.h"
+
+Q_LOGGING_CATEGORY(TRACE_LOGGER, "org.kde.atelier.core.traceLogger")
+
+/**
+ * @brief The TraceLoggerPrivate class
+ */
+class TraceLoggerPrivate
+{
+public:
+    AtCoreProtocol::TraceLog log;   //!< @param log: rings drained by the thread, outlives it
+    QMutex mutex;                   //!< @param mutex: guards the other members
+    QWaitCondition wake;            //!< @param wake: wakes the thread early to stop
+    int interval = 100;             //!< @param interval: msecs between two drains
+    bool stopping = false;          //!< @param stopping: the logger is being destroyed
+    quint64 dropped = 0;            //!< @param dropped: drops already reported
+};
+
+TraceLogger::TraceLogger()
+    : d(new TraceLoggerPrivate)
+{
+    setObjectName(QStringLiteral("TraceLogger"));
+    start(QThread::LowestPriority);
+}
+
+TraceLogger::~TraceLogger()
+{
+    {
+        QMutexLocker lock(&d->mutex);
+        d->stopping = true;
+        d->wake.wakeAll();
+    }
+    wait();
+    delete d;
+}
+
+TraceLogger *TraceLogger::instance()
+{
+    static TraceLogger logger;
+    return &logger;
+}
+
+AtCoreProtocol::TraceLog &TraceLogger::log()
+{
+    return d->log;
+}
+
+int TraceLogger::interval() const
+{
+    QMutexLocker lock(&d->mutex);
+    return d->interval;
+}
+
+void TraceLogger::setInterval(int msecs)
+{
+    QMutexLocker lock(&d->mutex);
+    d->interval = qMax(1, msecs);
+}
+
+int TraceLogger::flush()
+{
+    const std::size_t count = d->log.drain([](const AtCoreProtocol::TraceRecord & record, const char *category, const char *format) {
+        QMessageLogger(nullptr, 0, nullptr, category).debug().noquote()
+                << QString::fromStdString(AtCoreProtocol::TraceLog::format(format, record));
+    });
+
+    const quint64 dropped = d->log.dropped();
+    QMutexLocker lock(&d->mutex);
+    if (dropped != d->dropped) {
+        qCDebug(TRACE_LOGGER) << "Dropped" << dropped - d->dropped << "trace messages, the rings were full";
+        d->dropped = dropped;
+    }
+    return int(count);
+}
+
+void TraceLogger::run()
+{
+    QMutexLocker lock(&d->mutex);
+    while (!d->stopping) {
+        d->wake.wait(&d->mutex, ulong(d->interval));
+        lock.unlock();
+        flush();
+        lock.relock();
+    }
+}
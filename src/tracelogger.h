@@ -0,0 +1,125 @@
+/* AtCore
+   Copyright (C) <2026>
+
+   Authors:
+       The AtCore contributors
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <QByteArray>
+#include <QThread>
+
+#include "atcore_export.h"
+#include "protocol/tracelog.h"
+
+class TraceLoggerPrivate;
+
+/**
+ * @brief Trace \p category like qCDebug, formatting the message later on the TraceLogger thread
+ *
+ * Takes a printf like format, see AtCoreProtocol::TraceLog, then its arguments:
+ * numbers, and text passed through TraceLogger::text(). Nothing is done while
+ * the debug output of \p category is disabled.
+ * @code
+ * ATCORE_TRACE(PRINT_THREAD, "progress: %f layer: %i", d->printProgress, layer);
+ * @endcode
+ */
+#define ATCORE_TRACE(category, ...) \
+    do { \
+        if (category().isDebugEnabled()) { \
+            static AtCoreProtocol::TraceSite _traceSite; \
+            TraceLogger::trace(_traceSite, category().categoryName(), __VA_ARGS__); \
+        } \
+    } while (false)
+
+/**
+ * @brief The TraceLogger class
+ * Background thread turning the records of ATCORE_TRACE into debug messages
+ *
+ * Hot paths trace into rings of their own thread, see AtCoreProtocol::TraceLog,
+ * this thread drains them a few times per second and sends each message to the
+ * category it was traced in, so debug output keeps its usual filters and
+ * handlers without formatting on the traced thread.
+ */
+class ATCORE_EXPORT TraceLogger : public QThread
+{
+    Q_OBJECT
+public:
+    /**
+     * @brief The logger of the process, started on first use
+     */
+    static TraceLogger *instance();
+
+    ~TraceLogger() override;
+
+    /**
+     * @brief Trace from \p site into log(), starting the logger on its first trace
+     * Used by ATCORE_TRACE.
+     */
+    template<typename... Args>
+    static void trace(AtCoreProtocol::TraceSite &site, const char *category, const char *format, const Args &... args)
+    {
+        instance()->log().trace(site, category, format, args...);
+    }
+
+    /**
+     * @brief The trace log of the process, drained by the logger and destroyed with it
+     */
+    AtCoreProtocol::TraceLog &log();
+
+    /**
+     * @brief Text argument of a trace without its line end, only the first bytes are kept
+     */
+    static AtCoreProtocol::TraceText text(const QByteArray &text)
+    {
+        int size = text.size();
+        while (size > 0 && (text.at(size - 1) == '\n' || text.at(size - 1) == '\r')) {
+            size--;
+        }
+        return AtCoreProtocol::TraceText{text.constData(), std::size_t(size)};
+    }
+
+    /**
+     * @brief Milliseconds between two drains
+     */
+    int interval() const;
+
+    /**
+     * @brief Set the milliseconds between two drains
+     */
+    void setInterval(int msecs);
+
+    /**
+     * @brief Send every message traced so far, from the calling thread
+     * @return Number of messages sent
+     */
+    int flush();
+
+protected:
+    /**
+     * @brief Drain the rings every interval() until the logger is destroyed
+     */
+    void run() override;
+
+private:
+    TraceLogger();
+    Q_DISABLE_COPY(TraceLogger)
+
+    TraceLoggerPrivate *d;
+};
@@ -535,7 +535,10 @@ void MainWindow::updatePrintTime()
 void MainWindow::printProgressChanged(int progress)
 {
     ui->printingProgress->setValue(progress);
-    if (progress > 0) {
+    if (core->printTimeLeft() > 0) {
+        QTime temp(0, 0, 0);
+        ui->timeLeft->setText(temp.addMSecs(core->printTimeLeft()).toString(QStringLiteral("hh:mm:ss")));
+    } else if (progress > 0) {
         QTime temp(0, 0, 0);
         ui->timeLeft->setText(temp.addMSecs((100 - progress) * (printTime->elapsed() / progress)).toString(QStringLiteral("hh:mm:ss")));
     } else {
@@ -19,6 +19,10 @@
 #include <algorithm>
 
 #include "atcoretests.h"
+#include "../src/commandreply.h"
+#include "../src/compressedjob.h"
+#include "../src/printthread.h"
+#include "../src/timerservice.h"
 
 void AtCoreTests::initTestCase()
 {
@@ -43,6 +47,7 @@ void AtCoreTests::testPluginDetect()
         QStringLiteral("grbl"),
         QStringLiteral("marlin"),
         QStringLiteral("repetier"),
+        QStringLiteral("reprapfirmware"),
         QStringLiteral("smoothie"),
         QStringLiteral("sprinter"),
         QStringLiteral("teacup")
@@ -59,6 +64,158 @@ void AtCoreTests::testConnectInvalidDevice()
     QVERIFY(core->initSerial(QStringLiteral("/dev/ptyp5"), 9600));
 }
 
+void AtCoreTests::testSnapshot()
+{
+    AtCore other;
+    QVERIFY(other.snapshot().state == AtCore::DISCONNECTED);
+    other.temperature().setBedTemperature(55);
+    other.temperature().setExtruderTargetTemperature(200);
+    const AtCoreProtocol::PrinterSnapshot snapshot = other.snapshot();
+    QVERIFY(snapshot.heaterCount == 2);
+    QVERIFY(snapshot.temperature[0] == 55);
+    QVERIFY(snapshot.target[1] == 200);
+    QVERIFY(snapshot.hasPosition == 0);
+    QVERIFY(snapshot.commandsSent == 0);
+}
+
+void AtCoreTests::testSnapshotPosition()
+{
+    AtCore other;
+    QMetaObject::invokeMethod(&other, "newMessage", Q_ARG(QByteArray, QByteArrayLiteral("X:10.00 Y:-2.50 Z:0.30 E:4.00 Count X:800 Y:-200 Z:120")));
+    const AtCoreProtocol::PrinterSnapshot snapshot = other.snapshot();
+    QVERIFY(snapshot.hasPosition == 1);
+    QCOMPARE(snapshot.position[0], 10.0);
+    QCOMPARE(snapshot.position[1], -2.5);
+    QCOMPARE(snapshot.position[2], 0.3);
+}
+
+void AtCoreTests::testPrintDisconnected()
+{
+    //Refused at once, nothing reaches the print worker.
+    AtCore other;
+    QFile *job = new QFile(QStringLiteral("/nonexistent/job.gcode"));
+    QSignalSpy destroyedSpy(job, &QObject::destroyed);
+    other.print(job);
+    QTRY_COMPARE(destroyedSpy.count(), 1);
+    other.print(QStringLiteral("/nonexistent/job.gcode"));
+    QCOMPARE(other.state(), AtCore::DISCONNECTED);
+}
+
+void AtCoreTests::testPrintMissingFile()
+{
+    AtCore other;
+    PrintThread worker(&other);
+    QSignalSpy errorSpy(&worker, &PrintThread::error);
+    worker.start(QStringLiteral("/nonexistent/job.gcode"));
+    QTRY_COMPARE(errorSpy.count(), 1);
+    QVERIFY(errorSpy.first().first().toString().contains(QStringLiteral("job.gcode")));
+    QTRY_COMPARE(other.state(), AtCore::IDLE);
+}
+
+void AtCoreTests::testPrintDeviceOpenFailure()
+{
+    AtCore other;
+    PrintThread worker(&other);
+    QSignalSpy errorSpy(&worker, &PrintThread::error);
+    QFile *job = new QFile(QStringLiteral("/nonexistent/job.gcode"));
+    QSignalSpy destroyedSpy(job, &QObject::destroyed);
+    worker.start(job);
+    QTRY_COMPARE(errorSpy.count(), 1);
+    QTRY_COMPARE(other.state(), AtCore::IDLE);
+    QTRY_COMPARE(destroyedSpy.count(), 1);
+}
+
+void AtCoreTests::testPrintLineTooLong()
+{
+    QTemporaryDir dir;
+    const QString fileName = dir.filePath(QStringLiteral("long.gcode"));
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write("M117 this message is longer than the firmware accepts\nG28\n");
+    file.close();
+
+    AtCore other;
+    PrintThread worker(&other);
+    QSignalSpy errorSpy(&worker, &PrintThread::error);
+    QSignalSpy commandSpy(&worker, &PrintThread::nextCommand);
+    worker.start(fileName, false, false, 0, 1, 32);
+    QCOMPARE(errorSpy.count(), 1);
+    QVERIFY(commandSpy.isEmpty());
+    QTRY_COMPARE(other.state(), AtCore::ERRORSTATE);
+}
+
+void AtCoreTests::testPrintUnsupportedCompression()
+{
+    if (CompressedJob::isSupported(CompressedJob::Zstd)) {
+        QSKIP("AtCore was built with zstd");
+    }
+    QTemporaryDir dir;
+    const QString fileName = dir.filePath(QStringLiteral("job.gcode.zst"));
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    //Zstandard frame magic number, little endian.
+    file.write(QByteArray::fromHex("28b52ffd"));
+    file.close();
+    QCOMPARE(CompressedJob::detect(fileName), CompressedJob::Zstd);
+
+    AtCore other;
+    PrintThread worker(&other);
+    QSignalSpy errorSpy(&worker, &PrintThread::error);
+    worker.start(fileName);
+    QTRY_COMPARE(errorSpy.count(), 1);
+    QVERIFY(errorSpy.first().first().toString().contains(QStringLiteral("job.gcode.zst")));
+    QTRY_COMPARE(other.state(), AtCore::IDLE);
+}
+
+void AtCoreTests::testRequestAbortedByStop()
+{
+    //Not connected, the commands wait in the queue until stop() drops them.
+    AtCore other;
+    CommandReply *reply = other.request(QStringLiteral("M114"));
+    CommandReply *batch = other.pushCommands({QByteArrayLiteral("G28"), QByteArrayLiteral("G29")});
+    QSignalSpy abortedSpy(reply, &CommandReply::aborted);
+    QSignalSpy finishedSpy(reply, &CommandReply::finished);
+    QSignalSpy batchSpy(batch, &CommandReply::finished);
+    other.stop();
+    QTRY_COMPARE(finishedSpy.count(), 1);
+    QCOMPARE(abortedSpy.count(), 1);
+    QVERIFY(reply->isFinished());
+    QVERIFY(reply->isAborted());
+    QVERIFY(reply->lines().isEmpty());
+    QTRY_COMPARE(batchSpy.count(), 1);
+    QVERIFY(batch->isAborted());
+}
+
+void AtCoreTests::testTimersFollowThread()
+{
+    TimerService *service = TimerService::instance();
+    const int before = service->timerCount();
+    AtCore *other = new AtCore;
+    other->setSerialTimerInterval(100);
+    QCOMPARE(service->timerCount(), before + 1);
+
+    QThread thread;
+    QObject probe;
+    probe.moveToThread(&thread);
+    thread.start();
+    other->moveToThread(&thread);
+    QCOMPARE(service->timerCount(), before);
+
+    //Timers of the new thread are only seen from it.
+    QAtomicInt moved(0);
+    const auto movedTimers = [&probe, &moved] {
+        QTimer::singleShot(0, &probe, [&moved] {
+            moved.store(TimerService::instance()->timerCount());
+        });
+        return moved.load();
+    };
+    QTRY_COMPARE(movedTimers(), 1);
+
+    QMetaObject::invokeMethod(other, "deleteLater", Qt::QueuedConnection);
+    thread.quit();
+    thread.wait();
+}
+
 void AtCoreTests::testPluginAprinter_load()
 {
     core->loadFirmwarePlugin(QStringLiteral("aprinter"));
@@ -85,10 +242,24 @@ void AtCoreTests::testPluginGrbl_validate()
     QSignalSpy sSpy(core->firmwarePlugin(), SIGNAL(readyForCommand()));
     QVERIFY(sSpy.isValid() == true);
     core->firmwarePlugin()->validateCommand(QStringLiteral("ok"));
+    core->firmwarePlugin()->validateCommand(QStringLiteral("error:20"));
     core->firmwarePlugin()->validateCommand(QStringLiteral("other text"));
+    core->firmwarePlugin()->validateCommand(QStringLiteral("<Idle|MPos:0.000,0.000,0.000|FS:0,0>"));
     QVERIFY(sSpy.count() == 2);
 }
 
+void AtCoreTests::testPluginGrbl_alarm()
+{
+    QSignalSpy readySpy(core->firmwarePlugin(), SIGNAL(readyForCommand()));
+    QSignalSpy statusSpy(core->firmwarePlugin(), SIGNAL(statusReported(QVariantMap)));
+    core->firmwarePlugin()->validateCommand(QStringLiteral("ALARM:3"));
+    QCOMPARE(readySpy.count(), 0);
+    QCOMPARE(statusSpy.count(), 1);
+    const QVariantMap status = statusSpy.first().first().toMap();
+    QCOMPARE(status.value(QStringLiteral("state")).toString(), QStringLiteral("Alarm"));
+    QCOMPARE(status.value(QStringLiteral("alarm")).toString(), QStringLiteral("3"));
+}
+
 void AtCoreTests::testPluginMarlin_load()
 {
     core->loadFirmwarePlugin(QStringLiteral("marlin"));
@@ -104,6 +275,37 @@ void AtCoreTests::testPluginMarlin_validate()
     QVERIFY(sSpy.count() == 1);
 }
 
+void AtCoreTests::testPluginMarlin_capabilities()
+{
+    QSignalSpy sSpy(core->firmwarePlugin(), SIGNAL(capabilityFound(QString)));
+    QVERIFY(sSpy.isValid() == true);
+    core->firmwarePlugin()->checkCommand(QByteArray("Cap:AUTOREPORT_TEMP:1"));
+    core->firmwarePlugin()->checkCommand(QByteArray("Cap:EEPROM:0"));
+    core->firmwarePlugin()->checkCommand(QByteArray("Cap:AUTOREPORT_TEMP:1"));
+    QVERIFY(sSpy.count() == 1);
+    QVERIFY(core->firmwarePlugin()->hasCapability(QStringLiteral("AUTOREPORT_TEMP")));
+    QVERIFY(!core->firmwarePlugin()->hasCapability(QStringLiteral("EEPROM")));
+    QVERIFY(core->firmwarePlugin()->maxLineLength() == 96);
+}
+
+void AtCoreTests::testPluginMarlin_perConnection()
+{
+    AtCore other;
+    other.loadFirmwarePlugin(QStringLiteral("marlin"));
+    QVERIFY(other.firmwarePlugin()->name() == QStringLiteral("Marlin"));
+    QVERIFY(other.firmwarePlugin() != core->firmwarePlugin());
+    QVERIFY(other.firmwarePlugin()->core() == &other);
+    QVERIFY(core->firmwarePlugin()->core() == core);
+
+    QSignalSpy sSpy(core->firmwarePlugin(), SIGNAL(readyForCommand()));
+    QSignalSpy otherSpy(other.firmwarePlugin(), SIGNAL(readyForCommand()));
+    other.firmwarePlugin()->validateCommand(QStringLiteral("ok"));
+    QVERIFY(otherSpy.count() == 1);
+    QVERIFY(sSpy.count() == 0);
+    //Capabilities belong to the connection that reported them.
+    QVERIFY(!other.firmwarePlugin()->hasCapability(QStringLiteral("AUTOREPORT_TEMP")));
+}
+
 void AtCoreTests::testPluginRepetier_load()
 {
     core->loadFirmwarePlugin(QStringLiteral("repetier"));
@@ -119,6 +321,32 @@ void AtCoreTests::testPluginRepetier_validate()
     QVERIFY(sSpy.count() == 1);
 }
 
+void AtCoreTests::testPluginRepRapFirmware_load()
+{
+    core->loadFirmwarePlugin(QStringLiteral("reprapfirmware"));
+    QVERIFY(core->firmwarePlugin()->name() == QStringLiteral("RepRapFirmware"));
+    QVERIFY(core->firmwarePlugin()->statusCommand() == QStringLiteral("M408 S0"));
+}
+
+void AtCoreTests::testPluginRepRapFirmware_validate()
+{
+    QSignalSpy sSpy(core->firmwarePlugin(), SIGNAL(readyForCommand()));
+    QSignalSpy statusSpy(core->firmwarePlugin(), SIGNAL(statusReported(QVariantMap)));
+    QVERIFY(sSpy.isValid() == true);
+    QVERIFY(statusSpy.isValid() == true);
+    core->firmwarePlugin()->validateCommand(QStringLiteral("{\"status\":\"P\",\"heaters\":[60.0,210.0],\"active\":[60.0,215.0],\"pos\":[1.0,2.0,0.3],\"tool\":0,\"fraction_printed\":0.5}"));
+    core->firmwarePlugin()->validateCommand(QStringLiteral("ok"));
+    core->firmwarePlugin()->validateCommand(QStringLiteral("other text"));
+    QVERIFY(sSpy.count() == 1);
+    QVERIFY(statusSpy.count() == 1);
+    const QVariantMap status = statusSpy.at(0).at(0).toMap();
+    QVERIFY(status.value(QStringLiteral("state")).toString() == QStringLiteral("P"));
+    QVERIFY(qFuzzyCompare(status.value(QStringLiteral("fractionPrinted")).toDouble(), 0.5));
+    QVERIFY(qFuzzyCompare(core->temperature().extruderTemperature(), 210.0f));
+    QVERIFY(qFuzzyCompare(core->temperature().extruderTargetTemperature(), 215.0f));
+    QVERIFY(qFuzzyCompare(core->temperature().bedTemperature(), 60.0f));
+}
+
 void AtCoreTests::testPluginSmoothie_load()
 {
     core->loadFirmwarePlugin(QStringLiteral("smoothie"));
@@ -29,15 +29,29 @@ private slots:
     void testInitState();
     void testPluginDetect();
     void testConnectInvalidDevice();
+    void testSnapshot();
+    void testSnapshotPosition();
+    void testPrintDisconnected();
+    void testPrintMissingFile();
+    void testPrintDeviceOpenFailure();
+    void testPrintLineTooLong();
+    void testPrintUnsupportedCompression();
+    void testRequestAbortedByStop();
+    void testTimersFollowThread();
     void cleanupTestCase();
     void testPluginAprinter_load();
     void testPluginAprinter_validate();
     void testPluginGrbl_load();
     void testPluginGrbl_validate();
+    void testPluginGrbl_alarm();
     void testPluginMarlin_load();
     void testPluginMarlin_validate();
+    void testPluginMarlin_capabilities();
+    void testPluginMarlin_perConnection();
     void testPluginRepetier_load();
     void testPluginRepetier_validate();
+    void testPluginRepRapFirmware_load();
+    void testPluginRepRapFirmware_validate();
     void testPluginSmoothie_load();
     void testPluginSmoothie_validate();
     void testPluginSprinter_load();
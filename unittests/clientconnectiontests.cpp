@@ -0,0 +1,114 @@
+/*
+    This file is part of the KDE project
+
+    Copyright (C) 2026 The AtCore contributors
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <QElapsedTimer>
+#include <QLocalServer>
+#include <QLocalSocket>
+
+#include "clientconnectiontests.h"
+#include "../daemon/printersession.h"
+
+using namespace DaemonProtocol;
+
+void ClientConnectionTests::init()
+{
+    const QString name = QStringLiteral("atcore-clientconnectiontests-%1").arg(QCoreApplication::applicationPid());
+    QLocalServer::removeServer(name);
+    server = new QLocalServer;
+    QVERIFY(server->listen(name));
+    client = new QLocalSocket;
+    client->connectToServer(name);
+    QVERIFY(client->waitForConnected(2000));
+    QVERIFY(server->waitForNewConnection(2000));
+    connection = new ClientConnection(server->nextPendingConnection());
+    received.clear();
+}
+
+void ClientConnectionTests::cleanup()
+{
+    delete connection;
+    delete client;
+    delete server;
+    connection = nullptr;
+    client = nullptr;
+    server = nullptr;
+}
+
+bool ClientConnectionTests::nextMessage(Message &message, int msecs)
+{
+    QElapsedTimer timer;
+    timer.start();
+    while (decode(received, message) == 0) {
+        if (timer.elapsed() > msecs) {
+            return false;
+        }
+        QTest::qWait(5);
+        received.append(client->readAll());
+    }
+    return true;
+}
+
+void ClientConnectionTests::testSnapshotOnSubscribe()
+{
+    PrinterSession printer(QStringLiteral("p1"));
+    connection->subscribe(&printer, StateTopic | ProgressTopic, 100);
+
+    Message message;
+    QVERIFY(nextMessage(message));
+    QCOMPARE(message.type, quint8(Telemetry));
+    QCOMPARE(message.printer, QStringLiteral("p1"));
+    QCOMPARE(message.fields.keys(), QStringList({QStringLiteral("progress"), QStringLiteral("state")}));
+}
+
+void ClientConnectionTests::testBatching()
+{
+    PrinterSession printer(QStringLiteral("p1"));
+    connection->subscribe(&printer, AllTopics, 200);
+    Message message;
+    QVERIFY(nextMessage(message));
+
+    emit printer.updated(TemperatureTopic, QStringLiteral("bedTemperature"), 50.0);
+    emit printer.updated(MessageTopic, QStringLiteral("messages"), QStringLiteral("ok"));
+    emit printer.updated(TemperatureTopic, QStringLiteral("bedTemperature"), 60.0);
+    emit printer.updated(MessageTopic, QStringLiteral("messages"), QStringLiteral("echo:busy"));
+
+    //Nothing before the interval, then one frame with the latest values and every message.
+    QVERIFY(!nextMessage(message, 50));
+    QVERIFY(nextMessage(message));
+    QCOMPARE(message.type, quint8(Telemetry));
+    QCOMPARE(message.fields.value(QStringLiteral("bedTemperature")).toDouble(), 60.0);
+    QCOMPARE(message.fields.value(QStringLiteral("messages")).toStringList(), QStringList({QStringLiteral("ok"), QStringLiteral("echo:busy")}));
+    QVERIFY(!nextMessage(message, 300));
+}
+
+void ClientConnectionTests::testTopics()
+{
+    PrinterSession printer(QStringLiteral("p1"));
+    connection->subscribe(&printer, StateTopic, 20);
+    Message message;
+    QVERIFY(nextMessage(message));
+
+    emit printer.updated(TemperatureTopic, QStringLiteral("bedTemperature"), 50.0);
+    QVERIFY(!nextMessage(message, 100));
+
+    connection->unsubscribe(QStringLiteral("p1"));
+    emit printer.updated(StateTopic, QStringLiteral("state"), 1);
+    QVERIFY(!nextMessage(message, 100));
+}
+
+QTEST_MAIN(ClientConnectionTests)
@@ -0,0 +1,45 @@
+/*
+    This file is part of the KDE project
+
+    Copyright (C) 2026 The AtCore contributors
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <QtTest>
+#include <QObject>
+
+#include "../daemon/clientconnection.h"
+
+class QLocalServer;
+class QLocalSocket;
+
+class ClientConnectionTests: public QObject
+{
+    Q_OBJECT
+private slots:
+    void init();
+    void cleanup();
+    void testSnapshotOnSubscribe();
+    void testBatching();
+    void testTopics();
+private:
+    /**
+     * @brief Wait at most \p msecs for the next message the client receives
+     */
+    bool nextMessage(DaemonProtocol::Message &message, int msecs = 2000);
+    QLocalServer *server = nullptr;
+    QLocalSocket *client = nullptr;
+    ClientConnection *connection = nullptr;
+    QByteArray received;
+};
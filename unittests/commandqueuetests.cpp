@@ -0,0 +1,161 @@
+/*
+    This file is part of the KDE project
+
+    Copyright (C) 2026 The AtCore contributors
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "commandqueuetests.h"
+
+void CommandQueueTests::init()
+{
+    delete queue;
+    queue = new AtCoreProtocol::CommandQueue();
+}
+
+void CommandQueueTests::append(const QStringList &commands)
+{
+    for (const QString &command : commands) {
+        queue->append(command.toStdString());
+    }
+}
+
+QStringList CommandQueueTests::commands() const
+{
+    QStringList list;
+    for (const std::string &command : queue->commands()) {
+        list.append(QString::fromStdString(command));
+    }
+    return list;
+}
+
+void CommandQueueTests::testMergeJogs()
+{
+    append({
+        QStringLiteral("G91"), QStringLiteral("G1 X10"), QStringLiteral("G90"),
+        QStringLiteral("G91"), QStringLiteral("G1 X10"), QStringLiteral("G90"),
+        QStringLiteral("G91"), QStringLiteral("G1 X 0.5"), QStringLiteral("G90")
+    });
+    QStringList expected = {QStringLiteral("G91"), QStringLiteral("G1 X20.5"), QStringLiteral("G90")};
+    QCOMPARE(commands(), expected);
+}
+
+void CommandQueueTests::testMergeJogsOtherAxis()
+{
+    append({
+        QStringLiteral("G91"), QStringLiteral("G1 X10"), QStringLiteral("G90"),
+        QStringLiteral("G91"), QStringLiteral("G1 Y10"), QStringLiteral("G90")
+    });
+    QStringList expected = {QStringLiteral("G91"), QStringLiteral("G1 X10"), QStringLiteral("G1 Y10"), QStringLiteral("G90")};
+    QCOMPARE(commands(), expected);
+}
+
+void CommandQueueTests::testMergeJogsAbsolute()
+{
+    append({QStringLiteral("G90"), QStringLiteral("G1 X10"), QStringLiteral("G1 X10")});
+    QCOMPARE(commands().size(), 3);
+
+    //Unknown mode is never merged.
+    init();
+    append({QStringLiteral("G1 X10"), QStringLiteral("G1 X10")});
+    QCOMPARE(commands().size(), 2);
+}
+
+void CommandQueueTests::testMergeJogsCancel()
+{
+    append({QStringLiteral("G91"), QStringLiteral("G1 Z-1"), QStringLiteral("G1 Z1")});
+    QStringList expected = {QStringLiteral("G91")};
+    QCOMPARE(commands(), expected);
+}
+
+void CommandQueueTests::testMergeJogsSentMode()
+{
+    queue->append("G91");
+    QCOMPARE(queue->takeFirst(), std::string("G91"));
+    append({QStringLiteral("G1 E5"), QStringLiteral("G90"), QStringLiteral("G91"), QStringLiteral("G1 E5")});
+    QStringList expected = {QStringLiteral("G1 E10")};
+    QCOMPARE(commands(), expected);
+}
+
+void CommandQueueTests::testMergeJogsExtruderMode()
+{
+    append({QStringLiteral("G90"), QStringLiteral("M83"), QStringLiteral("G1 E5"), QStringLiteral("G1 E5"), QStringLiteral("G1 X5"), QStringLiteral("G1 X5")});
+    QStringList expected = {QStringLiteral("G90"), QStringLiteral("M83"), QStringLiteral("G1 E10"), QStringLiteral("G1 X5"), QStringLiteral("G1 X5")};
+    QCOMPARE(commands(), expected);
+
+    //M82 leaves the other axes relative.
+    init();
+    append({QStringLiteral("G91"), QStringLiteral("M82"), QStringLiteral("G1 E5"), QStringLiteral("G1 E5"), QStringLiteral("G1 X5"), QStringLiteral("G1 X5")});
+    expected = QStringList{QStringLiteral("G91"), QStringLiteral("M82"), QStringLiteral("G1 E5"), QStringLiteral("G1 E5"), QStringLiteral("G1 X10")};
+    QCOMPARE(commands(), expected);
+
+    //The sent extruder mode is used once the mode change left the queue.
+    init();
+    queue->append("M83");
+    QCOMPARE(queue->takeFirst(), std::string("M83"));
+    append({QStringLiteral("G1 E5"), QStringLiteral("G1 E5")});
+    expected = QStringList{QStringLiteral("G1 E10")};
+    QCOMPARE(commands(), expected);
+}
+
+void CommandQueueTests::testMergeJogsPrecision()
+{
+    append({QStringLiteral("G91"), QStringLiteral("G1 X0.0001"), QStringLiteral("G1 X0.0001"), QStringLiteral("G1 X-0.00015")});
+    QStringList expected = {QStringLiteral("G91"), QStringLiteral("G1 X0.00005")};
+    QCOMPARE(commands(), expected);
+
+    //Moves finer than the sum can hold are not merged.
+    init();
+    append({QStringLiteral("G91"), QStringLiteral("G1 X0.1"), QStringLiteral("G1 X0.00000001")});
+    QCOMPARE(commands().size(), 3);
+}
+
+void CommandQueueTests::testReplaceSetpoint()
+{
+    append({
+        QStringLiteral("M104 S200"), QStringLiteral("M140 S60"), QStringLiteral("M105"),
+        QStringLiteral("M104 P0 S210"), QStringLiteral("M140 S0"),
+        QStringLiteral("M106 S255"), QStringLiteral("M107")
+    });
+    QStringList expected = {QStringLiteral("M104 P0 S210"), QStringLiteral("M140 S0"), QStringLiteral("M105"), QStringLiteral("M107")};
+    QCOMPARE(commands(), expected);
+}
+
+void CommandQueueTests::testReplaceSetpointOtherTarget()
+{
+    append({QStringLiteral("M104 P0 S200"), QStringLiteral("M104 P1 S200"), QStringLiteral("M106 P1 S100"), QStringLiteral("M106 P0 S100")});
+    QCOMPARE(commands().size(), 4);
+}
+
+void CommandQueueTests::testReplaceSetpointBarrier()
+{
+    append({QStringLiteral("M104 S200"), QStringLiteral("M109 S200"), QStringLiteral("M104 S0")});
+    QCOMPARE(commands().size(), 3);
+}
+
+void CommandQueueTests::testReplaceSetpointActiveTool()
+{
+    queue->append("T1");
+    QCOMPARE(queue->takeFirst(), std::string("T1"));
+    append({QStringLiteral("M104 S200"), QStringLiteral("M104 T0 S180"), QStringLiteral("M104 T1 S210")});
+    QStringList expected = {QStringLiteral("M104 T1 S210"), QStringLiteral("M104 T0 S180")};
+    QCOMPARE(commands(), expected);
+
+    //A tool change in the queue is a barrier.
+    init();
+    append({QStringLiteral("M104 S200"), QStringLiteral("T1"), QStringLiteral("M104 S210")});
+    QCOMPARE(commands().size(), 3);
+}
+
+QTEST_MAIN(CommandQueueTests)
@@ -0,0 +1,44 @@
+/*
+    This file is part of the KDE project
+
+    Copyright (C) 2026 The AtCore contributors
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <QtTest>
+#include <QObject>
+
+#include "../src/protocol/commandqueue.h"
+
+class CommandQueueTests: public QObject
+{
+    Q_OBJECT
+private slots:
+    void init();
+    void testMergeJogs();
+    void testMergeJogsOtherAxis();
+    void testMergeJogsAbsolute();
+    void testMergeJogsCancel();
+    void testMergeJogsSentMode();
+    void testMergeJogsExtruderMode();
+    void testMergeJogsPrecision();
+    void testReplaceSetpoint();
+    void testReplaceSetpointOtherTarget();
+    void testReplaceSetpointBarrier();
+    void testReplaceSetpointActiveTool();
+private:
+    void append(const QStringList &commands);
+    QStringList commands() const;
+    AtCoreProtocol::CommandQueue *queue = nullptr;
+};
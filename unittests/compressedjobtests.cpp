@@ -0,0 +1,218 @@
+/*
+    This file is part of the KDE project
+
+    Copyright (C) 2026 The AtCore contributors
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <QFile>
+#include <QFileInfo>
+#include <QSignalSpy>
+
+#include <cstring>
+
+#include <zlib.h>
+#ifdef ATCORE_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+#include "compressedjobtests.h"
+#include "../src/compressedjob.h"
+
+namespace
+{
+QByteArray _gzip(const QByteArray &data)
+{
+    z_stream stream;
+    std::memset(&stream, 0, sizeof(stream));
+    //15 + 16: largest window, gzip header
+    deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY);
+    QByteArray out(int(deflateBound(&stream, uLong(data.size()))) + 32, '\0');
+    stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data.constData()));
+    stream.avail_in = uInt(data.size());
+    stream.next_out = reinterpret_cast<Bytef *>(out.data());
+    stream.avail_out = uInt(out.size());
+    deflate(&stream, Z_FINISH);
+    out.resize(int(stream.total_out));
+    deflateEnd(&stream);
+    return out;
+}
+
+#ifdef ATCORE_HAVE_ZSTD
+QByteArray _zstd(const QByteArray &data)
+{
+    QByteArray out(int(ZSTD_compressBound(std::size_t(data.size()))), '\0');
+    const std::size_t size = ZSTD_compress(out.data(), std::size_t(out.size()), data.constData(), std::size_t(data.size()), 3);
+    out.resize(ZSTD_isError(size) ? 0 : int(size));
+    return out;
+}
+#endif
+
+/**
+ * @brief Read \p job to its end like the print thread, checking its progress on the way
+ */
+QByteArray _readAll(CompressedJob &job, bool *progressOk)
+{
+    QByteArray data;
+    qint64 position = 0;
+    *progressOk = true;
+    while (!job.atEnd()) {
+        if (job.bytesAvailable() == 0) {
+            if (!job.waitForReadyRead(5000)) {
+                break;
+            }
+            continue;
+        }
+        data.append(job.readLine());
+        if (job.compressedPosition() < position || job.compressedPosition() > job.compressedSize()) {
+            *progressOk = false;
+        }
+        position = job.compressedPosition();
+    }
+    return data;
+}
+}
+
+void CompressedJobTests::initTestCase()
+{
+    QVERIFY(dir.isValid());
+    for (int i = 0; i < 100000; i++) {
+        job.append(QStringLiteral("G1 X%1 Y%2 E%3\n").arg(i % 200).arg(i % 77).arg(i * 0.01).toLatin1());
+    }
+}
+
+QString CompressedJobTests::writeGzip(const QString &name, const QList<QByteArray> &members)
+{
+    const QString fileName = dir.filePath(name);
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return QString();
+    }
+    for (const QByteArray &member : members) {
+        file.write(_gzip(member));
+    }
+    return fileName;
+}
+
+void CompressedJobTests::testDetect()
+{
+    const QString plain = dir.filePath(QStringLiteral("plain.gcode"));
+    QFile file(plain);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write("G28\n");
+    file.close();
+    QCOMPARE(CompressedJob::detect(plain), CompressedJob::None);
+    QCOMPARE(CompressedJob::detect(writeGzip(QStringLiteral("small.gcode.gz"), {QByteArray("G28\n")})), CompressedJob::Gzip);
+    QVERIFY(CompressedJob::isSupported(CompressedJob::Gzip));
+
+    CompressedJob notCompressed(plain);
+    QVERIFY(!notCompressed.open(QIODevice::ReadOnly));
+}
+
+void CompressedJobTests::testGzip()
+{
+    //Two members, as written by concatenating gzip files.
+    const QByteArray tail("M117 part two\nM84\n");
+    const QString fileName = writeGzip(QStringLiteral("job.gcode.gz"), {job, tail});
+    CompressedJob compressed(fileName);
+    QSignalSpy finished(&compressed, &QIODevice::readChannelFinished);
+    QVERIFY(compressed.open(QIODevice::ReadOnly));
+    QVERIFY(compressed.isSequential());
+    QCOMPARE(compressed.compressedSize(), QFileInfo(fileName).size());
+    QVERIFY(compressed.compressedSize() < job.size() / 2);
+
+    bool progressOk = false;
+    const QByteArray data = _readAll(compressed, &progressOk);
+    QVERIFY(progressOk);
+    QCOMPARE(data.size(), job.size() + tail.size());
+    QVERIFY(data == job + tail);
+    QCOMPARE(compressed.compressedPosition(), compressed.compressedSize());
+    QVERIFY(!compressed.hasError());
+    QTRY_COMPARE(finished.count(), 1);
+}
+
+void CompressedJobTests::testTruncated()
+{
+    const QString fileName = writeGzip(QStringLiteral("cut.gcode.gz"), {job});
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::ReadWrite));
+    QVERIFY(file.resize(file.size() / 2));
+    file.close();
+
+    CompressedJob compressed(fileName);
+    QSignalSpy finished(&compressed, &QIODevice::readChannelFinished);
+    QVERIFY(compressed.open(QIODevice::ReadOnly));
+    bool progressOk = false;
+    const QByteArray data = _readAll(compressed, &progressOk);
+    QVERIFY(data.size() < job.size());
+    QVERIFY(job.startsWith(data));
+    QVERIFY(compressed.hasError());
+    QTRY_COMPARE(finished.count(), 1);
+    QVERIFY(!compressed.errorString().isEmpty());
+}
+
+void CompressedJobTests::testZstd()
+{
+#ifndef ATCORE_HAVE_ZSTD
+    QSKIP("AtCore was built without zstd");
+#else
+    const QString fileName = dir.filePath(QStringLiteral("job.gcode.zst"));
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    const QByteArray compressedJob = _zstd(job);
+    QVERIFY(!compressedJob.isEmpty());
+    file.write(compressedJob);
+    file.close();
+    QCOMPARE(CompressedJob::detect(fileName), CompressedJob::Zstd);
+    QVERIFY(CompressedJob::isSupported(CompressedJob::Zstd));
+
+    CompressedJob compressed(fileName);
+    QSignalSpy finished(&compressed, &QIODevice::readChannelFinished);
+    QVERIFY(compressed.open(QIODevice::ReadOnly));
+    bool progressOk = false;
+    const QByteArray data = _readAll(compressed, &progressOk);
+    QVERIFY(progressOk);
+    QVERIFY(data == job);
+    QCOMPARE(compressed.compressedPosition(), compressed.compressedSize());
+    QVERIFY(!compressed.hasError());
+    QTRY_COMPARE(finished.count(), 1);
+
+    //Cut short, the lines before the cut are read and the error is reported.
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write(compressedJob.left(compressedJob.size() / 2));
+    file.close();
+    CompressedJob truncated(fileName);
+    QVERIFY(truncated.open(QIODevice::ReadOnly));
+    const QByteArray cut = _readAll(truncated, &progressOk);
+    QVERIFY(cut.size() < job.size());
+    QVERIFY(job.startsWith(cut));
+    QVERIFY(truncated.hasError());
+#endif
+}
+
+void CompressedJobTests::testClose()
+{
+    //The worker waits for the reader, closing early must not hang.
+    const QString fileName = writeGzip(QStringLiteral("big.gcode.gz"), {job, job, job});
+    CompressedJob compressed(fileName);
+    QVERIFY(compressed.open(QIODevice::ReadOnly));
+    QVERIFY(compressed.waitForReadyRead(5000));
+    QVERIFY(compressed.canReadLine());
+    QVERIFY(compressed.readLine().startsWith("G1 X0 Y0"));
+    compressed.close();
+    QVERIFY(!compressed.isOpen());
+    QVERIFY(compressed.atEnd());
+}
+
+QTEST_MAIN(CompressedJobTests)
@@ -0,0 +1,41 @@
+/*
+    This file is part of the KDE project
+
+    Copyright (C) 2026 The AtCore contributors
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <QtTest>
+#include <QObject>
+#include <QTemporaryDir>
+
+class CompressedJobTests: public QObject
+{
+    Q_OBJECT
+private slots:
+    void initTestCase();
+    void testDetect();
+    void testGzip();
+    void testTruncated();
+    void testZstd();
+    void testClose();
+private:
+    /**
+     * @brief Write \p members, each compressed as one gzip member, to \p name in the temporary dir
+     */
+    QString writeGzip(const QString &name, const QList<QByteArray> &members);
+
+    QTemporaryDir dir;
+    QByteArray job;
+};
@@ -0,0 +1,130 @@
+/*
+    This file is part of the KDE project
+
+    Copyright (C) 2026 The AtCore contributors
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "coroutinetests.h"
+#include "../src/protocol/coroutine.h"
+
+using namespace AtCoreProtocol;
+
+namespace
+{
+/**
+ * @brief What a routine saw of its commands
+ */
+struct Steps {
+    std::vector<std::string> lines;     //!< @param lines: reply of the last command
+    int acknowledged = 0;               //!< @param acknowledged: commands acknowledged
+    bool aborted = false;               //!< @param aborted: a command was dropped
+    bool done = false;                  //!< @param done: the routine ran to its end
+};
+
+Routine home(ProtocolEngine &engine, Steps &steps)
+{
+    const Reply<std::vector<std::string>> reply = co_await query(engine, "M114");
+    steps.lines = reply.lines;
+    steps.aborted = reply.aborted;
+    steps.done = true;
+}
+
+Routine homeAndLevel(ProtocolEngine &engine, Steps &steps)
+{
+    for (const char *command : {"G28", "G29", "M500"}) {
+        if (!co_await send(engine, command)) {
+            steps.aborted = true;
+            break;
+        }
+        steps.acknowledged++;
+    }
+    steps.done = true;
+}
+}
+
+void CoroutineTests::init()
+{
+    written.clear();
+    engine = new ProtocolEngine();
+    engine->setWriteHandler([this](const std::string & command) {
+        written.append(QString::fromStdString(command));
+        return true;
+    });
+    engine->setReady(true);
+}
+
+void CoroutineTests::cleanup()
+{
+    delete engine;
+    engine = nullptr;
+}
+
+void CoroutineTests::testSend()
+{
+    Steps steps;
+    home(*engine, steps);
+    QCOMPARE(written, QStringList{QStringLiteral("M114")});
+    QVERIFY(!steps.done);
+
+    const char reply[] = "X:1.00 Y:2.00 Z:3.00 E:0.00\nok\n";
+    engine->receive(reply, sizeof(reply) - 1);
+    QVERIFY(steps.done);
+    QVERIFY(!steps.aborted);
+    QCOMPARE(steps.lines, std::vector<std::string> {"X:1.00 Y:2.00 Z:3.00 E:0.00"});
+}
+
+void CoroutineTests::testSequence()
+{
+    Steps steps;
+    homeAndLevel(*engine, steps);
+    for (int i = 0; i < 3; i++) {
+        QVERIFY(!steps.done);
+        engine->receive("ok\n", 3);
+    }
+    QVERIFY(steps.done);
+    QCOMPARE(steps.acknowledged, 3);
+    QStringList expected = {QStringLiteral("G28"), QStringLiteral("G29"), QStringLiteral("M500")};
+    QCOMPARE(written, expected);
+}
+
+void CoroutineTests::testAbortedByClear()
+{
+    //The command waits behind another one and is dropped from the queue.
+    engine->submit("G28");
+    Steps steps;
+    home(*engine, steps);
+    QVERIFY(!steps.done);
+    engine->clear();
+    QVERIFY(steps.done);
+    QVERIFY(steps.aborted);
+    QVERIFY(steps.lines.empty());
+}
+
+void CoroutineTests::testAbortedByReset()
+{
+    Steps steps;
+    homeAndLevel(*engine, steps);
+    engine->receive("ok\n", 3);
+    QCOMPARE(steps.acknowledged, 1);
+
+    //G29 is in flight when the firmware restarts.
+    engine->reset();
+    QVERIFY(steps.done);
+    QVERIFY(steps.aborted);
+    QCOMPARE(steps.acknowledged, 1);
+    QVERIFY(engine->queue().isEmpty());
+}
+
+QTEST_MAIN(CoroutineTests)
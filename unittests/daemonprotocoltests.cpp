@@ -0,0 +1,110 @@
+/*
+    This file is part of the KDE project
+
+    Copyright (C) 2026 The AtCore contributors
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <QtEndian>
+
+#include "daemonprotocoltests.h"
+
+using namespace DaemonProtocol;
+
+namespace
+{
+/**
+ * @brief Frame header announcing \p size bytes
+ */
+QByteArray header(quint32 size)
+{
+    QByteArray bytes(sizeof(quint32), Qt::Uninitialized);
+    qToBigEndian<quint32>(size, reinterpret_cast<uchar *>(bytes.data()));
+    return bytes;
+}
+
+Message command()
+{
+    Message message;
+    message.type = Command;
+    message.request = 42;
+    message.printer = QStringLiteral("p1");
+    message.fields.insert(QStringLiteral("gcode"), QStringLiteral("G28"));
+    return message;
+}
+}
+
+void DaemonProtocolTests::testRoundTrip()
+{
+    Message reply;
+    reply.type = Reply;
+    reply.request = 7;
+    reply.fields.insert(QStringLiteral("lines"), QStringList({QStringLiteral("ok")}));
+    QByteArray buffer = encode(command()) + encode(reply);
+
+    Message message;
+    QCOMPARE(decode(buffer, message), 1);
+    QCOMPARE(message.type, quint8(Command));
+    QCOMPARE(message.request, quint32(42));
+    QCOMPARE(message.printer, QStringLiteral("p1"));
+    QCOMPARE(message.fields.value(QStringLiteral("gcode")).toString(), QStringLiteral("G28"));
+
+    //The frame read is removed, the next one follows.
+    QCOMPARE(buffer, encode(reply));
+    QCOMPARE(decode(buffer, message), 1);
+    QCOMPARE(message.type, quint8(Reply));
+    QCOMPARE(message.fields.value(QStringLiteral("lines")).toStringList(), QStringList({QStringLiteral("ok")}));
+    QVERIFY(buffer.isEmpty());
+    QCOMPARE(decode(buffer, message), 0);
+}
+
+void DaemonProtocolTests::testPartialFrame()
+{
+    const QByteArray frame = encode(command());
+    for (int size = 0; size < frame.size(); ++size) {
+        QByteArray buffer = frame.left(size);
+        Message message;
+        QCOMPARE(decode(buffer, message), 0);
+        QCOMPARE(buffer.size(), size);
+    }
+}
+
+void DaemonProtocolTests::testSizeLimit()
+{
+    Message message;
+    QByteArray buffer = header(MaxFrameSize + 1);
+    QCOMPARE(decode(buffer, message), -1);
+
+    //The largest frame accepted is only waited for.
+    buffer = header(MaxFrameSize) + QByteArray(1024, '\0');
+    QCOMPARE(decode(buffer, message), 0);
+}
+
+void DaemonProtocolTests::testCorruptFrame()
+{
+    Message message;
+
+    //Too short for the message it should hold.
+    QByteArray buffer = header(2) + QByteArray(2, '\1');
+    QCOMPARE(decode(buffer, message), -1);
+    QVERIFY(buffer.isEmpty());
+
+    //Bytes left over after the message.
+    const QByteArray frame = encode(command());
+    buffer = header(quint32(frame.size() - int(sizeof(quint32)) + 1)) + frame.mid(int(sizeof(quint32))) + '\0';
+    QCOMPARE(decode(buffer, message), -1);
+    QVERIFY(buffer.isEmpty());
+}
+
+QTEST_MAIN(DaemonProtocolTests)
@@ -0,0 +1,90 @@
+/*
+    This file is part of the KDE project
+
+    Copyright (C) 2026 The AtCore contributors
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "gcodesourcetests.h"
+
+void GCodeSourceTests::testRead()
+{
+    int batch = 0;
+    GCodeSource source([&batch] {
+        if (batch == 3) {
+            return QStringList();
+        }
+        batch++;
+        return QStringList({QStringLiteral("G1 X%1").arg(batch), QStringLiteral("G1 Y%1").arg(batch)});
+    });
+    QVERIFY(source.isSequential());
+    QVERIFY(source.open(QIODevice::ReadOnly));
+
+    QStringList lines;
+    while (source.canReadLine()) {
+        lines.append(QString::fromLatin1(source.readLine()).trimmed());
+    }
+    QStringList expected = {
+        QStringLiteral("G1 X1"), QStringLiteral("G1 Y1"),
+        QStringLiteral("G1 X2"), QStringLiteral("G1 Y2"),
+        QStringLiteral("G1 X3"), QStringLiteral("G1 Y3")
+    };
+    QCOMPARE(lines, expected);
+    QVERIFY(source.atEnd());
+}
+
+void GCodeSourceTests::testPulledOnDemand()
+{
+    int calls = 0;
+    GCodeSource source([&calls] {
+        calls++;
+        return QStringList({QStringLiteral("G1 X%1").arg(calls)});
+    });
+    QCOMPARE(calls, 0);
+    QVERIFY(source.open(QIODevice::ReadOnly));
+    QCOMPARE(calls, 0);
+
+    //An endless program is only made as far as it is read.
+    for (int i = 0; i < 10; i++) {
+        QVERIFY(source.canReadLine());
+        source.readLine();
+    }
+    QVERIFY(calls <= 11);
+    QVERIFY(!source.atEnd());
+}
+
+void GCodeSourceTests::testFinished()
+{
+    GCodeSource source([] {
+        return QStringList();
+    });
+    QSignalSpy spy(&source, SIGNAL(readChannelFinished()));
+    QVERIFY(spy.isValid());
+    QVERIFY(source.open(QIODevice::ReadOnly));
+    QVERIFY(!source.canReadLine());
+    QVERIFY(source.atEnd());
+    QVERIFY(spy.wait(1000));
+    QCOMPARE(spy.count(), 1);
+}
+
+void GCodeSourceTests::testReadOnly()
+{
+    GCodeSource source([] {
+        return QStringList();
+    });
+    QVERIFY(!source.open(QIODevice::ReadWrite));
+    QVERIFY(!source.isOpen());
+}
+
+QTEST_MAIN(GCodeSourceTests)
@@ -256,6 +256,12 @@ void GCodeTests::command_M140()
     QVERIFY(GCode::toCommand(GCode::M140, QStringLiteral("100")) == QStringLiteral("M140 S100"));
 }
 
+void GCodeTests::command_M155()
+{
+    QVERIFY(GCode::toCommand(GCode::M155) == QStringLiteral("ERROR! M155: It's obligatory to have an argument"));
+    QVERIFY(GCode::toCommand(GCode::M155, QStringLiteral("5")) == QStringLiteral("M155 S5"));
+}
+
 void GCodeTests::command_M190()
 {
     QVERIFY(GCode::toCommand(GCode::M190) == QStringLiteral("ERROR! M190: It's obligatory to have an argument"));
@@ -274,6 +280,12 @@ void GCodeTests::command_M221()
     QVERIFY(GCode::toCommand(GCode::M221, QStringLiteral("100")) == QStringLiteral("M221 S100"));
 }
 
+void GCodeTests::command_M408()
+{
+    QVERIFY(GCode::toCommand(GCode::M408) == QStringLiteral("M408"));
+    QVERIFY(GCode::toCommand(GCode::M408, QStringLiteral("0")) == QStringLiteral("M408 S0"));
+}
+
 void GCodeTests::command_unsupportedM()
 {
     QVERIFY(GCode::toCommand(GCode::M999) == QObject::tr("Not supported or implemented!"));
@@ -624,6 +636,11 @@ void GCodeTests::string_M150()
     QVERIFY(GCode::toString(GCode::M150) == QObject::tr("M150: Set display color"));
 }
 
+void GCodeTests::string_M155()
+{
+    QVERIFY(GCode::toString(GCode::M155) == QObject::tr("M155: Automatically send temperatures"));
+}
+
 void GCodeTests::string_M163()
 {
     QVERIFY(GCode::toString(GCode::M163) == QObject::tr("M163: Set weight of mixed material"));
@@ -72,9 +72,11 @@ private slots:
     void command_M117();
     void command_M119();
     void command_M140();
+    void command_M155();
     void command_M190();
     void command_M220();
     void command_M221();
+    void command_M408();
     void command_unsupportedM();
 
     void string_M0();
@@ -146,6 +148,7 @@ private slots:
     void string_M143();
     void string_M144();
     void string_M150();
+    void string_M155();
     void string_M163();
     void string_M164();
     void string_M190();
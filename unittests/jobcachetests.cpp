@@ -0,0 +1,132 @@
+/*
+    This file is part of the KDE project
+
+    Copyright (C) 2026 The AtCore contributors
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <thread>
+#include <vector>
+
+#include "jobcachetests.h"
+
+namespace
+{
+const QByteArray _job = QByteArrayLiteral("G28\n;LAYER:0\nG1 Z0.3 F600\nG1 X10 Y10 F3000\nG1 X20");
+}
+
+void JobCacheTests::initTestCase()
+{
+    QVERIFY(dir.isValid());
+}
+
+QString JobCacheTests::writeJob(const QString &name, const QByteArray &content)
+{
+    const QString path = dir.filePath(name);
+    QFile file(path);
+    if (!file.open(QFile::WriteOnly) || file.write(content) != content.size()) {
+        return QString();
+    }
+    return path;
+}
+
+void JobCacheTests::testContent()
+{
+    const QSharedPointer<const CachedJob> job = JobCache::instance()->acquire(writeJob(QStringLiteral("lines.gcode"), _job));
+    QVERIFY(job);
+    QCOMPARE(job->data(), _job);
+    QCOMPARE(job->estimate().lineCount(), std::size_t(5));
+    QCOMPARE(job->estimate().layerCount(), 1);
+}
+
+void JobCacheTests::testSharedContent()
+{
+    JobCache *cache = JobCache::instance();
+    const QSharedPointer<const CachedJob> first = cache->acquire(writeJob(QStringLiteral("first.gcode"), _job));
+    const QSharedPointer<const CachedJob> second = cache->acquire(writeJob(QStringLiteral("second.gcode"), _job));
+    QVERIFY(first);
+    QCOMPARE(first.data(), second.data());
+    QCOMPARE(cache->jobCount(), 1);
+
+    //Acquiring the same unchanged path again hands out the same job too.
+    QCOMPARE(cache->acquire(dir.filePath(QStringLiteral("first.gcode"))).data(), first.data());
+}
+
+void JobCacheTests::testDistinctContent()
+{
+    JobCache *cache = JobCache::instance();
+    const QSharedPointer<const CachedJob> first = cache->acquire(writeJob(QStringLiteral("a.gcode"), _job));
+    const QSharedPointer<const CachedJob> second = cache->acquire(writeJob(QStringLiteral("b.gcode"), QByteArrayLiteral("G28\nM84\n")));
+    QVERIFY(first && second);
+    QVERIFY(first.data() != second.data());
+    QVERIFY(first->hash() != second->hash());
+    QCOMPARE(cache->jobCount(), 2);
+}
+
+void JobCacheTests::testRelease()
+{
+    JobCache *cache = JobCache::instance();
+    QSharedPointer<const CachedJob> job = cache->acquire(writeJob(QStringLiteral("release.gcode"), _job));
+    QVERIFY(job);
+    QCOMPARE(cache->jobCount(), 1);
+    job.clear();
+    QCOMPARE(cache->jobCount(), 0);
+}
+
+void JobCacheTests::testRewrittenFile()
+{
+    JobCache *cache = JobCache::instance();
+    const QString path = writeJob(QStringLiteral("rewritten.gcode"), _job);
+    const QSharedPointer<const CachedJob> job = cache->acquire(path);
+    QVERIFY(job);
+
+    //The job held keeps the content it was read with.
+    QVERIFY(!writeJob(QStringLiteral("rewritten.gcode"), QByteArrayLiteral("M84\n")).isEmpty());
+    QCOMPARE(job->data(), _job);
+
+    const QSharedPointer<const CachedJob> rewritten = cache->acquire(path);
+    QVERIFY(rewritten);
+    QCOMPARE(rewritten->data(), QByteArrayLiteral("M84\n"));
+    QCOMPARE(cache->jobCount(), 2);
+}
+
+void JobCacheTests::testConcurrent()
+{
+    //Every printer starting the same file gets the one job, read once.
+    const QString path = writeJob(QStringLiteral("concurrent.gcode"), _job);
+    std::vector<QSharedPointer<const CachedJob>> jobs(8);
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < jobs.size(); i++) {
+        threads.emplace_back([&jobs, &path, i] {
+            jobs[i] = JobCache::instance()->acquire(path);
+        });
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+    QVERIFY(jobs.front());
+    for (const QSharedPointer<const CachedJob> &job : jobs) {
+        QCOMPARE(job.data(), jobs.front().data());
+    }
+    QCOMPARE(JobCache::instance()->jobCount(), 1);
+}
+
+void JobCacheTests::testMissingFile()
+{
+    QString error;
+    QVERIFY(!JobCache::instance()->acquire(dir.filePath(QStringLiteral("missing.gcode")), &error));
+    QVERIFY(!error.isEmpty());
+}
+
+QTEST_MAIN(JobCacheTests)
@@ -0,0 +1,78 @@
+/*
+    This file is part of the KDE project
+
+    Copyright (C) 2026 The AtCore contributors
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "jobestimatetests.h"
+
+void JobEstimateTests::testMoveTime()
+{
+    AtCoreProtocol::JobEstimate estimate;
+    estimate.addLine(std::string("G28"));
+    estimate.addLine(std::string("G1 X60 F3600 ; 60mm at 60mm/s"));
+    estimate.addLine(std::string("G4 P500"));
+    estimate.addLine(std::string("G1 X60 Y80"));
+    QCOMPARE(estimate.lineCount(), std::size_t(4));
+    QCOMPARE(estimate.timeAt(0), 0.0);
+    QCOMPARE(estimate.timeAt(1), 1.0);
+    QCOMPARE(estimate.timeAt(2), 1.5);
+    QCOMPARE(estimate.totalTime(), 1.5 + 80.0 / 60.0);
+    QCOMPARE(estimate.timeAt(100), estimate.timeAt(3));
+}
+
+void JobEstimateTests::testRelativeMoves()
+{
+    AtCoreProtocol::JobEstimate estimate;
+    estimate.addLine(std::string("G91"));
+    estimate.addLine(std::string("G1 X6 F360"));
+    estimate.addLine(std::string("G1 X6"));
+    estimate.addLine(std::string("G90"));
+    estimate.addLine(std::string("M83"));
+    estimate.addLine(std::string("G1 E6"));
+    estimate.addLine(std::string("G1 E6"));
+    QCOMPARE(estimate.totalTime(), 4.0);
+}
+
+void JobEstimateTests::testLayersFromZ()
+{
+    AtCoreProtocol::JobEstimate estimate;
+    const char *job[] = {"G28", "G1 Z5 F600", "G1 Z0.2", "G1 X10 E1", "G1 Z0.4", "G1 X0", "G1 Y10 E2", "G1 Z10"};
+    for (const char *line : job) {
+        estimate.addLine(std::string(line));
+    }
+    QCOMPARE(estimate.layerCount(), 2);
+    QCOMPARE(estimate.layerAt(2), 0);
+    QCOMPARE(estimate.layerAt(3), 1);
+    QCOMPARE(estimate.layerAt(5), 1);
+    QCOMPARE(estimate.layerAt(6), 2);
+    QCOMPARE(estimate.layerAt(7), 2);
+}
+
+void JobEstimateTests::testLayersFromComments()
+{
+    AtCoreProtocol::JobEstimate estimate;
+    const char *job[] = {"G1 Z0.2 E1", ";LAYER:0", "G1 X10 E1", ";LAYER:1", "G1 Z0.4", ";LAYER:2", "G1 Z0.6"};
+    for (const char *line : job) {
+        estimate.addLine(std::string(line));
+    }
+    QCOMPARE(estimate.layerCount(), 3);
+    QCOMPARE(estimate.layerAt(0), 0);
+    QCOMPARE(estimate.layerAt(2), 1);
+    QCOMPARE(estimate.layerAt(4), 2);
+    QCOMPARE(estimate.layerAt(6), 3);
+}
+
+QTEST_MAIN(JobEstimateTests)
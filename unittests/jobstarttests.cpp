@@ -0,0 +1,137 @@
+/*
+    This file is part of the KDE project
+
+    Copyright (C) 2026 The AtCore contributors
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "jobstarttests.h"
+
+QStringList JobStartTests::optimize(const QStringList &lines, bool hotProbe, int *firstWait)
+{
+    std::vector<std::string> job;
+    for (const QString &line : lines) {
+        job.push_back(line.toStdString());
+    }
+    AtCoreProtocol::JobStartOptions options;
+    options.hotProbe = hotProbe;
+    std::size_t wait = 0;
+    if (!AtCoreProtocol::optimizeJobStart(job, options, &wait)) {
+        return lines;
+    }
+    if (firstWait) {
+        *firstWait = int(wait);
+    }
+    QStringList result;
+    for (const std::string &line : job) {
+        result.append(QString::fromStdString(line));
+    }
+    return result;
+}
+
+void JobStartTests::testOverlapHeating()
+{
+    const QStringList job = {
+        QStringLiteral("M190 S60"), QStringLiteral("M109 S210"), QStringLiteral("G28"),
+        QStringLiteral("G29"), QStringLiteral("G92 E0"), QStringLiteral("G1 X10 E5")
+    };
+    const QStringList expected = {
+        QStringLiteral("M140 S60"), QStringLiteral("M104 S210"), QStringLiteral("G28"),
+        QStringLiteral("M190 S60"), QStringLiteral("G29"), QStringLiteral("G92 E0"),
+        QStringLiteral("M109 S210"), QStringLiteral("G1 X10 E5")
+    };
+    int firstWait = -1;
+    QCOMPARE(optimize(job, false, &firstWait), expected);
+    QCOMPARE(firstWait, 3);
+}
+
+void JobStartTests::testHotProbe()
+{
+    const QStringList job = {
+        QStringLiteral("M190 S60"), QStringLiteral("M109 S210"), QStringLiteral("G28"),
+        QStringLiteral("G29"), QStringLiteral("G1 X10 E5")
+    };
+    const QStringList expected = {
+        QStringLiteral("M140 S60"), QStringLiteral("M104 S210"), QStringLiteral("G28"),
+        QStringLiteral("M190 S60"), QStringLiteral("M109 S210"), QStringLiteral("G29"),
+        QStringLiteral("G1 X10 E5")
+    };
+    QCOMPARE(optimize(job, true), expected);
+}
+
+void JobStartTests::testSetpointBarrier()
+{
+    //Probe temperature first, print temperature after probing.
+    const QStringList job = {
+        QStringLiteral("M109 S150"), QStringLiteral("G28"), QStringLiteral("G29"),
+        QStringLiteral("M104 S215"), QStringLiteral("M109 S215"), QStringLiteral("G1 X1 E2")
+    };
+    const QStringList expected = {
+        QStringLiteral("M104 S150"), QStringLiteral("G28"), QStringLiteral("G29"),
+        QStringLiteral("M109 S150"), QStringLiteral("M104 S215"), QStringLiteral("M109 S215"),
+        QStringLiteral("G1 X1 E2")
+    };
+    QCOMPARE(optimize(job), expected);
+}
+
+void JobStartTests::testToolChangeBarrier()
+{
+    const QStringList job = {
+        QStringLiteral("M109 S200"), QStringLiteral("T1"), QStringLiteral("G28"), QStringLiteral("G1 X1 E1")
+    };
+    QCOMPARE(optimize(job), job);
+}
+
+void JobStartTests::testSetpointAfterToolChange()
+{
+    //M104 without T heats the active tool, it must not move above T1.
+    const QStringList job = {
+        QStringLiteral("G28"), QStringLiteral("T1"), QStringLiteral("M190 S60"),
+        QStringLiteral("M109 S210"), QStringLiteral("G29"), QStringLiteral("G1 X10 E5")
+    };
+    const QStringList expected = {
+        QStringLiteral("M140 S60"), QStringLiteral("G28"), QStringLiteral("T1"),
+        QStringLiteral("M104 S210"), QStringLiteral("M190 S60"), QStringLiteral("G29"),
+        QStringLiteral("M109 S210"), QStringLiteral("G1 X10 E5")
+    };
+    int firstWait = -1;
+    QCOMPARE(optimize(job, false, &firstWait), expected);
+    QCOMPARE(firstWait, 4);
+}
+
+void JobStartTests::testUnchanged()
+{
+    //No wait, a cooling wait and no extrusion at all.
+    QStringList job = {QStringLiteral("G28"), QStringLiteral("G1 X10 E5")};
+    QCOMPARE(optimize(job), job);
+    job = QStringList({QStringLiteral("M190 R40"), QStringLiteral("G28"), QStringLiteral("G1 X10 E5")});
+    QCOMPARE(optimize(job), job);
+}
+
+void JobStartTests::testRetractIsBarrier()
+{
+    //A cold retract is refused like a cold extrusion, the waits stay ahead of it.
+    const QStringList job = {
+        QStringLiteral("M190 S60"), QStringLiteral("M109 S210"), QStringLiteral("G28"),
+        QStringLiteral("G1 E-2"), QStringLiteral("G29"), QStringLiteral("G1 X10 E5")
+    };
+    const QStringList expected = {
+        QStringLiteral("M140 S60"), QStringLiteral("M104 S210"), QStringLiteral("G28"),
+        QStringLiteral("M190 S60"), QStringLiteral("M109 S210"), QStringLiteral("G1 E-2"),
+        QStringLiteral("G29"), QStringLiteral("G1 X10 E5")
+    };
+    QCOMPARE(optimize(job), expected);
+}
+
+QTEST_MAIN(JobStartTests)
@@ -0,0 +1,87 @@
+/*
+    This file is part of the KDE project
+
+    Copyright (C) 2026 The AtCore contributors
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <algorithm>
+#include <vector>
+
+#include "linkstatstests.h"
+
+void LinkStatsTests::testPercentiles()
+{
+    //1 to 100 ms, in any order.
+    std::vector<qint64> samples;
+    for (qint64 msecs = 100; msecs > 0; --msecs) {
+        samples.push_back(msecs * 1000);
+    }
+    std::rotate(samples.begin(), samples.begin() + 37, samples.end());
+    LinkStats::Figures figures;
+    LinkStats::percentiles(samples, figures);
+    QCOMPARE(figures.p50, 50.0);
+    QCOMPARE(figures.p95, 95.0);
+    QCOMPARE(figures.p99, 99.0);
+    QCOMPARE(figures.max, 100.0);
+}
+
+void LinkStatsTests::testPercentilesSingleSample()
+{
+    LinkStats::Figures figures;
+    LinkStats::percentiles(std::vector<qint64>(1, 2500), figures);
+    QCOMPARE(figures.p50, 2.5);
+    QCOMPARE(figures.p95, 2.5);
+    QCOMPARE(figures.p99, 2.5);
+    QCOMPARE(figures.max, 2.5);
+}
+
+void LinkStatsTests::testPercentilesNoSample()
+{
+    LinkStats::Figures figures;
+    LinkStats::percentiles(std::vector<qint64>(), figures);
+    QCOMPARE(figures.p50, -1.0);
+    QCOMPARE(figures.p99, -1.0);
+    QCOMPARE(figures.max, -1.0);
+}
+
+void LinkStatsTests::testAcknowledgeInOrder()
+{
+    LinkStats stats;
+    stats.commandSent(10);
+    stats.commandSent(20);
+    stats.bytesSent(1);
+    QCOMPARE(stats.inFlight(), 2);
+
+    stats.commandAcknowledged();
+    QCOMPARE(stats.inFlight(), 1);
+    LinkStats::Figures figures = stats.window();
+    QCOMPARE(figures.lines, qint64(1));
+    QCOMPARE(figures.bytes, qint64(31));
+    QVERIFY(figures.p50 >= 0);
+
+    //A new window starts empty, the totals keep everything.
+    stats.commandAcknowledged();
+    stats.commandAcknowledged();
+    QCOMPARE(stats.inFlight(), 0);
+    figures = stats.window();
+    QCOMPARE(figures.lines, qint64(1));
+    QCOMPARE(figures.bytes, qint64(0));
+    figures = stats.total();
+    QCOMPARE(figures.lines, qint64(2));
+    QCOMPARE(figures.bytes, qint64(31));
+    QVERIFY(figures.max >= figures.p50);
+}
+
+QTEST_MAIN(LinkStatsTests)
@@ -0,0 +1,100 @@
+/*
+    This file is part of the KDE project
+
+    Copyright (C) 2026 The AtCore contributors
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <cstring>
+
+#include "meatpacktests.h"
+
+using AtCoreProtocol::MeatPack;
+
+namespace
+{
+const char *const _job[] = {
+    "G28 ; home",
+    "G1 Z0.3 F3000",
+    "G1 X10.512 Y20.250 E0.12345 F1800",
+    "G1 X12.018 Y21.774 E0.25612",
+    "G1 X14.307 Y22.004 E0.38843",
+    "G0 X100 Y100",
+    "M106 S255",
+};
+}
+
+void MeatPackTests::testMinimize()
+{
+    QCOMPARE(MeatPack::minimize("  G1  X10\tY20 ; move "), std::string("G1 X10 Y20"));
+    QCOMPARE(MeatPack::minimize("G1 X10 Y20", true), std::string("G1X10Y20"));
+    QCOMPARE(MeatPack::minimize("; comment only"), std::string());
+    QCOMPARE(MeatPack::minimize("M117 Hello  world", true), std::string("M117 Hello  world"));
+    QCOMPARE(MeatPack::minimize("M1170 S1", true), std::string("M1170S1"));
+}
+
+void MeatPackTests::testPack()
+{
+    //"G1 X10\n" is 7 characters all in the table, 4 bytes with the padding line end.
+    const std::string packed = MeatPack::pack("G1 X10");
+    QCOMPARE(packed.size(), std::size_t(4));
+    QCOMPARE(static_cast<unsigned char>(packed.at(0)), static_cast<unsigned char>(0x1D));
+    QCOMPARE(MeatPack::unpack(MeatPack::command(MeatPack::EnablePacking) + packed), std::string("G1 X10\n"));
+
+    std::string data = MeatPack::command(MeatPack::EnablePacking);
+    std::string expected;
+    for (const char *line : _job) {
+        const std::string text = MeatPack::minimize(line);
+        data += MeatPack::pack(text);
+        expected += text + '\n';
+    }
+    QCOMPARE(MeatPack::unpack(data), expected);
+}
+
+void MeatPackTests::testNoSpaces()
+{
+    const std::string text = MeatPack::minimize("G1 X1 E2.5", true);
+    const std::string packed = MeatPack::pack(text, true);
+    //"G1X1E2.5\n" has no literal, "E" takes the space code.
+    QCOMPARE(packed.size(), std::size_t(5));
+    const std::string data = MeatPack::command(MeatPack::EnableNoSpaces) + MeatPack::command(MeatPack::EnablePacking) + packed;
+    QCOMPARE(MeatPack::unpack(data), std::string("G1X1E2.5\n"));
+}
+
+void MeatPackTests::testLiterals()
+{
+    const std::string data = MeatPack::command(MeatPack::EnablePacking) + MeatPack::pack("M117 Hi")
+                             + MeatPack::command(MeatPack::DisablePacking) + "M112\n";
+    QCOMPARE(MeatPack::unpack(data), std::string("M117 Hi\nM112\n"));
+}
+
+void MeatPackTests::benchmarkPack()
+{
+    std::size_t plain = 0;
+    std::size_t packed = 0;
+    for (const char *line : _job) {
+        plain += std::strlen(line) + 2;
+        packed += MeatPack::pack(MeatPack::minimize(line, true), true).size();
+    }
+    //Moves pack to well under two thirds of the text sent with "\n\r".
+    QVERIFY(packed * 3 < plain * 2);
+
+    QBENCHMARK {
+        for (const char *line : _job) {
+            MeatPack::pack(MeatPack::minimize(line, true), true);
+        }
+    }
+}
+
+QTEST_MAIN(MeatPackTests)
@@ -0,0 +1,406 @@
+/*
+    This file is part of the KDE project
+
+    Copyright (C) 2026 The AtCore contributors
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "protocolenginetests.h"
+#include "../src/protocol/reprapstatus.h"
+
+using namespace AtCoreProtocol;
+
+void ProtocolEngineTests::init()
+{
+    written.clear();
+    lines.clear();
+    engine = new ProtocolEngine();
+    engine->setWriteHandler([this](const std::string & command) {
+        written.append(QString::fromStdString(command));
+        return true;
+    });
+    engine->setLineHandler([this](const std::string & line, int) {
+        lines.append(QString::fromStdString(line));
+    });
+}
+
+void ProtocolEngineTests::cleanup()
+{
+    delete engine;
+    engine = nullptr;
+}
+
+void ProtocolEngineTests::testFraming()
+{
+    const QByteArray data("start\r\nok\nok T:20");
+    engine->receive(data.constData(), 10);
+    engine->receive(data.constData() + 10, std::size_t(data.size() - 10));
+    QStringList expected = {QStringLiteral("start"), QStringLiteral("ok")};
+    QCOMPARE(lines, expected);
+
+    engine->receive("\n\r", 2);
+    expected.append(QStringLiteral("ok T:20"));
+    QCOMPARE(lines, expected);
+}
+
+void ProtocolEngineTests::testClassify()
+{
+    QCOMPARE(classifyMessage(std::string("ok")), int(Acknowledge));
+    QCOMPARE(classifyMessage(std::string("ok T:20 /0 B:20 /0")), int(Acknowledge | Temperature));
+    QCOMPARE(classifyMessage(std::string("Error:Printer halted")), int(Error));
+    QCOMPARE(classifyMessage(std::string("Resend: 12")), int(Resend));
+    QCOMPARE(classifyMessage(std::string("echo:busy: processing")), int(Busy));
+    QCOMPARE(classifyMessage(std::string("X:0.00 Y:0.00 Z:0.00 E:0.00")), int(Position));
+    QCOMPARE(classifyMessage(std::string("Cap:AUTOREPORT_TEMP:1")), int(Capability));
+    QCOMPARE(classifyMessage(std::string("FIRMWARE_NAME:Marlin EXTRUDER_COUNT:1")), int(FirmwareInfo));
+    QCOMPARE(classifyMessage(std::string("<Idle|MPos:0.000,0.000,0.000|FS:0,0>")), int(Status));
+    QCOMPARE(classifyMessage(std::string("echo:Unknown command")), int(NoMessage));
+}
+
+void ProtocolEngineTests::testFlowControl()
+{
+    engine->submit("G28");
+    QVERIFY(written.isEmpty());
+
+    engine->setReady(true);
+    engine->submit("G28");
+    engine->submit("M105");
+    QCOMPARE(written, QStringList({QStringLiteral("G28")}));
+    QCOMPARE(engine->queue().size(), std::size_t(2));
+
+    engine->receive("echo:busy: processing\n", 22);
+    QCOMPARE(written.size(), 1);
+
+    engine->receive("ok\n", 3);
+    engine->receive("ok\n", 3);
+    QStringList expected = {QStringLiteral("G28"), QStringLiteral("G28"), QStringLiteral("M105")};
+    QCOMPARE(written, expected);
+    QVERIFY(engine->queue().isEmpty());
+    QVERIFY(!engine->isReady());
+
+    engine->receive("ok\n", 3);
+    QVERIFY(engine->isReady());
+}
+
+void ProtocolEngineTests::testWriteFailure()
+{
+    bool open = false;
+    engine->setWriteHandler([&open, this](const std::string & command) {
+        if (open) {
+            written.append(QString::fromStdString(command));
+        }
+        return open;
+    });
+    engine->setReady(true);
+    engine->submit("G28");
+    QVERIFY(written.isEmpty());
+    QCOMPARE(engine->queue().size(), std::size_t(1));
+
+    open = true;
+    engine->acknowledge();
+    QCOMPARE(written, QStringList({QStringLiteral("G28")}));
+    QVERIFY(engine->queue().isEmpty());
+}
+
+void ProtocolEngineTests::testTemperature()
+{
+    TemperatureReport report;
+    engine->setTemperatureHandler([&report](const TemperatureReport & received) {
+        report = received;
+    });
+    const QByteArray data("ok B:49.06 /55 T:64.78 /215\n");
+    engine->receive(data.constData(), std::size_t(data.size()));
+    QVERIFY(report.hasExtruder && report.hasBed);
+    QCOMPARE(report.extruder, float(64.78));
+    QCOMPARE(report.extruderTarget, 215.0f);
+    QCOMPARE(report.bed, float(49.06));
+    QCOMPARE(report.bedTarget, 55.0f);
+
+    TemperatureReport noTarget;
+    QVERIFY(parseTemperature(std::string("ok T:154 @:0 B:150"), noTarget));
+    QCOMPARE(noTarget.extruder, 154.0f);
+    QCOMPARE(noTarget.extruderTarget, 0.0f);
+    QCOMPARE(noTarget.bed, 150.0f);
+
+    TemperatureReport none;
+    QVERIFY(!parseTemperature(std::string("ok"), none));
+}
+
+void ProtocolEngineTests::testTeacupDialect()
+{
+    engine->setDialect(Dialect::teacup());
+    engine->setReady(true);
+    engine->submit("M109 S200");
+    engine->receive("ok\n", 3);
+    engine->submit("M190 S60");
+    engine->receive("ok\n", 3);
+    engine->submit("M104 S200");
+    QStringList expected = {QStringLiteral("M104 S200\r\nM116"), QStringLiteral("M140 S60\r\nM116"), QStringLiteral("M104 S200")};
+    QCOMPARE(written, expected);
+}
+
+void ProtocolEngineTests::testCompletion()
+{
+    QStringList reply;
+    bool done = false;
+    engine->setReady(true);
+    engine->submit("G28");
+    engine->submit("M114", [&](const std::vector<std::string> & received, bool) {
+        for (const std::string &line : received) {
+            reply.append(QString::fromStdString(line));
+        }
+        done = true;
+        engine->submit("M105");
+    });
+
+    engine->receive("ok\n", 3);
+    QVERIFY(!done);
+    engine->receive("X:10.00 Y:0.00 Z:0.00 E:0.00\nok\n", 32);
+    QVERIFY(done);
+    QCOMPARE(reply, QStringList({QStringLiteral("X:10.00 Y:0.00 Z:0.00 E:0.00")}));
+
+    //The completion queued the next command and it went out at once.
+    QStringList expected = {QStringLiteral("G28"), QStringLiteral("M114"), QStringLiteral("M105")};
+    QCOMPARE(written, expected);
+    QVERIFY(!engine->isReady());
+}
+
+void ProtocolEngineTests::testCompletionNotCoalesced()
+{
+    int done = 0;
+    engine->submit("M104 S200", [&done](const std::vector<std::string> &, bool) {
+        done++;
+    });
+    engine->submit("M104 S210");
+    QCOMPARE(engine->queue().size(), std::size_t(2));
+
+    engine->acknowledge();
+    engine->receive("ok\n", 3);
+    QCOMPARE(done, 1);
+    engine->receive("ok\n", 3);
+    QCOMPARE(done, 1);
+}
+
+void ProtocolEngineTests::testUnsolicitedLines()
+{
+    QStringList reply;
+    engine->setReady(true);
+    engine->submit("M503", [&reply](const std::vector<std::string> & received, bool) {
+        for (const std::string &line : received) {
+            reply.append(QString::fromStdString(line));
+        }
+    });
+    const QByteArray data(
+        "echo:; Steps per unit:\n"
+        " T:20.00 /0.00 B:20.00 /0.00 @:0 B@:0\n"
+        "echo:  M92 X80.00 Y80.00 Z400.00 E93.00\n"
+        "echo:busy: processing\n"
+        "ok\n");
+    engine->receive(data.constData(), std::size_t(data.size()));
+    QStringList expected = {QStringLiteral("echo:; Steps per unit:"), QStringLiteral("echo:  M92 X80.00 Y80.00 Z400.00 E93.00")};
+    QCOMPARE(reply, expected);
+    QCOMPARE(lines.size(), 5);
+
+    reply.clear();
+    engine->submit("M105", [&reply](const std::vector<std::string> & received, bool) {
+        for (const std::string &line : received) {
+            reply.append(QString::fromStdString(line));
+        }
+    });
+    engine->receive("T:20.00 /0.00\nok\n", 17);
+    QCOMPARE(reply, QStringList({QStringLiteral("T:20.00 /0.00")}));
+}
+
+void ProtocolEngineTests::testBatch()
+{
+    std::vector<std::string> batch;
+    for (int i = 0; i < 10000; i++) {
+        batch.push_back(i % 2 ? "G1 X1" : "G91");
+    }
+    int done = 0;
+    engine->submit("G91");
+    engine->submit(batch, [&done](const std::vector<std::string> &, bool) {
+        done++;
+    });
+    engine->submit("G1 X1");
+    QCOMPARE(engine->queue().size(), batch.size() + 2);
+
+    //One acknowledge for the first G91 and one per command of the batch.
+    engine->acknowledge();
+    for (std::size_t i = 0; i < batch.size(); i++) {
+        engine->receive("ok\n", 3);
+        QCOMPARE(done, 0);
+    }
+    engine->receive("ok\n", 3);
+    QCOMPARE(done, 1);
+    QCOMPARE(written.size(), int(batch.size()) + 2);
+    QCOMPARE(written.at(1), QStringLiteral("G91"));
+    QCOMPARE(written.at(2), QStringLiteral("G1 X1"));
+}
+
+void ProtocolEngineTests::testSendWindow()
+{
+    engine->setDialect(Dialect::grbl());
+    engine->setSendWindow(30);
+    //10 + 1 bytes each, two fit in the window.
+    for (int i = 0; i < 4; i++) {
+        engine->submit(std::string("G1 X") + std::to_string(i) + " F100");
+    }
+    engine->acknowledge();
+    QCOMPARE(written.size(), 2);
+    QCOMPARE(engine->bytesInFlight(), std::size_t(22));
+    QCOMPARE(engine->commandsInFlight(), std::size_t(2));
+
+    engine->receive("<Run|MPos:0.000,0.000,0.000|FS:100,0>\n", 38);
+    QCOMPARE(written.size(), 2);
+
+    engine->receive("ok\n", 3);
+    QCOMPARE(written.size(), 3);
+    engine->receive("error:20\n", 9);
+    QCOMPARE(written.size(), 4);
+    QCOMPARE(engine->bytesInFlight(), std::size_t(22));
+
+    engine->receive("ok\nok\n", 6);
+    QCOMPARE(engine->bytesInFlight(), std::size_t(0));
+    QCOMPARE(engine->commandsInFlight(), std::size_t(0));
+}
+
+void ProtocolEngineTests::testGrblStatus()
+{
+    GrblStatus status;
+    QVERIFY(!parseGrblStatus(std::string("ok"), status));
+
+    QVERIFY(parseGrblStatus(std::string("<Run|MPos:10.000,-2.500,1.000|Bf:14,96|FS:1200,8000|WCO:5.000,0.000,1.000>"), status));
+    QCOMPARE(status.state, std::string("Run"));
+    QVERIFY(status.hasMachinePosition);
+    QCOMPARE(status.machinePosition[0], 10.0);
+    QCOMPARE(status.machinePosition[1], -2.5);
+    QVERIFY(status.hasWorkPosition);
+    QCOMPARE(status.workPosition[0], 5.0);
+    QCOMPARE(status.workPosition[2], 0.0);
+    QCOMPARE(status.plannerBlocks, 14);
+    QCOMPARE(status.rxBytes, 96);
+    QVERIFY(status.hasFeed);
+    QCOMPARE(status.feed, 1200.0);
+    QCOMPARE(status.spindle, 8000.0);
+
+    //Grbl 0.9
+    GrblStatus old;
+    QVERIFY(parseGrblStatus(std::string("<Hold:0,MPos:1.000,2.000,3.000,WPos:0.000,1.000,2.000>"), old));
+    QCOMPARE(old.state, std::string("Hold:0"));
+    QCOMPARE(old.machinePosition[2], 3.0);
+    QCOMPARE(old.workPosition[1], 1.0);
+    QCOMPARE(old.plannerBlocks, -1);
+    QVERIFY(!old.hasFeed);
+}
+
+void ProtocolEngineTests::testReset()
+{
+    QStringList aborted;
+    engine->setDialect(Dialect::grbl());
+    engine->setSendWindow(30);
+    engine->setReady(true);
+    engine->submit("G1 X1 F100", [&aborted](const std::vector<std::string> &, bool dropped) {
+        aborted.append(dropped ? QStringLiteral("X1 aborted") : QStringLiteral("X1"));
+    });
+    engine->submit("G1 X2 F100");
+    engine->submit("G1 X3 F100", [&aborted](const std::vector<std::string> &, bool dropped) {
+        aborted.append(dropped ? QStringLiteral("X3 aborted") : QStringLiteral("X3"));
+    });
+    QCOMPARE(written.size(), 1);
+
+    //Status reports are never part of a reply.
+    engine->receive("<Run|MPos:0.000,0.000,0.000|FS:100,0>\n", 38);
+    engine->reset();
+    QStringList expected = {QStringLiteral("X1 aborted"), QStringLiteral("X3 aborted")};
+    QCOMPARE(aborted, expected);
+    QVERIFY(engine->queue().isEmpty());
+    QCOMPARE(engine->bytesInFlight(), std::size_t(0));
+    QVERIFY(engine->isReady());
+
+    engine->submit("G1 X4 F100");
+    QCOMPARE(written.size(), 2);
+    engine->receive("ok\n", 3);
+    QCOMPARE(aborted, expected);
+}
+
+void ProtocolEngineTests::testClear()
+{
+    int calls = 0;
+    bool aborted = false;
+    engine->submit("G28");
+    engine->submit("M114", [&calls, &aborted](const std::vector<std::string> &, bool dropped) {
+        calls++;
+        aborted = dropped;
+    });
+    engine->clear();
+    QCOMPARE(calls, 1);
+    QVERIFY(aborted);
+    QVERIFY(engine->queue().isEmpty());
+
+    engine->setReady(true);
+    engine->submit("G28");
+    engine->receive("ok\n", 3);
+    QCOMPARE(calls, 1);
+}
+
+void ProtocolEngineTests::testMaxLineLength()
+{
+    QStringList rejected;
+    bool aborted = false;
+    engine->setRejectHandler([&rejected](const std::string & command) {
+        rejected.append(QString::fromStdString(command));
+    });
+    engine->setSendWindow(0, 2);
+    engine->setMaxLineLength(8);
+    engine->setReady(true);
+
+    //"M117 ab" and its terminator is 9 bytes.
+    engine->submit("M117 ab", [&aborted](const std::vector<std::string> &, bool dropped) {
+        aborted = dropped;
+    });
+    QVERIFY(aborted);
+    QCOMPARE(rejected, QStringList{QStringLiteral("M117 ab")});
+    QVERIFY(written.isEmpty());
+
+    engine->submit("M117 a");
+    engine->submit("G28");
+    QCOMPARE(written, QStringList{QStringLiteral("M117 a")});
+    engine->receive("ok\n", 3);
+    QStringList expected = {QStringLiteral("M117 a"), QStringLiteral("G28")};
+    QCOMPARE(written, expected);
+    QCOMPARE(rejected.size(), 1);
+}
+
+void ProtocolEngineTests::testRepRapStatus()
+{
+    RepRapStatus status;
+    QVERIFY(!parseRepRapStatus(std::string("ok"), status));
+    QVERIFY(!parseRepRapStatus(std::string("{\"status\":\"I\""), status));
+
+    const std::string reply(
+        "{\"status\":\"P\",\"heaters\":[60.1,210.5],\"active\":[60.0,210.0],\"standby\":[0.0,0.0],"
+        "\"hstat\":[2,2],\"pos\":[10.000,20.500,0.300],\"tool\":0,\"probe\":\"0\",\"fanPercent\":[50.0,100.0],"
+        "\"msgBox\":{\"msg\":\"say \\\"hi\\\"\",\"mode\":0,\"controls\":[]},\"fraction_printed\":0.4215}");
+    QVERIFY(parseRepRapStatus(reply, status));
+    QCOMPARE(status.status, 'P');
+    QCOMPARE(status.heaters, std::vector<double>({60.1, 210.5}));
+    QCOMPARE(status.active, std::vector<double>({60.0, 210.0}));
+    QCOMPARE(status.position, std::vector<double>({10.0, 20.5, 0.3}));
+    QCOMPARE(status.fanPercent, std::vector<double>({50.0, 100.0}));
+    QCOMPARE(status.tool, 0);
+    QCOMPARE(status.fractionPrinted, 0.4215);
+}
+
+QTEST_MAIN(ProtocolEngineTests)
@@ -0,0 +1,50 @@
+/*
+    This file is part of the KDE project
+
+    Copyright (C) 2026 The AtCore contributors
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <QtTest>
+#include <QObject>
+
+#include "../src/protocol/protocolengine.h"
+
+class ProtocolEngineTests: public QObject
+{
+    Q_OBJECT
+private slots:
+    void init();
+    void cleanup();
+    void testFraming();
+    void testClassify();
+    void testFlowControl();
+    void testWriteFailure();
+    void testTemperature();
+    void testTeacupDialect();
+    void testCompletion();
+    void testCompletionNotCoalesced();
+    void testUnsolicitedLines();
+    void testBatch();
+    void testSendWindow();
+    void testGrblStatus();
+    void testReset();
+    void testClear();
+    void testMaxLineLength();
+    void testRepRapStatus();
+private:
+    AtCoreProtocol::ProtocolEngine *engine = nullptr;
+    QStringList written;
+    QStringList lines;
+};
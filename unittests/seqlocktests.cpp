@@ -0,0 +1,121 @@
+/*
+    This file is part of the KDE project
+
+    Copyright (C) 2026 The AtCore contributors
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+#include "seqlocktests.h"
+#include "../src/protocol/printersnapshot.h"
+
+using namespace AtCoreProtocol;
+
+namespace
+{
+/**
+ * @brief Value spanning several words, all equal when whole
+ */
+struct Counters {
+    std::uint64_t values[6];
+};
+}
+
+void SeqLockTests::testStoreLoad()
+{
+    SeqLock<PrinterSnapshot> lock;
+    QCOMPARE(lock.load().layout, std::uint32_t(PrinterSnapshot::Layout));
+    const std::uint32_t sequence = lock.sequence();
+
+    PrinterSnapshot snapshot;
+    snapshot.state = 3;
+    snapshot.heaterCount = 2;
+    snapshot.temperature[1] = 210.5f;
+    snapshot.commandsSent = 1234567890123ULL;
+    lock.store(snapshot);
+    QCOMPARE(lock.sequence(), sequence + 2);
+
+    PrinterSnapshot read;
+    QVERIFY(lock.tryLoad(read));
+    QCOMPARE(read.state, 3);
+    QCOMPARE(read.heaterCount, std::uint32_t(2));
+    QCOMPARE(read.temperature[1], 210.5f);
+    QCOMPARE(read.commandsSent, std::uint64_t(1234567890123ULL));
+}
+
+void SeqLockTests::testSharedStorage()
+{
+    //Writer and reader over the same memory, as in a shared memory segment.
+    std::vector<char> memory(sizeof(SeqLock<Counters>::Storage));
+    SeqLock<Counters> writer(SeqLock<Counters>::initialize(memory.data()));
+    SeqLock<Counters> reader(reinterpret_cast<SeqLock<Counters>::Storage *>(memory.data()));
+    QCOMPARE(reader.sequence(), std::uint32_t(0));
+
+    Counters counters = {{1, 2, 3, 4, 5, 6}};
+    writer.store(counters);
+    QCOMPARE(reader.sequence(), std::uint32_t(2));
+    QCOMPARE(reader.load().values[5], std::uint64_t(6));
+}
+
+void SeqLockTests::testConcurrentReaders()
+{
+    SeqLock<Counters> lock;
+    std::atomic<bool> done(false);
+    std::atomic<int> torn(0);
+    std::atomic<long> reads(0);
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 3; i++) {
+        readers.emplace_back([&] {
+            while (!done.load()) {
+                const Counters counters = lock.load();
+                for (std::uint64_t value : counters.values) {
+                    if (value != counters.values[0]) {
+                        torn++;
+                        break;
+                    }
+                }
+                reads++;
+            }
+        });
+    }
+    for (std::uint64_t n = 1; n <= 200000; n++) {
+        Counters counters;
+        std::fill(std::begin(counters.values), std::end(counters.values), n);
+        lock.store(counters);
+    }
+    done = true;
+    for (std::thread &reader : readers) {
+        reader.join();
+    }
+    QCOMPARE(torn.load(), 0);
+    QVERIFY(reads.load() > 0);
+    QCOMPARE(lock.load().values[0], std::uint64_t(200000));
+}
+
+void SeqLockTests::benchmarkLoad()
+{
+    SeqLock<PrinterSnapshot> lock;
+    PrinterSnapshot snapshot;
+    QBENCHMARK {
+        snapshot = lock.load();
+    }
+    QCOMPARE(snapshot.layout, std::uint32_t(PrinterSnapshot::Layout));
+}
+
+QTEST_MAIN(SeqLockTests)
@@ -0,0 +1,118 @@
+/*
+    This file is part of the KDE project
+
+    Copyright (C) 2026 The AtCore contributors
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <QElapsedTimer>
+
+#include <algorithm>
+#include <vector>
+
+#ifdef Q_OS_UNIX
+#include <fcntl.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <unistd.h>
+#endif
+
+#include "seriallayertests.h"
+
+void SerialLayerTests::initTestCase()
+{
+#ifdef Q_OS_UNIX
+    master = posix_openpt(O_RDWR | O_NOCTTY);
+    QVERIFY(master != -1);
+    QVERIFY(grantpt(master) == 0);
+    QVERIFY(unlockpt(master) == 0);
+    fcntl(master, F_SETFL, fcntl(master, F_GETFL) | O_NONBLOCK);
+    serial = new SerialLayer(QString::fromLocal8Bit(ptsname(master)), 115200);
+    QVERIFY(serial->isOpen());
+#else
+    QSKIP("A pseudo terminal is needed to emulate the printer");
+#endif
+}
+
+void SerialLayerTests::cleanupTestCase()
+{
+    delete serial;
+#ifdef Q_OS_UNIX
+    if (master != -1) {
+        ::close(master);
+    }
+#endif
+}
+
+QByteArray SerialLayerTests::readDevice(int timeout)
+{
+    QByteArray data;
+#ifdef Q_OS_UNIX
+    pollfd pfd = {master, POLLIN, 0};
+    while (::poll(&pfd, 1, timeout) > 0) {
+        char buffer[4096];
+        const ssize_t count = ::read(master, buffer, sizeof(buffer));
+        if (count <= 0) {
+            break;
+        }
+        data.append(buffer, int(count));
+        timeout = 0;
+    }
+#else
+    Q_UNUSED(timeout);
+#endif
+    return data;
+}
+
+void SerialLayerTests::testUrgentCommandLatency()
+{
+    const QByteArray move("G1 X10 Y10 Z10 E10 F3000");
+    QElapsedTimer timer;
+    std::vector<qint64> latencies;
+    for (int i = 0; i < 100; i++) {
+        // without an event loop the backlog stays in the write buffer.
+        for (int j = 0; j < 64; j++) {
+            serial->pushCommand(move);
+        }
+        timer.start();
+        serial->discardPendingOutput();
+        serial->pushUrgentCommand(QByteArray("M112"));
+        const QByteArray received = readDevice(1000);
+        latencies.push_back(timer.nsecsElapsed());
+        QCOMPARE(received, QByteArray("M112\n\r"));
+    }
+    //The median, a loaded machine may delay any single write.
+    std::nth_element(latencies.begin(), latencies.begin() + latencies.size() / 2, latencies.end());
+    QVERIFY(latencies[latencies.size() / 2] < qint64(SerialLayer::urgentLatencyTarget) * 1000000);
+}
+
+void SerialLayerTests::testUrgentCommandOrder()
+{
+    //Without discardPendingOutput() the urgent command follows what was already written.
+    serial->pushCommand(QByteArray("G28"));
+    serial->pushUrgentCommand(QByteArray("M108"));
+    QCOMPARE(readDevice(1000), QByteArray("G28\n\rM108\n\r"));
+}
+
+void SerialLayerTests::testDiscardPendingOutput()
+{
+    serial->add(QByteArray("G28"));
+    serial->pushCommand(QByteArray("G1 X10"));
+    serial->discardPendingOutput();
+    serial->push();
+    QTest::qWait(50);
+    QVERIFY(readDevice(50).isEmpty());
+}
+
+QTEST_MAIN(SerialLayerTests)
@@ -0,0 +1,129 @@
+/*
+    This file is part of the KDE project
+
+    Copyright (C) 2026 The AtCore contributors
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QWebSocket>
+
+#include "telemetryservertests.h"
+
+using AtCoreProtocol::PrinterSnapshot;
+
+namespace
+{
+/**
+ * @brief Updates of the next message received by \p spy
+ */
+QJsonArray nextUpdates(QSignalSpy &spy)
+{
+    if (spy.isEmpty() && !spy.wait(2000)) {
+        return QJsonArray();
+    }
+    return QJsonDocument::fromJson(spy.takeFirst().at(0).toString().toUtf8()).array();
+}
+}
+
+void TelemetryServerTests::testDelta()
+{
+    PrinterSnapshot from;
+    PrinterSnapshot to;
+    QVERIFY(TelemetryServer::delta(from, to).isEmpty());
+
+    to.heaterCount = 2;
+    to.temperature[1] = 205;
+    to.queueDepth = 3;
+    QJsonObject changes = TelemetryServer::delta(from, to);
+    QCOMPARE(changes.keys(), QStringList({QStringLiteral("queueDepth"), QStringLiteral("target"), QStringLiteral("temperature")}));
+    QCOMPARE(changes.value(QStringLiteral("temperature")).toArray().at(1).toDouble(), 205.0);
+
+    from = to;
+    to.target[1] = 210;
+    changes = TelemetryServer::delta(from, to);
+    QCOMPARE(changes.keys(), QStringList({QStringLiteral("target")}));
+
+    //A full update has every field but the unreported position.
+    changes = TelemetryServer::delta(to, to, true);
+    QCOMPARE(changes.size(), 13);
+    QVERIFY(!changes.contains(QStringLiteral("position")));
+}
+
+void TelemetryServerTests::testBroadcast()
+{
+    AtCore core;
+    TelemetryServer server;
+    server.setRate(50);
+    server.addPrinter(QStringLiteral("p1"), &core);
+    QVERIFY(server.listen());
+
+    QWebSocket client;
+    QSignalSpy spy(&client, SIGNAL(textMessageReceived(QString)));
+    QSignalSpy connected(&client, SIGNAL(connected()));
+    client.open(QUrl(QStringLiteral("ws://127.0.0.1:%1").arg(server.port())));
+    QVERIFY(connected.wait(2000));
+
+    QJsonArray updates = nextUpdates(spy);
+    QCOMPARE(updates.size(), 1);
+    QJsonObject update = updates.at(0).toObject();
+    QCOMPARE(update.value(QStringLiteral("printer")).toString(), QStringLiteral("p1"));
+    QVERIFY(update.value(QStringLiteral("full")).toBool());
+    QVERIFY(update.contains(QStringLiteral("state")));
+    QCOMPARE(server.clientCount(), 1);
+
+    //Only what changed follows.
+    core.temperature().setBedTemperature(70);
+    updates = nextUpdates(spy);
+    QCOMPARE(updates.size(), 1);
+    update = updates.at(0).toObject();
+    QVERIFY(!update.contains(QStringLiteral("full")));
+    QVERIFY(!update.contains(QStringLiteral("state")));
+    QCOMPARE(update.value(QStringLiteral("temperature")).toArray().at(0).toDouble(), 70.0);
+
+    //Nothing changed, nothing sent.
+    QVERIFY(!spy.wait(200));
+}
+
+void TelemetryServerTests::testSubscribe()
+{
+    AtCore first;
+    AtCore second;
+    TelemetryServer server;
+    server.setRate(50);
+    server.addPrinter(QStringLiteral("first"), &first);
+    server.addPrinter(QStringLiteral("second"), &second);
+    QVERIFY(server.listen());
+
+    QWebSocket client;
+    QSignalSpy spy(&client, SIGNAL(textMessageReceived(QString)));
+    QSignalSpy connected(&client, SIGNAL(connected()));
+    client.open(QUrl(QStringLiteral("ws://127.0.0.1:%1").arg(server.port())));
+    QVERIFY(connected.wait(2000));
+    QCOMPARE(nextUpdates(spy).size(), 2);
+
+    client.sendTextMessage(QStringLiteral("{\"subscribe\": [\"second\"]}"));
+    QJsonArray updates = nextUpdates(spy);
+    QCOMPARE(updates.size(), 1);
+    QCOMPARE(updates.at(0).toObject().value(QStringLiteral("printer")).toString(), QStringLiteral("second"));
+    QVERIFY(updates.at(0).toObject().value(QStringLiteral("full")).toBool());
+
+    first.temperature().setBedTemperature(40);
+    QVERIFY(!spy.wait(200));
+    second.temperature().setBedTemperature(40);
+    QCOMPARE(nextUpdates(spy).size(), 1);
+}
+
+QTEST_MAIN(TelemetryServerTests)
@@ -0,0 +1,176 @@
+/*
+    This file is part of the KDE project
+
+    Copyright (C) 2026 The AtCore contributors
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <algorithm>
+#include <map>
+#include <vector>
+
+#include "timerwheeltests.h"
+#include "../src/protocol/timerwheel.h"
+#include "../src/timerservice.h"
+
+using namespace AtCoreProtocol;
+
+void TimerWheelTests::testOneShot()
+{
+    TimerWheel wheel(10);
+    QCOMPARE(wheel.msecsToNext(0), std::int64_t(-1));
+
+    int runs = 0;
+    const TimerWheel::TimerId id = wheel.schedule(25, 0, [&runs] { runs++; });
+    QVERIFY(wheel.isActive(id));
+    QCOMPARE(wheel.size(), std::size_t(1));
+
+    QCOMPARE(wheel.advance(20), std::size_t(0));
+    QCOMPARE(runs, 0);
+    QVERIFY(wheel.msecsToNext(20) > 0);
+    QCOMPARE(wheel.advance(30), std::size_t(1));
+    QCOMPARE(runs, 1);
+    QVERIFY(!wheel.isActive(id));
+    QCOMPARE(wheel.size(), std::size_t(0));
+    QCOMPARE(wheel.msecsToNext(30), std::int64_t(-1));
+}
+
+void TimerWheelTests::testLongDelays()
+{
+    //Delays across every level of the wheel, never early nor more than a tick late.
+    TimerWheel wheel(10);
+    std::uint64_t now = 0;
+    int runs = 0;
+    int wrong = 0;
+    const std::uint64_t delays[] = {5, 10, 15, 640, 650, 6410, 40960, 40970, 123456, 2621440, 3000000, 170000000};
+    for (const std::uint64_t delay : delays) {
+        wheel.schedule(delay, 0, [&now, &runs, &wrong, delay] {
+            runs++;
+            if (now < delay || now > delay + 10) {
+                wrong++;
+            }
+        });
+    }
+
+    int wakeups = 0;
+    while (wheel.size()) {
+        const std::int64_t next = wheel.msecsToNext(now);
+        QVERIFY(next >= 0);
+        now += std::uint64_t(next);
+        wheel.advance(now);
+        wakeups++;
+    }
+    QCOMPARE(runs, int(std::extent<decltype(delays)>::value));
+    QCOMPARE(wrong, 0);
+    //Sleeping until msecsToNext() wakes up a few times per level, not once per tick.
+    QVERIFY(wakeups < 40);
+}
+
+void TimerWheelTests::testPeriodic()
+{
+    TimerWheel wheel(10);
+    int runs = 0;
+    wheel.schedule(100, 100, [&runs] { runs++; });
+    for (std::uint64_t now = 0; now <= 1000; now += 10) {
+        wheel.advance(now);
+    }
+    QCOMPARE(runs, 10);
+    QCOMPARE(wheel.size(), std::size_t(1));
+}
+
+void TimerWheelTests::testCancel()
+{
+    TimerWheel wheel(10);
+    int runs = 0;
+    TimerWheel::TimerId id = 0;
+    id = wheel.schedule(100, 100, [&] {
+        if (++runs == 3) {
+            wheel.cancel(id);
+        }
+    });
+    int other = 0;
+    const TimerWheel::TimerId cancelled = wheel.schedule(50, 0, [&other] { other++; });
+    wheel.cancel(cancelled);
+
+    for (std::uint64_t now = 0; now <= 2000; now += 10) {
+        wheel.advance(now);
+    }
+    QCOMPARE(runs, 3);
+    QCOMPARE(other, 0);
+    QVERIFY(!wheel.isActive(id));
+    QCOMPARE(wheel.size(), std::size_t(0));
+}
+
+void TimerWheelTests::testJitterSpread()
+{
+    //Connections opened together must not all poll on the same tick.
+    TimerWheel wheel(10);
+    std::uint64_t now = 0;
+    std::map<std::uint64_t, int> perTick;
+    int runs = 0;
+    for (int i = 0; i < 300; i++) {
+        wheel.schedule(5000, 5000, [&] {
+            perTick[now]++;
+            runs++;
+        }, 5000);
+    }
+    for (now = 0; now <= 20000; now += 10) {
+        wheel.advance(now);
+    }
+    QVERIFY(runs >= 900);
+    int largest = 0;
+    for (const auto &tick : perTick) {
+        largest = std::max(largest, tick.second);
+    }
+    QVERIFY(largest < 30);
+}
+
+void TimerWheelTests::testCatchUp()
+{
+    //A late owner runs a periodic timer once, not once per missed period.
+    TimerWheel wheel(10);
+    int runs = 0;
+    wheel.schedule(100, 100, [&runs] { runs++; });
+    QCOMPARE(wheel.advance(1000), std::size_t(1));
+    QCOMPARE(runs, 1);
+    QVERIFY(wheel.msecsToNext(1000) <= 100);
+}
+
+void TimerWheelTests::testTimerService()
+{
+    TimerService *service = TimerService::instance();
+    QCOMPARE(TimerService::instance(), service);
+    const int timers = service->timerCount();
+
+    QObject *context = new QObject;
+    int runs = 0;
+    const TimerService::TimerId id = service->start(context, 20, [&runs] { runs++; }, 0);
+    QVERIFY(service->isActive(id));
+    QTRY_VERIFY_WITH_TIMEOUT(runs >= 3, 2000);
+
+    //The timer stops with its context.
+    delete context;
+    const int stopped = runs;
+    QTRY_VERIFY_WITH_TIMEOUT(!service->isActive(id), 2000);
+    QCOMPARE(runs, stopped);
+    QCOMPARE(service->timerCount(), timers);
+
+    QObject other;
+    const TimerService::TimerId second = service->start(&other, 1000, [] {});
+    service->stop(second);
+    QVERIFY(!service->isActive(second));
+    QVERIFY(!service->isActive(0));
+}
+
+QTEST_MAIN(TimerWheelTests)
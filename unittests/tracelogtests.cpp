@@ -0,0 +1,144 @@
+/*
+    This file is part of the KDE project
+
+    Copyright (C) 2026 The AtCore contributors
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <QLoggingCategory>
+#include <QMutex>
+#include <QMutexLocker>
+
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "tracelogtests.h"
+#include "../src/protocol/tracelog.h"
+#include "../src/tracelogger.h"
+
+using namespace AtCoreProtocol;
+
+Q_LOGGING_CATEGORY(TRACE_TEST, "org.kde.atelier.test.trace")
+
+namespace
+{
+QMutex _messagesMutex;
+QStringList _messages;
+QtMessageHandler _previousHandler = nullptr;
+
+void _collect(QtMsgType type, const QMessageLogContext &context, const QString &message)
+{
+    if (qstrcmp(context.category, "org.kde.atelier.test.trace") == 0) {
+        QMutexLocker lock(&_messagesMutex);
+        _messages.append(message);
+        return;
+    }
+    _previousHandler(type, context, message);
+}
+
+std::vector<std::string> _drain(TraceLog &log)
+{
+    std::vector<std::string> lines;
+    log.drain([&lines](const TraceRecord & record, const char *category, const char *format) {
+        lines.push_back(std::string(category) + ' ' + TraceLog::format(format, record));
+    });
+    return lines;
+}
+}
+
+void TraceLogTests::testFormat()
+{
+    TraceLog log;
+    static TraceSite site;
+    const std::string line("G1 X10.5 Y20 Z0.3 E1.2345 F1800 ; perimeter");
+    log.trace(site, "job", "line %u: %s, progress %f%%, delta %i", 42u, TraceText{line.data(), line.size()}, 12.5f, -3);
+
+    const std::vector<std::string> lines = _drain(log);
+    QCOMPARE(lines.size(), std::size_t(1));
+    QCOMPARE(QString::fromStdString(lines.front()), QStringLiteral("job line 42: G1 X10.5 Y20 Z0.3 E1.2345 F1800 ; perimeter, progress 12.5%, delta -3"));
+    QVERIFY(_drain(log).empty());
+}
+
+void TraceLogTests::testLongText()
+{
+    TraceLog log;
+    static TraceSite site;
+    const std::string line(TraceRecord::MaxText + 10, 'G');
+    log.trace(site, "job", "%s", TraceText{line.data(), line.size()});
+
+    //The text is cut to what a record holds.
+    const std::vector<std::string> lines = _drain(log);
+    QCOMPARE(lines.size(), std::size_t(1));
+    QCOMPARE(lines.front(), "job " + line.substr(0, TraceRecord::MaxText));
+}
+
+void TraceLogTests::testThreadsInOrder()
+{
+    TraceLog log;
+    static TraceSite site;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([&log, t] {
+            for (int i = 0; i < 100; i++) {
+                log.trace(site, "thread", "%i %i", t, i);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    std::vector<std::uint64_t> times;
+    std::size_t count = log.drain([&times](const TraceRecord & record, const char *, const char *) {
+        times.push_back(record.nanos);
+    });
+    QCOMPARE(count, std::size_t(400));
+    QVERIFY(std::is_sorted(times.begin(), times.end()));
+    QCOMPARE(log.dropped(), std::uint64_t(0));
+}
+
+void TraceLogTests::testDropWhenFull()
+{
+    TraceLog log;
+    log.setCapacity(8);
+    static TraceSite site;
+    for (int i = 0; i < 20; i++) {
+        log.trace(site, "full", "%i", i);
+    }
+    const std::vector<std::string> lines = _drain(log);
+    QCOMPARE(lines.size(), std::size_t(8));
+    //The oldest records are kept, the traced thread never waits.
+    QCOMPARE(QString::fromStdString(lines.back()), QStringLiteral("full 7"));
+    QCOMPARE(log.dropped(), std::uint64_t(12));
+
+    log.trace(site, "full", "%i", 20);
+    QCOMPARE(_drain(log).size(), std::size_t(1));
+}
+
+void TraceLogTests::testTraceLogger()
+{
+    _previousHandler = qInstallMessageHandler(_collect);
+    const QByteArray line("G28 X Y\n");
+    ATCORE_TRACE(TRACE_TEST, "Nextline: %u %s", 7u, TraceLogger::text(line));
+    TraceLogger::instance()->flush();
+    QTRY_VERIFY_WITH_TIMEOUT(!_messages.isEmpty(), 2000);
+    qInstallMessageHandler(_previousHandler);
+
+    QMutexLocker lock(&_messagesMutex);
+    QCOMPARE(_messages, QStringList{QStringLiteral("Nextline: 7 G28 X Y")});
+}
+
+QTEST_MAIN(TraceLogTests)